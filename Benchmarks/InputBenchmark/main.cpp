@@ -0,0 +1,135 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/PTN_Engine.h"
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ptne;
+
+//
+// Measures the cost per token of adding tokens to input places, through the different input APIs.
+// The net has 8 input places, each consumed by a transition. Optionally pass the number of tokens per run.
+//
+
+namespace
+{
+
+constexpr size_t numberOfInputPlaces = 8;
+constexpr size_t batchSize = 256;
+
+void createNet(PTN_Engine &ptnEngine, vector<PlaceHandle> &inputPlaces)
+{
+	ptnEngine.createPlace(PlaceProperties{ .name = "Output" });
+	for (size_t i = 0; i < numberOfInputPlaces; ++i)
+	{
+		const string id = to_string(i);
+		inputPlaces.push_back(ptnEngine.createPlace(PlaceProperties{ .name = "Input" + id, .input = true }));
+		ptnEngine.createTransition(TransitionProperties{ .name = "T" + id,
+														 .activationArcs = { ArcProperties{ .placeName = "Input" + id } },
+														 .destinationArcs = { ArcProperties{ .placeName = "Output" } } });
+	}
+}
+
+void run(const string &name, const size_t tokens, const function<void(PTN_Engine &, const vector<PlaceHandle> &)> &feed)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	vector<PlaceHandle> inputPlaces;
+	createNet(ptnEngine, inputPlaces);
+
+	const auto start = chrono::steady_clock::now();
+	feed(ptnEngine, inputPlaces);
+	const auto elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - start);
+
+	size_t fedTokens = 0;
+	for (const auto &place : inputPlaces)
+	{
+		fedTokens += ptnEngine.getNumberOfTokens(place);
+	}
+	if (fedTokens != tokens)
+	{
+		cerr << name << ": expected " << tokens << " tokens, got " << fedTokens << endl;
+		exit(EXIT_FAILURE);
+	}
+	cout << left << setw(40) << name << right << setw(10) << fixed << setprecision(1)
+		 << elapsed.count() / static_cast<double>(tokens) << " ns/token" << endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	const size_t tokens = argc > 1 ? stoul(argv[1]) : 1 << 20;
+
+	run("incrementInputPlace(name)", tokens,
+		[tokens](PTN_Engine &ptnEngine, const vector<PlaceHandle> &)
+		{
+			vector<string> names;
+			for (size_t i = 0; i < numberOfInputPlaces; ++i)
+			{
+				names.push_back("Input" + to_string(i));
+			}
+			for (size_t token = 0; token < tokens; ++token)
+			{
+				ptnEngine.incrementInputPlace(names[token % numberOfInputPlaces]);
+			}
+		});
+
+	run("incrementInputPlace(handle)", tokens,
+		[tokens](PTN_Engine &ptnEngine, const vector<PlaceHandle> &inputPlaces)
+		{
+			for (size_t token = 0; token < tokens; ++token)
+			{
+				ptnEngine.incrementInputPlace(inputPlaces[token % numberOfInputPlaces]);
+			}
+		});
+
+	run("incrementInputPlace(handle, count)", tokens,
+		[tokens](PTN_Engine &ptnEngine, const vector<PlaceHandle> &inputPlaces)
+		{
+			const size_t count = batchSize / numberOfInputPlaces;
+			for (size_t token = 0; token < tokens; token += count)
+			{
+				ptnEngine.incrementInputPlace(inputPlaces[(token / count) % numberOfInputPlaces],
+											  min(count, tokens - token));
+			}
+		});
+
+	run("incrementInputPlace(span of handles)", tokens,
+		[tokens](PTN_Engine &ptnEngine, const vector<PlaceHandle> &inputPlaces)
+		{
+			vector<pair<PlaceHandle, size_t>> increments;
+			for (size_t token = 0; token < tokens; ++token)
+			{
+				increments.emplace_back(inputPlaces[token % numberOfInputPlaces], 1);
+				if (increments.size() == batchSize || token + 1 == tokens)
+				{
+					ptnEngine.incrementInputPlace(increments);
+					increments.clear();
+				}
+			}
+		});
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/JobQueue/JobQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace ptne;
+
+//
+// Measures the throughput and the dispatch latency, from adding a job to the job starting, of the job queue
+// under bursty load: bursts of jobs are added and each burst is waited for before adding the next one, so the
+// queue runs empty between bursts. The persistent worker of JobQueue is compared with a worker thread
+// launched per burst, which exits when the queue runs empty, as JobQueue used to do, and with the bounded
+// lock-free ring of JobQueue, sized to hold a burst. Optionally pass the
+// number of bursts and the number of jobs per burst.
+//
+
+namespace
+{
+
+//!
+//! \brief Job queue launching a new worker thread whenever jobs are added to an empty queue.
+//!
+class SpawningJobQueue
+{
+public:
+	void addJob(const ActionFunction &job)
+	{
+		lock_guard l(m_mutex);
+		m_jobs.push_front(job);
+		if (!m_isRunning)
+		{
+			m_isRunning = true;
+			m_workerThread = jthread(bind_front(&SpawningJobQueue::run, this));
+		}
+	}
+
+private:
+	void run()
+	{
+		unique_lock l(m_mutex);
+		while (!m_jobs.empty())
+		{
+			ActionFunction job = m_jobs.back();
+			m_jobs.pop_back();
+			l.unlock();
+			job();
+			l.lock();
+		}
+		m_isRunning = false;
+	}
+
+	bool m_isRunning = false;
+	deque<ActionFunction> m_jobs;
+	mutex m_mutex;
+	jthread m_workerThread;
+};
+
+template<typename Queue, typename... Arguments>
+void run(const string &name, const size_t bursts, const size_t jobsPerBurst, Arguments... arguments)
+{
+	Queue queue(arguments...);
+	using Clock = chrono::steady_clock;
+	vector<Clock::time_point> added(jobsPerBurst);
+	vector<double> latencies;
+	latencies.reserve(bursts * jobsPerBurst);
+	atomic<size_t> executed = 0;
+
+	const auto start = Clock::now();
+	for (size_t burst = 0; burst < bursts; ++burst)
+	{
+		executed = 0;
+		for (size_t job = 0; job < jobsPerBurst; ++job)
+		{
+			added[job] = Clock::now();
+			queue.addJob(
+			[&, job]
+			{
+				// Jobs run in sequence, so the latencies do not need synchronization.
+				latencies.push_back(chrono::duration<double, micro>(Clock::now() - added[job]).count());
+				++executed;
+				executed.notify_one();
+			});
+		}
+		for (size_t current = executed; current < jobsPerBurst; current = executed)
+		{
+			executed.wait(current);
+		}
+	}
+	const auto elapsed = chrono::duration<double>(Clock::now() - start);
+
+	sort(latencies.begin(), latencies.end());
+	const double p50 = latencies[latencies.size() / 2];
+	const double p99 = latencies[min(latencies.size() - 1, latencies.size() * 99 / 100)];
+	cout << left << setw(30) << name << right << fixed << setprecision(0) << setw(12)
+		 << static_cast<double>(latencies.size()) / elapsed.count() << " jobs/s" << setprecision(1) << setw(10)
+		 << p50 << " us p50" << setw(10) << p99 << " us p99" << endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	const size_t bursts = argc > 1 ? stoul(argv[1]) : 10000;
+	const size_t jobsPerBurst = argc > 2 ? max<size_t>(1, stoul(argv[2])) : 4;
+
+	run<SpawningJobQueue>("Worker thread per burst", bursts, jobsPerBurst);
+	run<JobQueue>("Persistent worker thread", bursts, jobsPerBurst);
+	run<JobQueue>("Bounded ring, blocking", bursts, jobsPerBurst, jobsPerBurst,
+				  PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY::BLOCK);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/ActionsInExecution.h"
+
+namespace ptne
+{
+
+using namespace std;
+
+ActionsInExecution::~ActionsInExecution() = default;
+
+ActionsInExecution::ActionsInExecution(ActionCompletedNotifier wakeUp)
+: m_wakeUp(move(wakeUp))
+{
+}
+
+shared_ptr<const ActionCompletedNotifier>
+ActionsInExecution::createNotifier(const shared_ptr<PlaceActions> &placeActions)
+{
+	// Keeps both alive, as executors may call the notifier after the place and the net are gone.
+	return make_shared<const ActionCompletedNotifier>(
+	[actionsInExecution = shared_from_this(), placeActions] { actionsInExecution->actionCompleted(placeActions); });
+}
+
+vector<const Place *> ActionsInExecution::takeCompletedPlaces()
+{
+	vector<shared_ptr<PlaceActions>> completedPlaces;
+	{
+		lock_guard guard(m_mutex);
+		if (m_completedPlaces.empty())
+		{
+			return {};
+		}
+		swap(completedPlaces, m_completedPlaces);
+	}
+
+	vector<const Place *> places;
+	places.reserve(completedPlaces.size());
+	for (const auto &placeActions : completedPlaces)
+	{
+		// Cleared before the caller reads the counters, so that later completions are queued again.
+		placeActions->completionQueued = false;
+		places.push_back(placeActions->place);
+	}
+	return places;
+}
+
+void ActionsInExecution::clear()
+{
+	lock_guard guard(m_mutex);
+	for (const auto &placeActions : m_completedPlaces)
+	{
+		placeActions->completionQueued = false;
+	}
+	m_completedPlaces.clear();
+}
+
+void ActionsInExecution::actionCompleted(const shared_ptr<PlaceActions> &placeActions)
+{
+	if (!placeActions->completionQueued.exchange(true))
+	{
+		lock_guard guard(m_mutex);
+		m_completedPlaces.push_back(placeActions);
+	}
+	if (m_wakeUp)
+	{
+		m_wakeUp();
+	}
+}
+
+} // namespace ptne
@@ -0,0 +1,117 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "PTN_Engine/IActionsExecutor.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ptne
+{
+
+class Place;
+
+//!
+//! \brief Keeps the counters of the actions in execution of the places of a net, and publishes the completion
+//! of their actions as events for the thread executing the net.
+//!
+//! Executors running an action in another thread call the notifier of its place once it finished. The
+//! place is then queued as completed, once until taken, and the event loop is woken up, so that the
+//! transitions waiting for the actions of that place are re-evaluated in the next cycle instead of being
+//! polled in every cycle.
+//!
+class ActionsInExecution final : public std::enable_shared_from_this<ActionsInExecution>
+{
+public:
+	//!
+	//! \brief Actions in execution of one place.
+	//!
+	struct PlaceActions final
+	{
+		explicit PlaceActions(const Place *place)
+		: place(place)
+		{
+		}
+
+		//! The place, only used to identify it.
+		const Place *const place;
+
+		//! Number of on enter actions in execution.
+		std::atomic<size_t> onEnter = 0;
+
+		//! Number of on exit actions in execution.
+		std::atomic<size_t> onExit = 0;
+
+		//! Set while the place is queued as completed.
+		std::atomic<bool> completionQueued = false;
+	};
+
+	~ActionsInExecution();
+
+	//!
+	//! \brief ActionsInExecution constructor.
+	//! \param wakeUp - wakes up the thread executing the net once an action completed.
+	//!
+	explicit ActionsInExecution(ActionCompletedNotifier wakeUp);
+
+	ActionsInExecution(const ActionsInExecution &) = delete;
+	ActionsInExecution(ActionsInExecution &&) = delete;
+	ActionsInExecution &operator=(const ActionsInExecution &) = delete;
+	ActionsInExecution &operator=(ActionsInExecution &&) = delete;
+
+	//!
+	//! \brief Create the notifier handed over to the executors with the actions of a place.
+	//! \param placeActions - the counters of the place.
+	//! \return Notifier queuing the place as completed and waking up the thread executing the net.
+	//!
+	std::shared_ptr<const ActionCompletedNotifier>
+	createNotifier(const std::shared_ptr<PlaceActions> &placeActions);
+
+	//!
+	//! \brief Take the places whose actions completed since the last call.
+	//! \return The completed places, each once.
+	//!
+	std::vector<const Place *> takeCompletedPlaces();
+
+	//!
+	//! \brief Discard the queued completions, for instance when the places are removed.
+	//!
+	void clear();
+
+private:
+	//!
+	//! \brief Queue a place as completed, unless already queued, and wake up the thread executing the net.
+	//! \param placeActions - the counters of the place.
+	//!
+	void actionCompleted(const std::shared_ptr<PlaceActions> &placeActions);
+
+	//! Wakes up the thread executing the net.
+	const ActionCompletedNotifier m_wakeUp;
+
+	//! Protects m_completedPlaces.
+	std::mutex m_mutex;
+
+	//! Places whose actions completed, not taken yet.
+	std::vector<std::shared_ptr<PlaceActions>> m_completedPlaces;
+};
+
+} // namespace ptne
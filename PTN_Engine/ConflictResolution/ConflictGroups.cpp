@@ -0,0 +1,102 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/ConflictResolution/ConflictGroups.h"
+#include "PTN_Engine/ConflictResolution/IConflictResolver.h"
+#include "PTN_Engine/Transition.h"
+#include "PTN_Engine/Utilities/LockWeakPtr.h"
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+namespace ptne
+{
+
+using namespace std;
+
+void ConflictGroups::build(const vector<shared_ptr<Transition>> &transitions)
+{
+	m_groups.resize(transitions.size());
+	iota(m_groups.begin(), m_groups.end(), 0);
+	m_priorities.clear();
+
+	auto findGroup = [this](size_t transition)
+	{
+		while (m_groups[transition] != transition)
+		{
+			m_groups[transition] = m_groups[m_groups[transition]];
+			transition = m_groups[transition];
+		}
+		return transition;
+	};
+
+	unordered_map<const Place *, size_t> firstConsumers;
+	for (size_t transition = 0; transition < transitions.size(); ++transition)
+	{
+		m_priorities.push_back(transitions[transition]->getPriority());
+		for (const Arc &arc : transitions[transition]->getActivationArcs())
+		{
+			const auto [it, inserted] = firstConsumers.try_emplace(lockWeakPtr(arc.place).get(), transition);
+			if (!inserted)
+			{
+				// The lowest index is always the root, so that it identifies the group.
+				const size_t a = findGroup(it->second);
+				const size_t b = findGroup(transition);
+				m_groups[max(a, b)] = min(a, b);
+			}
+		}
+	}
+
+	m_groupSizes.assign(m_groups.size(), 0);
+	for (size_t transition = 0; transition < m_groups.size(); ++transition)
+	{
+		m_groups[transition] = findGroup(transition);
+		++m_groupSizes[m_groups[transition]];
+	}
+}
+
+bool ConflictGroups::hasConflicts(const size_t transition) const
+{
+	return m_groupSizes[m_groups[transition]] > 1;
+}
+
+size_t ConflictGroups::getGroup(const size_t transition) const
+{
+	return m_groups[transition];
+}
+
+void ConflictGroups::resolve(vector<size_t> &enabledTransitions, IConflictResolver &conflictResolver) const
+{
+	ranges::sort(enabledTransitions,
+				 [this](const size_t a, const size_t b)
+				 { return m_groups[a] != m_groups[b] ? m_groups[a] < m_groups[b] : a < b; });
+
+	for (auto first = enabledTransitions.begin(); first != enabledTransitions.end();)
+	{
+		const size_t group = m_groups[*first];
+		const auto last = find_if(first, enabledTransitions.end(),
+								  [this, group](const size_t transition) { return m_groups[transition] != group; });
+		if (last - first > 1)
+		{
+			conflictResolver.order(group, span<size_t>(first, last), m_priorities);
+		}
+		first = last;
+	}
+}
+
+} // namespace ptne
@@ -0,0 +1,78 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace ptne
+{
+
+class IConflictResolver;
+class Transition;
+
+//!
+//! \brief Groups transitions that can compete for the same tokens.
+//!
+//! Two transitions are in conflict if they have an activation arc from the same place. Groups are the connected
+//! components of that relation, identified by the lowest index of their transitions.
+//!
+class ConflictGroups final
+{
+public:
+	//!
+	//! \brief Compute the groups of a net.
+	//! \param transitions - all transitions of the net, in the order they were created.
+	//!
+	void build(const std::vector<std::shared_ptr<Transition>> &transitions);
+
+	//!
+	//! \brief Order enabled transitions so that transitions of the same group are consecutive, and let the
+	//! conflict resolver order the groups with more than one enabled transition.
+	//! \param enabledTransitions - indexes of the enabled transitions, ordered in place.
+	//! \param conflictResolver - decides the order inside each group.
+	//!
+	void resolve(std::vector<size_t> &enabledTransitions, IConflictResolver &conflictResolver) const;
+
+	//!
+	//! \brief Whether a transition shares its group with other transitions.
+	//! \param transition - index of the transition.
+	//! \return False if no other transition can consume tokens from its activation places.
+	//!
+	bool hasConflicts(const size_t transition) const;
+
+	//!
+	//! \brief Get the group of a transition.
+	//! \param transition - index of the transition.
+	//! \return The lowest index of the transitions in the group.
+	//!
+	size_t getGroup(const size_t transition) const;
+
+private:
+	//! Group of each transition.
+	std::vector<size_t> m_groups;
+
+	//! Number of transitions in each group, indexed by group.
+	std::vector<size_t> m_groupSizes;
+
+	//! Priority of each transition.
+	std::vector<size_t> m_priorities;
+};
+
+} // namespace ptne
@@ -0,0 +1,61 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/ConflictResolution/ConflictResolverFactory.h"
+#include "PTN_Engine/ConflictResolution/PriorityConflictResolver.h"
+#include "PTN_Engine/ConflictResolution/RandomConflictResolver.h"
+#include "PTN_Engine/ConflictResolution/RoundRobinConflictResolver.h"
+#include "PTN_Engine/ConflictResolution/WeightedRandomConflictResolver.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <random>
+
+namespace ptne
+{
+
+using namespace std;
+
+unique_ptr<IConflictResolver>
+ConflictResolverFactory::createConflictResolver(PTN_Engine::CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy,
+												optional<uint64_t> seed)
+{
+	switch (conflictResolutionPolicy)
+	{
+	default:
+	{
+		throw PTN_Exception("Invalid configuration");
+	}
+	case PTN_Engine::CONFLICT_RESOLUTION_POLICY::RANDOM:
+	{
+		return make_unique<RandomConflictResolver>(seed.value_or(random_device{}()));
+	}
+	case PTN_Engine::CONFLICT_RESOLUTION_POLICY::ROUND_ROBIN:
+	{
+		return make_unique<RoundRobinConflictResolver>();
+	}
+	case PTN_Engine::CONFLICT_RESOLUTION_POLICY::PRIORITY:
+	{
+		return make_unique<PriorityConflictResolver>();
+	}
+	case PTN_Engine::CONFLICT_RESOLUTION_POLICY::WEIGHTED_RANDOM:
+	{
+		return make_unique<WeightedRandomConflictResolver>(seed.value_or(random_device{}()));
+	}
+	}
+}
+
+} // namespace ptne
@@ -18,15 +18,19 @@
 
 #pragma once
 
+#include "PTN_Engine/ConflictResolution/IConflictResolver.h"
 #include "PTN_Engine/PTN_Engine.h"
+#include <memory>
 
 namespace ptne
 {
-class IActionsExecutor
+
+class ConflictResolverFactory
 {
 public:
-	virtual ~IActionsExecutor() = default;
-	virtual void executeAction(const ActionFunction &action, std::atomic<size_t> &counter) = 0;
+	static std::unique_ptr<IConflictResolver> createConflictResolver(
+	PTN_Engine::CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy = PTN_Engine::CONFLICT_RESOLUTION_POLICY::RANDOM,
+	std::optional<uint64_t> seed = std::nullopt);
 };
 
 } // namespace ptne
@@ -0,0 +1,45 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Decides the firing order of enabled transitions that compete for the same tokens.
+//!
+class IConflictResolver
+{
+public:
+	virtual ~IConflictResolver() = default;
+
+	//!
+	//! \brief Order the enabled transitions of a conflict group. The first ones are fired first.
+	//! Only called for groups with more than one enabled transition.
+	//! \param group - identifier of the conflict group, stable while the structure of the net does not change.
+	//! \param transitions - indexes of the enabled transitions of the group, in ascending order.
+	//! \param priorities - priority of every transition, by index.
+	//!
+	virtual void order(const size_t group, std::span<size_t> transitions, const std::vector<size_t> &priorities) = 0;
+};
+
+} // namespace ptne
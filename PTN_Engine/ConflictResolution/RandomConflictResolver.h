@@ -0,0 +1,47 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/ConflictResolution/IConflictResolver.h"
+#include <cstdint>
+#include <random>
+
+namespace ptne
+{
+
+//!
+//! \brief Fires conflicting transitions in a uniformly random order.
+//!
+class RandomConflictResolver : public IConflictResolver
+{
+public:
+	//!
+	//! \brief RandomConflictResolver constructor.
+	//! \param seed - seed of the random generator.
+	//!
+	explicit RandomConflictResolver(const uint64_t seed);
+
+	void order(const size_t group, std::span<size_t> transitions, const std::vector<size_t> &priorities) override;
+
+private:
+	//! Random generator, kept between cycles.
+	std::mt19937_64 m_randomGenerator;
+};
+
+} // namespace ptne
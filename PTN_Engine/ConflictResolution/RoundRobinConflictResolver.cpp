@@ -0,0 +1,37 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/ConflictResolution/RoundRobinConflictResolver.h"
+#include <algorithm>
+
+namespace ptne
+{
+
+using namespace std;
+
+void RoundRobinConflictResolver::order(const size_t group, span<size_t> transitions, const vector<size_t> &)
+{
+	if (group >= m_turns.size())
+	{
+		m_turns.resize(group + 1, 0);
+	}
+	ranges::rotate(transitions, transitions.begin() + static_cast<ptrdiff_t>(m_turns[group] % transitions.size()));
+	++m_turns[group];
+}
+
+} // namespace ptne
@@ -0,0 +1,50 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/ConflictResolution/WeightedRandomConflictResolver.h"
+#include <algorithm>
+#include <limits>
+
+namespace ptne
+{
+
+using namespace std;
+
+WeightedRandomConflictResolver::WeightedRandomConflictResolver(const uint64_t seed)
+: m_randomGenerator(seed)
+{
+}
+
+void WeightedRandomConflictResolver::order(const size_t, span<size_t> transitions, const vector<size_t> &priorities)
+{
+	// Sorting by exponentially distributed keys with rate equal to the priority gives each transition
+	// a chance of coming first proportional to its priority.
+	exponential_distribution<double> exponential;
+	m_keys.clear();
+	for (const size_t transition : transitions)
+	{
+		const size_t priority = priorities[transition];
+		const double key = priority == 0 ? numeric_limits<double>::infinity() :
+										   exponential(m_randomGenerator) / static_cast<double>(priority);
+		m_keys.emplace_back(key, transition);
+	}
+	ranges::sort(m_keys);
+	ranges::transform(m_keys, transitions.begin(), [](const auto &key) { return key.second; });
+}
+
+} // namespace ptne
@@ -0,0 +1,196 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/EnablingKernel.h"
+#include "PTN_Engine/FrozenNet.h"
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define PTN_ENGINE_AVX2_KERNEL
+#include <immintrin.h>
+#endif
+
+namespace ptne
+{
+using namespace std;
+
+EnablingKernel::EnablingKernel(const IncidenceMatrix &activationArcs,
+							   const IncidenceMatrix &inhibitorArcs,
+							   const size_t sentinelPlace,
+							   const bool allowSimd)
+: m_numberOfTransitions(activationArcs.offsets.empty() ? 0 : activationArcs.offsets.size() - 1)
+, m_sentinelPlace(sentinelPlace)
+, m_useSimd(allowSimd && isSimdSupported())
+{
+	pack(activationArcs, m_activationBlockOffsets, m_activationPlaces, m_activationWeights);
+	vector<size_t> inhibitorWeights;
+	pack(inhibitorArcs, m_inhibitorBlockOffsets, m_inhibitorPlaces, inhibitorWeights);
+}
+
+void EnablingKernel::computeEnabled(const vector<size_t> &tokens, vector<uint64_t> &enabledMask) const
+{
+	enabledMask.assign((m_numberOfTransitions + 63) / 64, 0);
+	if (m_useSimd)
+	{
+		computeEnabledAvx2(tokens.data(), enabledMask.data());
+	}
+	else
+	{
+		computeEnabledScalar(tokens.data(), enabledMask.data());
+	}
+}
+
+bool EnablingKernel::isSimd() const
+{
+	return m_useSimd;
+}
+
+bool EnablingKernel::isSimdSupported()
+{
+#ifdef PTN_ENGINE_AVX2_KERNEL
+	static const bool isAvx2Supported = __builtin_cpu_supports("avx2");
+	return isAvx2Supported;
+#else
+	return false;
+#endif
+}
+
+// Private
+
+void EnablingKernel::pack(const IncidenceMatrix &arcs,
+						  vector<size_t> &blockOffsets,
+						  vector<size_t> &places,
+						  vector<size_t> &weights) const
+{
+	for (size_t firstTransition = 0; firstTransition < m_numberOfTransitions; firstTransition += s_blockSize)
+	{
+		blockOffsets.push_back(places.size());
+
+		size_t maxNumberOfArcs = 0;
+		for (size_t lane = 0; lane < s_blockSize && firstTransition + lane < m_numberOfTransitions; ++lane)
+		{
+			const size_t transition = firstTransition + lane;
+			maxNumberOfArcs = max(maxNumberOfArcs, arcs.offsets[transition + 1] - arcs.offsets[transition]);
+		}
+
+		for (size_t k = 0; k < maxNumberOfArcs; ++k)
+		{
+			for (size_t lane = 0; lane < s_blockSize; ++lane)
+			{
+				const size_t transition = firstTransition + lane;
+				if (transition < m_numberOfTransitions &&
+					arcs.offsets[transition] + k < arcs.offsets[transition + 1])
+				{
+					places.push_back(arcs.places[arcs.offsets[transition] + k]);
+					weights.push_back(arcs.weights[arcs.offsets[transition] + k]);
+				}
+				else
+				{
+					places.push_back(m_sentinelPlace);
+					weights.push_back(0);
+				}
+			}
+		}
+	}
+	blockOffsets.push_back(places.size());
+}
+
+void EnablingKernel::computeEnabledScalar(const size_t *tokens, uint64_t *enabledMask) const
+{
+	const size_t numberOfBlocks = m_activationBlockOffsets.size() - 1;
+	for (size_t block = 0; block < numberOfBlocks; ++block)
+	{
+		uint64_t blockMask = (uint64_t(1) << s_blockSize) - 1;
+		for (size_t arc = m_inhibitorBlockOffsets[block]; arc < m_inhibitorBlockOffsets[block + 1]; ++arc)
+		{
+			if (tokens[m_inhibitorPlaces[arc]] > 0)
+			{
+				blockMask &= ~(uint64_t(1) << (arc % s_blockSize));
+			}
+		}
+		for (size_t arc = m_activationBlockOffsets[block]; arc < m_activationBlockOffsets[block + 1]; ++arc)
+		{
+			if (tokens[m_activationPlaces[arc]] < m_activationWeights[arc])
+			{
+				blockMask &= ~(uint64_t(1) << (arc % s_blockSize));
+			}
+		}
+
+		const size_t firstTransition = block * s_blockSize;
+		enabledMask[firstTransition / 64] |= blockMask << (firstTransition % 64);
+	}
+
+	// Clear the lanes of the last block that do not correspond to a transition.
+	if (m_numberOfTransitions % 64 != 0)
+	{
+		enabledMask[m_numberOfTransitions / 64] &= (uint64_t(1) << (m_numberOfTransitions % 64)) - 1;
+	}
+}
+
+#ifdef PTN_ENGINE_AVX2_KERNEL
+__attribute__((target("avx2"))) void EnablingKernel::computeEnabledAvx2(const size_t *tokens,
+																	   uint64_t *enabledMask) const
+{
+	const auto *tokensBase = reinterpret_cast<const long long *>(tokens);
+	// AVX2 only compares signed integers, flipping the sign bit turns it into an unsigned comparison.
+	const __m256i signBit = _mm256_set1_epi64x(static_cast<long long>(uint64_t(1) << 63));
+	const __m256i zero = _mm256_setzero_si256();
+
+	const size_t numberOfBlocks = m_activationBlockOffsets.size() - 1;
+	for (size_t block = 0; block < numberOfBlocks; ++block)
+	{
+		__m256i disabled = zero;
+		for (size_t arc = m_inhibitorBlockOffsets[block]; arc < m_inhibitorBlockOffsets[block + 1];
+			 arc += s_blockSize)
+		{
+			const __m256i places = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&m_inhibitorPlaces[arc]));
+			const __m256i placeTokens = _mm256_i64gather_epi64(tokensBase, places, 8);
+			disabled = _mm256_or_si256(disabled, _mm256_xor_si256(_mm256_cmpeq_epi64(placeTokens, zero),
+																  _mm256_cmpeq_epi64(zero, zero)));
+		}
+		for (size_t arc = m_activationBlockOffsets[block]; arc < m_activationBlockOffsets[block + 1];
+			 arc += s_blockSize)
+		{
+			const __m256i places = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&m_activationPlaces[arc]));
+			const __m256i weights =
+			_mm256_loadu_si256(reinterpret_cast<const __m256i *>(&m_activationWeights[arc]));
+			const __m256i placeTokens = _mm256_i64gather_epi64(tokensBase, places, 8);
+			// weight > tokens
+			disabled = _mm256_or_si256(disabled, _mm256_cmpgt_epi64(_mm256_xor_si256(weights, signBit),
+																	_mm256_xor_si256(placeTokens, signBit)));
+		}
+
+		const auto disabledLanes = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(disabled)));
+		const uint64_t blockMask = ~disabledLanes & ((uint64_t(1) << s_blockSize) - 1);
+		const size_t firstTransition = block * s_blockSize;
+		enabledMask[firstTransition / 64] |= blockMask << (firstTransition % 64);
+	}
+
+	if (m_numberOfTransitions % 64 != 0)
+	{
+		enabledMask[m_numberOfTransitions / 64] &= (uint64_t(1) << (m_numberOfTransitions % 64)) - 1;
+	}
+}
+#else
+void EnablingKernel::computeEnabledAvx2(const size_t *tokens, uint64_t *enabledMask) const
+{
+	computeEnabledScalar(tokens, enabledMask);
+}
+#endif
+
+} // namespace ptne
@@ -0,0 +1,126 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ptne
+{
+
+struct IncidenceMatrix;
+
+//!
+//! \brief Computes which transitions have enough tokens to fire, for all transitions of a frozen net at once.
+//!
+//! The activation and inhibitor arcs are packed in blocks of 4 transitions. Inside a block the arcs of the
+//! 4 transitions are interleaved, so that the k-th arc of each transition is in consecutive positions, and
+//! blocks are padded to the transition with most arcs. Padding arcs point to a sentinel place, whose number of
+//! tokens must always be 0, and have weight 0, so they never disable a transition.
+//!
+//! The AVX2 implementation is used when the processor supports it, otherwise a scalar implementation over the
+//! same layout is used. Additional conditions are not evaluated here.
+//!
+class EnablingKernel final
+{
+public:
+	//! Number of transitions evaluated together.
+	static constexpr size_t s_blockSize = 4;
+
+	//!
+	//! \brief Pack the arcs of a net.
+	//! \param activationArcs - activation arcs of all transitions.
+	//! \param inhibitorArcs - inhibitor arcs of all transitions.
+	//! \param sentinelPlace - index of a place that never has tokens, used for padding.
+	//! \param allowSimd - use the AVX2 implementation if the processor supports it.
+	//!
+	EnablingKernel(const IncidenceMatrix &activationArcs,
+				   const IncidenceMatrix &inhibitorArcs,
+				   const size_t sentinelPlace,
+				   const bool allowSimd = true);
+
+	//!
+	//! \brief Compute the enabled transitions for a marking.
+	//! \param tokens - number of tokens in each place, including the sentinel place.
+	//! \param enabledMask - output, one bit per transition, set if the transition is enabled.
+	//!
+	void computeEnabled(const std::vector<size_t> &tokens, std::vector<uint64_t> &enabledMask) const;
+
+	//!
+	//! \brief Whether computeEnabled uses the AVX2 implementation.
+	//! \return True if the AVX2 implementation is used.
+	//!
+	bool isSimd() const;
+
+	//!
+	//! \brief Whether the processor and the build support the AVX2 implementation.
+	//! \return True if the AVX2 implementation is available.
+	//!
+	static bool isSimdSupported();
+
+private:
+	//!
+	//! \brief Interleave the arcs of each block of transitions.
+	//! \param arcs - arcs of all transitions.
+	//! \param blockOffsets - output, position of the first arc of each block, followed by the total.
+	//! \param places - output, interleaved place indices.
+	//! \param weights - output, interleaved weights.
+	//!
+	void pack(const IncidenceMatrix &arcs,
+			  std::vector<size_t> &blockOffsets,
+			  std::vector<size_t> &places,
+			  std::vector<size_t> &weights) const;
+
+	//!
+	//! \brief Scalar implementation of computeEnabled.
+	//!
+	void computeEnabledScalar(const size_t *tokens, uint64_t *enabledMask) const;
+
+	//!
+	//! \brief AVX2 implementation of computeEnabled.
+	//!
+	void computeEnabledAvx2(const size_t *tokens, uint64_t *enabledMask) const;
+
+	//! Number of transitions.
+	size_t m_numberOfTransitions;
+
+	//! Index of the place used for padding.
+	size_t m_sentinelPlace;
+
+	//! Whether the AVX2 implementation is used.
+	bool m_useSimd;
+
+	//! Position of the first activation arc of each block, followed by the total.
+	std::vector<size_t> m_activationBlockOffsets;
+
+	//! Interleaved activation places.
+	std::vector<size_t> m_activationPlaces;
+
+	//! Interleaved activation weights.
+	std::vector<size_t> m_activationWeights;
+
+	//! Position of the first inhibitor arc of each block, followed by the total.
+	std::vector<size_t> m_inhibitorBlockOffsets;
+
+	//! Interleaved inhibitor places.
+	std::vector<size_t> m_inhibitorPlaces;
+};
+
+} // namespace ptne
@@ -0,0 +1,48 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/EngineScheduler.h"
+#include "PTN_Engine/EngineSchedulerImp.h"
+
+namespace ptne
+{
+using namespace std;
+
+EngineScheduler::EngineScheduler(const size_t numberOfThreads, const size_t cycleBudget)
+: m_engineSchedulerImp(make_shared<EngineSchedulerImp>(numberOfThreads, cycleBudget))
+{
+}
+
+EngineScheduler::~EngineScheduler() = default;
+
+size_t EngineScheduler::getNumberOfThreads() const
+{
+	return m_engineSchedulerImp->getNumberOfThreads();
+}
+
+size_t EngineScheduler::getCycleBudget() const
+{
+	return m_engineSchedulerImp->getCycleBudget();
+}
+
+size_t EngineScheduler::getNumberOfEngines() const
+{
+	return m_engineSchedulerImp->getNumberOfEngines();
+}
+
+} // namespace ptne
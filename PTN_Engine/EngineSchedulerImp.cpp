@@ -0,0 +1,234 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/EngineSchedulerImp.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <algorithm>
+
+namespace ptne
+{
+using namespace std;
+using enum ScheduledEngine::STATE;
+
+namespace
+{
+//! Watchdog deadlines closer than this are handled together, bounding how often the engines are scanned.
+constexpr auto watchdogResolution = chrono::milliseconds(10);
+} // namespace
+
+EngineSchedulerImp::EngineSchedulerImp(const size_t numberOfThreads, const size_t cycleBudget)
+: m_cycleBudget(cycleBudget)
+{
+	if (numberOfThreads == 0)
+	{
+		throw PTN_Exception("The number of scheduler threads must be at least 1.");
+	}
+	if (cycleBudget == 0)
+	{
+		throw PTN_Exception("The cycle budget must be at least 1.");
+	}
+	m_threads.reserve(numberOfThreads);
+	for (size_t i = 0; i < numberOfThreads; ++i)
+	{
+		m_threads.emplace_back([this] { run(); });
+	}
+}
+
+EngineSchedulerImp::~EngineSchedulerImp()
+{
+	{
+		lock_guard guard(m_mutex);
+		m_stopping = true;
+	}
+	m_engineQueued.notify_all();
+	m_threads.clear();
+}
+
+size_t EngineSchedulerImp::getNumberOfThreads() const
+{
+	return m_threads.size();
+}
+
+size_t EngineSchedulerImp::getCycleBudget() const
+{
+	return m_cycleBudget;
+}
+
+size_t EngineSchedulerImp::getNumberOfEngines() const
+{
+	lock_guard guard(m_mutex);
+	return m_engines.size();
+}
+
+void EngineSchedulerImp::registerEngine(const shared_ptr<ScheduledEngine> &engine)
+{
+	{
+		lock_guard guard(m_mutex);
+		m_engines.insert(engine);
+	}
+	notify(engine);
+}
+
+void EngineSchedulerImp::unregisterEngine(const shared_ptr<ScheduledEngine> &engine)
+{
+	{
+		// Waits for the cycles being executed.
+		lock_guard engineGuard(engine->mutex);
+		engine->unregistered = true;
+	}
+	lock_guard guard(m_mutex);
+	m_engines.erase(engine);
+}
+
+void EngineSchedulerImp::notify(const shared_ptr<ScheduledEngine> &engine)
+{
+	auto state = engine->state.load();
+	while (true)
+	{
+		if (state == IDLE)
+		{
+			if (engine->state.compare_exchange_weak(state, QUEUED))
+			{
+				enqueue(engine);
+				return;
+			}
+		}
+		else if (state == RUNNING)
+		{
+			if (engine->state.compare_exchange_weak(state, RUNNING_NOTIFIED))
+			{
+				return;
+			}
+		}
+		else
+		{
+			return;
+		}
+	}
+}
+
+void EngineSchedulerImp::run()
+{
+	while (true)
+	{
+		shared_ptr<ScheduledEngine> engine;
+		{
+			unique_lock guard(m_mutex);
+			while (true)
+			{
+				queueWatchdogEngines(ScheduledEngine::Clock::now());
+				if (!m_queue.empty())
+				{
+					engine = move(m_queue.front());
+					m_queue.pop_front();
+					break;
+				}
+				if (m_stopping)
+				{
+					return;
+				}
+				if (m_nextWatchdogDeadline == ScheduledEngine::Clock::time_point::max())
+				{
+					m_engineQueued.wait(guard);
+				}
+				else
+				{
+					m_engineQueued.wait_until(guard, m_nextWatchdogDeadline);
+				}
+			}
+		}
+		execute(engine);
+	}
+}
+
+void EngineSchedulerImp::execute(const shared_ptr<ScheduledEngine> &engine)
+{
+	unique_lock engineGuard(engine->mutex);
+	if (engine->unregistered)
+	{
+		return;
+	}
+	engine->state = RUNNING;
+	bool idle = false;
+	for (size_t i = 0; i < m_cycleBudget && !idle; ++i)
+	{
+		idle = !engine->executeCycle();
+	}
+	const auto watchdogPeriod = idle ? engine->getWatchdogPeriod() : ScheduledEngine::Clock::duration::zero();
+	engineGuard.unlock();
+
+	if (idle)
+	{
+		{
+			lock_guard guard(m_mutex);
+			engine->watchdogDeadline = watchdogPeriod > ScheduledEngine::Clock::duration::zero() ?
+									   ScheduledEngine::Clock::now() + watchdogPeriod :
+									   ScheduledEngine::Clock::time_point::max();
+			m_nextWatchdogDeadline = min(m_nextWatchdogDeadline, engine->watchdogDeadline);
+		}
+		// Notified while executed, the new event may not have been seen by the last cycle.
+		auto running = RUNNING;
+		if (engine->state.compare_exchange_strong(running, IDLE))
+		{
+			return;
+		}
+	}
+	// Busy or notified: back to the end of the queue, letting the other engines have their turn.
+	engine->state = QUEUED;
+	enqueue(engine);
+}
+
+void EngineSchedulerImp::enqueue(shared_ptr<ScheduledEngine> engine)
+{
+	{
+		lock_guard guard(m_mutex);
+		m_queue.push_back(move(engine));
+	}
+	m_engineQueued.notify_one();
+}
+
+void EngineSchedulerImp::queueWatchdogEngines(const ScheduledEngine::Clock::time_point now)
+{
+	if (now < m_nextWatchdogDeadline)
+	{
+		return;
+	}
+	m_nextWatchdogDeadline = ScheduledEngine::Clock::time_point::max();
+	for (const auto &engine : m_engines)
+	{
+		if (engine->watchdogDeadline > now)
+		{
+			m_nextWatchdogDeadline = min(m_nextWatchdogDeadline, engine->watchdogDeadline);
+			continue;
+		}
+		// Engines not idle get a new deadline once they are.
+		engine->watchdogDeadline = ScheduledEngine::Clock::time_point::max();
+		auto idle = IDLE;
+		if (engine->state.compare_exchange_strong(idle, QUEUED))
+		{
+			m_queue.push_back(shared_ptr(engine));
+			m_engineQueued.notify_one();
+		}
+	}
+	if (m_nextWatchdogDeadline != ScheduledEngine::Clock::time_point::max())
+	{
+		m_nextWatchdogDeadline = max(m_nextWatchdogDeadline, now + watchdogResolution);
+	}
+}
+
+} // namespace ptne
@@ -0,0 +1,175 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/Utilities/RingDeque.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Engine registered in an EngineSchedulerImp.
+//!
+struct ScheduledEngine final
+{
+	using Clock = std::chrono::steady_clock;
+
+	//!
+	//! \brief Scheduling state of the engine.
+	//!
+	enum class STATE
+	{
+		//! Waiting for a notification.
+		IDLE,
+		//! In the queue of engines to execute.
+		QUEUED,
+		//! Being executed by a thread.
+		RUNNING,
+		//! Being executed by a thread and notified since, so it must be executed again.
+		RUNNING_NOTIFIED
+	};
+
+	//! Executes one cycle of the net, returning true if a transition fired.
+	std::function<bool()> executeCycle;
+
+	//! Watchdog timer period of the engine, zero if disabled.
+	std::function<Clock::duration()> getWatchdogPeriod;
+
+	//! Scheduling state.
+	std::atomic<STATE> state = STATE::IDLE;
+
+	//! Held while executing cycles, so that the engine is not executed once unregistered.
+	std::mutex mutex;
+
+	//! Set once the engine is unregistered. Protected by mutex.
+	bool unregistered = false;
+
+	//! Time after which the idle engine is executed even if not notified. Protected by the mutex of the
+	//! scheduler.
+	Clock::time_point watchdogDeadline = Clock::time_point::max();
+};
+
+//!
+//! \brief Implements the EngineScheduler: threads executing the engines in a queue, in turn.
+//!
+class EngineSchedulerImp final
+{
+public:
+	~EngineSchedulerImp();
+
+	//!
+	//! \brief EngineSchedulerImp constructor, launching the threads.
+	//! \param numberOfThreads - number of threads executing the nets. At least 1.
+	//! \param cycleBudget - number of cycles executed for an engine before the next engine gets its turn.
+	//! At least 1.
+	//!
+	EngineSchedulerImp(const size_t numberOfThreads, const size_t cycleBudget);
+
+	EngineSchedulerImp(const EngineSchedulerImp &) = delete;
+	EngineSchedulerImp(EngineSchedulerImp &&) = delete;
+	EngineSchedulerImp &operator=(const EngineSchedulerImp &) = delete;
+	EngineSchedulerImp &operator=(EngineSchedulerImp &&) = delete;
+
+	size_t getNumberOfThreads() const;
+
+	size_t getCycleBudget() const;
+
+	size_t getNumberOfEngines() const;
+
+	//!
+	//! \brief Register an engine and execute it.
+	//! \param engine - the engine to register.
+	//!
+	void registerEngine(const std::shared_ptr<ScheduledEngine> &engine);
+
+	//!
+	//! \brief Unregister an engine, waiting for the cycles being executed. Its functions are not called after.
+	//! Must not be called by the engine's own cycles.
+	//! \param engine - the engine to unregister.
+	//!
+	void unregisterEngine(const std::shared_ptr<ScheduledEngine> &engine);
+
+	//!
+	//! \brief Queue an engine to be executed, unless it is already queued. An engine being executed is
+	//! executed again. Can be called from any thread.
+	//! \param engine - the engine to notify.
+	//!
+	void notify(const std::shared_ptr<ScheduledEngine> &engine);
+
+private:
+	//!
+	//! \brief Take engines from the queue and execute them, until the scheduler is destroyed.
+	//!
+	void run();
+
+	//!
+	//! \brief Execute cycles of an engine, up to the cycle budget, and queue it again if it is not idle.
+	//! \param engine - the engine to execute.
+	//!
+	void execute(const std::shared_ptr<ScheduledEngine> &engine);
+
+	//!
+	//! \brief Add an engine to the end of the queue and wake up a thread. Must not be called with m_mutex
+	//! locked.
+	//! \param engine - the engine to add.
+	//!
+	void enqueue(std::shared_ptr<ScheduledEngine> engine);
+
+	//!
+	//! \brief Queue the idle engines whose watchdog timer period elapsed. Must be called with m_mutex locked.
+	//! \param now - the current time.
+	//!
+	void queueWatchdogEngines(const ScheduledEngine::Clock::time_point now);
+
+	//! Number of cycles executed for an engine before the next engine gets its turn.
+	const size_t m_cycleBudget;
+
+	//! Protects the queue, the registered engines and the watchdog deadlines.
+	mutable std::mutex m_mutex;
+
+	//! Wakes up parked threads when engines are queued or the scheduler is destroyed.
+	std::condition_variable m_engineQueued;
+
+	//! Engines waiting to be executed, in turn.
+	utility::RingDeque<std::shared_ptr<ScheduledEngine>> m_queue;
+
+	//! Registered engines.
+	std::unordered_set<std::shared_ptr<ScheduledEngine>> m_engines;
+
+	//! Earliest time a watchdog deadline of an idle engine may have elapsed.
+	ScheduledEngine::Clock::time_point m_nextWatchdogDeadline = ScheduledEngine::Clock::time_point::max();
+
+	//! Flag set when the scheduler is destroyed.
+	bool m_stopping = false;
+
+	//! Threads executing the engines.
+	std::vector<std::jthread> m_threads;
+};
+
+} // namespace ptne
@@ -17,8 +17,12 @@
  */
 
 #include "PTN_Engine/EventLoop.h"
+#include "PTN_Engine/EngineScheduler.h"
+#include "PTN_Engine/EngineSchedulerImp.h"
 #include "PTN_Engine/IPTN_EngineEL.h"
 #include "PTN_Engine/PTN_Exception.h"
+#include "PTN_Engine/Utilities/ThreadScheduling.h"
+#include <algorithm>
 #include <thread>
 
 namespace ptne
@@ -44,9 +48,26 @@ void EventLoop::stop() noexcept
 		return;
 	}
 
+	if (m_scheduledEngine)
+	{
+		shared_ptr<EngineSchedulerImp> engineScheduler;
+		{
+			lock_guard guard(m_eventNotifier->mutex);
+			m_eventNotifier->scheduled = false;
+			m_eventNotifier->scheduledEngine.reset();
+			engineScheduler = move(m_eventNotifier->engineScheduler);
+		}
+		engineScheduler->unregisterEngine(m_scheduledEngine);
+		m_scheduledEngine.reset();
+		m_eventLoopThreadRunning = false;
+		return;
+	}
+
 	if (m_eventLoopThread.get_stop_token().stop_possible())
 	{
 		m_eventLoopThread.request_stop();
+		// Wake up the thread if it is parked without watchdog.
+		notifyNewEvent();
 		m_barrier->arrive_and_wait();
 	}
 }
@@ -62,18 +83,80 @@ void EventLoop::start(const bool log, ostream &o)
 		while (m_ptnEngine.executeInt(log, o))
 			;
 	}
+	else if (getEngineScheduler())
+	{
+		startScheduled(log, o);
+	}
 	else
 	{
 		m_barrier = make_unique<barrier<>>(2);
 		m_eventLoopThreadRunning = true;
 		m_eventLoopThread = jthread(bind_front(&EventLoop::run, this), log, ref(o));
+		try
+		{
+			utility::applyThreadScheduling(m_eventLoopThread.native_handle(), getThreadScheduling());
+		}
+		catch (...)
+		{
+			stop();
+			throw;
+		}
 	}
 }
 
+void EventLoop::startScheduled(const bool log, ostream &o)
+{
+	m_scheduledEngine = make_shared<ScheduledEngine>();
+	m_scheduledEngine->executeCycle = [this, log, &o] { return m_ptnEngine.executeInt(log, o); };
+	m_scheduledEngine->getWatchdogPeriod = [this]() -> ScheduledEngine::Clock::duration
+	{
+		shared_lock lock(m_sleepDurationMutex);
+		return m_watchdogEnabled ? m_sleepDuration : ScheduledEngine::Clock::duration::zero();
+	};
+	const shared_ptr<EngineSchedulerImp> engineScheduler = getEngineScheduler()->m_engineSchedulerImp;
+	{
+		lock_guard guard(m_eventNotifier->mutex);
+		m_eventNotifier->engineScheduler = engineScheduler;
+		m_eventNotifier->scheduledEngine = m_scheduledEngine;
+		m_eventNotifier->scheduled = true;
+	}
+	m_eventLoopThreadRunning = true;
+	engineScheduler->registerEngine(m_scheduledEngine);
+}
+
 void EventLoop::notifyNewEvent()
 {
-	unique_lock eventNotifierGuard(m_eventNotifierMutex);
-	m_eventNotifier.notify_all();
+	m_eventNotifier->notify();
+}
+
+function<void()> EventLoop::getEventNotifier() const
+{
+	return [weakEventNotifier = weak_ptr(m_eventNotifier)]
+	{
+		if (const auto eventNotifier = weakEventNotifier.lock())
+		{
+			eventNotifier->notify();
+		}
+	};
+}
+
+void EventLoop::EventNotifier::notify()
+{
+	// Both sequentially consistent: either the parking thread sees the new event, or this sees it parked.
+	events.fetch_add(1);
+	if (parked.load())
+	{
+		lock_guard guard(mutex);
+		condition.notify_all();
+	}
+	if (scheduled.load())
+	{
+		lock_guard guard(mutex);
+		if (scheduledEngine)
+		{
+			engineScheduler->notify(scheduledEngine);
+		}
+	}
 }
 
 void EventLoop::setSleepDuration(const SleepDuration sleepDuration)
@@ -89,19 +172,163 @@ EventLoop::SleepDuration EventLoop::getSleepDuration() const
 	return m_sleepDuration;
 }
 
+void EventLoop::setSpinDuration(const SpinDuration spinDuration)
+{
+	if (spinDuration < SpinDuration::zero())
+	{
+		throw PTN_Exception("The spin duration cannot be negative.");
+	}
+	unique_lock lock(m_sleepDurationMutex);
+	m_spinDuration = spinDuration;
+}
+
+EventLoop::SpinDuration EventLoop::getSpinDuration() const
+{
+	shared_lock lock(m_sleepDurationMutex);
+	return m_spinDuration;
+}
+
+void EventLoop::setWatchdogEnabled(const bool watchdogEnabled)
+{
+	{
+		unique_lock lock(m_sleepDurationMutex);
+		m_watchdogEnabled = watchdogEnabled;
+	}
+	// A thread parked by the watchdog timer period must not wait for it anymore.
+	notifyNewEvent();
+}
+
+bool EventLoop::isWatchdogEnabled() const
+{
+	shared_lock lock(m_sleepDurationMutex);
+	return m_watchdogEnabled;
+}
+
+void EventLoop::setBusyPolling(const bool busyPolling)
+{
+	{
+		unique_lock lock(m_sleepDurationMutex);
+		m_busyPolling = busyPolling;
+	}
+	// A parked thread starts busy polling after its next event.
+	notifyNewEvent();
+}
+
+bool EventLoop::isBusyPolling() const
+{
+	shared_lock lock(m_sleepDurationMutex);
+	return m_busyPolling;
+}
+
+void EventLoop::setThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	if (isRunning())
+	{
+		throw PTN_Exception("Cannot change the event loop thread scheduling while the event loop is running.");
+	}
+	utility::checkThreadScheduling(threadScheduling);
+	unique_lock lock(m_sleepDurationMutex);
+	m_threadScheduling = threadScheduling;
+}
+
+ThreadScheduling EventLoop::getThreadScheduling() const
+{
+	shared_lock lock(m_sleepDurationMutex);
+	return m_threadScheduling;
+}
+
+void EventLoop::setEngineScheduler(const shared_ptr<EngineScheduler> &engineScheduler)
+{
+	if (isRunning())
+	{
+		throw PTN_Exception("Cannot change the engine scheduler while the event loop is running.");
+	}
+	unique_lock lock(m_sleepDurationMutex);
+	m_engineScheduler = engineScheduler;
+}
+
+shared_ptr<EngineScheduler> EventLoop::getEngineScheduler() const
+{
+	shared_lock lock(m_sleepDurationMutex);
+	return m_engineScheduler;
+}
+
 void EventLoop::run(stop_token stopToken, const bool log, ostream &o)
 {
 	while (!stopToken.stop_requested())
 	{
+		// Events notified while the net is executed make the wait return immediately.
+		const uint64_t events = m_eventNotifier->events;
 		if (!m_ptnEngine.executeInt(log, o))
 		{
-			shared_lock lock(m_sleepDurationMutex);
-			unique_lock eventNotifierGuard(m_eventNotifierMutex);
-			m_eventNotifier.wait_for(eventNotifierGuard, m_sleepDuration,
-									 [this] { return m_ptnEngine.getNewInputReceived(); });
+			waitForEvent(stopToken, events);
 		}
 	}
 	m_eventLoopThreadRunning = false;
 	m_barrier->arrive_and_wait();
 }
+
+void EventLoop::waitForEvent(const stop_token &stopToken, const uint64_t events)
+{
+	SleepDuration sleepDuration;
+	SpinDuration spinDuration;
+	bool watchdogEnabled;
+	bool busyPolling;
+	{
+		shared_lock lock(m_sleepDurationMutex);
+		sleepDuration = m_sleepDuration;
+		spinDuration = m_spinDuration;
+		watchdogEnabled = m_watchdogEnabled;
+		busyPolling = m_busyPolling;
+	}
+
+	EventNotifier &eventNotifier = *m_eventNotifier;
+	auto newEvent = [&eventNotifier, &stopToken, events]
+	{ return eventNotifier.events != events || stopToken.stop_requested(); };
+
+	if (busyPolling)
+	{
+		// The watchdog still bounds the wait, so that conditions changed without notification are re-evaluated.
+		const auto watchdogEnd = chrono::steady_clock::now() + sleepDuration;
+		while (!newEvent())
+		{
+			if (watchdogEnabled && chrono::steady_clock::now() >= watchdogEnd)
+			{
+				return;
+			}
+			utility::cpuRelax();
+		}
+		return;
+	}
+
+	m_spinBudget = clamp(m_spinBudget, spinDuration / 8, spinDuration);
+	if (m_spinBudget > SpinDuration::zero())
+	{
+		const auto spinEnd = chrono::steady_clock::now() + m_spinBudget;
+		do
+		{
+			if (newEvent())
+			{
+				// Spinning paid off, spin longer next time.
+				m_spinBudget = min(spinDuration, m_spinBudget * 2);
+				return;
+			}
+			this_thread::yield();
+		} while (chrono::steady_clock::now() < spinEnd);
+		// Spinning was wasted, spin shorter next time.
+		m_spinBudget /= 2;
+	}
+
+	unique_lock guard(eventNotifier.mutex);
+	eventNotifier.parked = true;
+	if (watchdogEnabled)
+	{
+		eventNotifier.condition.wait_for(guard, sleepDuration, newEvent);
+	}
+	else
+	{
+		eventNotifier.condition.wait(guard, newEvent);
+	}
+	eventNotifier.parked = false;
+}
 } // namespace ptne
@@ -18,10 +18,13 @@
 
 #pragma once
 
+#include "PTN_Engine/PTN_Engine.h"
 #include <atomic>
 #include <barrier>
 #include <chrono>
 #include <condition_variable>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <thread>
@@ -29,17 +32,31 @@
 namespace ptne
 {
 
+class EngineScheduler;
+class EngineSchedulerImp;
 class IPTN_EngineEL;
+struct ScheduledEngine;
 class Transition;
 
 //!
 //! \brief The EventLoop class manages an event loop thread.
 //!
+//! The net is executed until a cycle fires no transition. The loop then waits for an event: every source
+//! of state changes (new inputs, finished actions, changed conditions) notifies it. Waiting starts by spinning
+//! for a configurable period, adapted to how often spinning caught an event, and continues by parking the
+//! thread until notified or, if the watchdog is enabled, until the watchdog timer period elapsed.
+//! In busy polling mode the thread never parks, trading a core for the lowest wake-up latency.
+//!
+//! With an engine scheduler, no thread is started: the net is executed by the threads of the scheduler,
+//! notified of the same events, and spinning, busy polling and thread scheduling do not apply.
+//!
 class EventLoop
 {
 public:
 	using SleepDuration = std::chrono::duration<long, std::ratio<1, 1000>>;
 
+	using SpinDuration = std::chrono::microseconds;
+
 	~EventLoop();
 
 	//!
@@ -72,10 +89,18 @@ public:
 	void start(const bool log, std::ostream &o);
 
 	//!
-	//! \brief Notify the event loop thread of a new event.
+	//! \brief Notify the event loop thread of a new event. Can be called from any thread. Only locks when the
+	//! event loop thread is parked.
 	//!
 	void notifyNewEvent();
 
+	//!
+	//! \brief Get a function notifying the event loop of a new event, which can be kept by threads that may
+	//! outlive the event loop. It does nothing once the event loop was destroyed.
+	//! \return The notifying function.
+	//!
+	std::function<void()> getEventNotifier() const;
+
 	//!
 	//! \brief Set the event loop watchdog timer period.
 	//! \param sleepTime The event loop watchdog timer period.
@@ -88,7 +113,110 @@ public:
 	//!
 	SleepDuration getSleepDuration() const;
 
+	//!
+	//! \brief Set the maximum time spent spinning, waiting for an event, before parking the thread.
+	//! \param spinDuration - 0 to park immediately.
+	//!
+	void setSpinDuration(const SpinDuration spinDuration);
+
+	//!
+	//! \brief Get the maximum time spent spinning before parking the thread.
+	//! \return The maximum spinning time.
+	//!
+	SpinDuration getSpinDuration() const;
+
+	//!
+	//! \brief Enable or disable the watchdog, waking up the parked thread once per sleep duration even if
+	//! nothing was notified.
+	//! \param watchdogEnabled - false to only wake up when notified.
+	//!
+	void setWatchdogEnabled(const bool watchdogEnabled);
+
+	//!
+	//! \brief Tells if the watchdog is enabled.
+	//! \return True if the parked thread also wakes up once per sleep duration.
+	//!
+	bool isWatchdogEnabled() const;
+
+	//!
+	//! \brief Enable or disable busy polling: the waiting thread spins until notified and never parks.
+	//! With the watchdog enabled the spinning thread also stops waiting once per sleep duration.
+	//! \param busyPolling - true to busy poll.
+	//!
+	void setBusyPolling(const bool busyPolling);
+
+	//!
+	//! \brief Tells if the event loop is busy polling.
+	//! \return True if the waiting thread never parks.
+	//!
+	bool isBusyPolling() const;
+
+	//!
+	//! \brief Set the core pinning and priority of the event loop thread, applied when it starts.
+	//! \throws PTN_Exception if the event loop is running or the scheduling is not supported.
+	//! \param threadScheduling - scheduling of the event loop thread.
+	//!
+	void setThreadScheduling(const ThreadScheduling &threadScheduling);
+
+	//!
+	//! \brief Get the core pinning and priority of the event loop thread.
+	//! \return The scheduling of the event loop thread.
+	//!
+	ThreadScheduling getThreadScheduling() const;
+
+	//!
+	//! \brief Set the engine scheduler executing the net instead of an event loop thread.
+	//! \throws PTN_Exception if the event loop is running.
+	//! \param engineScheduler - the scheduler, null to use an event loop thread.
+	//!
+	void setEngineScheduler(const std::shared_ptr<EngineScheduler> &engineScheduler);
+
+	//!
+	//! \brief Get the engine scheduler executing the net.
+	//! \return The scheduler, null if an event loop thread is used.
+	//!
+	std::shared_ptr<EngineScheduler> getEngineScheduler() const;
+
 private:
+	//!
+	//! \brief State notifying new events, shared with the notifying functions that may outlive the loop.
+	//!
+	struct EventNotifier
+	{
+		//!
+		//! \brief Count a new event and wake up the event loop thread if it is parked.
+		//!
+		void notify();
+
+		//! Number of events notified so far.
+		std::atomic<uint64_t> events = 0;
+
+		//! Flag if the event loop thread is parked.
+		std::atomic<bool> parked = false;
+
+		//! Mutex protecting the condition variable.
+		std::mutex mutex;
+
+		//! Condition variable to wake up the parked event loop thread.
+		std::condition_variable condition;
+
+		//! Flag if the net is executed by an engine scheduler, which must be notified too.
+		std::atomic<bool> scheduled = false;
+
+		//! Scheduler executing the net, while scheduled. Protected by mutex.
+		std::shared_ptr<EngineSchedulerImp> engineScheduler;
+
+		//! The net registered in the scheduler, while scheduled. Protected by mutex.
+		std::shared_ptr<ScheduledEngine> scheduledEngine;
+	};
+
+	//!
+	//! \brief Register the net in the engine scheduler instead of starting the event loop thread.
+	//! \param log Flag to turn on logging on or off.
+	//! \param o Log where to write log messages.
+	//!
+	void startScheduled(const bool log, std::ostream &o);
+
 	//!
 	//! \brief Event loop function.
 	//! \param log Flag to turn on logging on or off.
@@ -96,6 +224,13 @@ private:
 	//!
 	void run(std::stop_token stopToken, const bool log, std::ostream &o);
 
+	//!
+	//! \brief Spin and then park until an event newer than the given one is notified or a stop is requested.
+	//! \param stopToken - stop token of the event loop thread.
+	//! \param events - number of events notified when the last cycle started.
+	//!
+	void waitForEvent(const std::stop_token &stopToken, const uint64_t events);
+
 	//! Reference to the petri net engine.
 	IPTN_EngineEL &m_ptnEngine;
 
@@ -108,17 +243,37 @@ private:
 	//! Flag if the event loop thread is running.
 	std::atomic<bool> m_eventLoopThreadRunning = false;
 
-	//! Condition variable to wake up the event loop thread when some event happens.
-	std::condition_variable m_eventNotifier;
-
-	//! Mutex protecting the event notifier condition variable m_eventNotifier.
-	mutable std::mutex m_eventNotifierMutex;
+	//! Notifies new events to the event loop thread.
+	const std::shared_ptr<EventNotifier> m_eventNotifier = std::make_shared<EventNotifier>();
 
 	//! While idle, watchdog timer period.
 	SleepDuration m_sleepDuration = std::chrono::milliseconds(100);
 
-	//! Mutex protecting m_sleepDuration.
+	//! Maximum time spent spinning before parking.
+	SpinDuration m_spinDuration = SpinDuration::zero();
+
+	//! Flag if the watchdog is enabled.
+	bool m_watchdogEnabled = true;
+
+	//! Flag if the waiting thread busy polls instead of parking.
+	bool m_busyPolling = false;
+
+	//! Core pinning and priority of the event loop thread.
+	ThreadScheduling m_threadScheduling;
+
+	//! Scheduler executing the net instead of the event loop thread, if any.
+	std::shared_ptr<EngineScheduler> m_engineScheduler;
+
+	//! Mutex protecting m_sleepDuration, m_spinDuration, m_watchdogEnabled, m_busyPolling,
+	//! m_threadScheduling and m_engineScheduler.
 	mutable std::shared_mutex m_sleepDurationMutex;
+
+	//! The net registered in the engine scheduler while running scheduled. Only used by start and stop.
+	std::shared_ptr<ScheduledEngine> m_scheduledEngine;
+
+	//! Time spent spinning in the next wait, adapted between m_spinDuration / 8 and m_spinDuration. Only used
+	//! by the event loop thread.
+	SpinDuration m_spinBudget = SpinDuration::max();
 };
 
 } // namespace ptne
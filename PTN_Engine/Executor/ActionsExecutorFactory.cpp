@@ -17,9 +17,12 @@
  */
 
 #include "PTN_Engine/Executor/ActionsExecutorFactory.h"
+#include "PTN_Engine/Executor/AdaptiveExecutor.h"
+#include "PTN_Engine/Executor/CoroutineExecutor.h"
 #include "PTN_Engine/Executor/DetachedExecutor.h"
 #include "PTN_Engine/Executor/JobQueueExecutor.h"
 #include "PTN_Engine/Executor/SingleThreadExecutor.h"
+#include "PTN_Engine/Executor/ThreadPoolExecutor.h"
 #include "PTN_Engine/PTN_Exception.h"
 
 
@@ -29,7 +32,8 @@ namespace ptne
 using namespace std;
 
 unique_ptr<IActionsExecutor>
-ActionsExecutorFactory::createExecutor(PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption)
+ActionsExecutorFactory::createExecutor(PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption,
+									   const ActionsExecutorOptions &options)
 {
 	switch (actionsThreadOption)
 	{
@@ -44,14 +48,40 @@ ActionsExecutorFactory::createExecutor(PTN_Engine::ACTIONS_THREAD_OPTION actions
 	}
 	case PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE:
 	{
+		if (options.jobQueueCapacity > 0)
+		{
+			return make_unique<JobQueueExecutor>(options.jobQueueCapacity, options.jobQueueOverflowPolicy);
+		}
 		return make_unique<JobQueueExecutor>();
 	}
 	case PTN_Engine::ACTIONS_THREAD_OPTION::DETACHED:
 	{
 		return make_unique<DetachedExecutor>();
 	}
+	case PTN_Engine::ACTIONS_THREAD_OPTION::THREAD_POOL:
+	{
+		return make_unique<ThreadPoolExecutor>(options.numberOfActionThreads);
+	}
+	case PTN_Engine::ACTIONS_THREAD_OPTION::COROUTINE:
+	{
+		return make_unique<CoroutineExecutor>();
+	}
+	case PTN_Engine::ACTIONS_THREAD_OPTION::ADAPTIVE:
+	{
+		if (options.jobQueueCapacity > 0)
+		{
+			return make_unique<AdaptiveExecutor>(options.inlineActionThreshold, options.jobQueueCapacity,
+												 options.jobQueueOverflowPolicy);
+		}
+		return make_unique<AdaptiveExecutor>(options.inlineActionThreshold);
+	}
 	}
 }
 
+shared_ptr<IActionsExecutor> createActionsExecutor(const PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption,
+												   const ActionsExecutorOptions &options)
+{
+	return ActionsExecutorFactory::createExecutor(actionsThreadOption, options);
+}
 
 } // namespace ptne
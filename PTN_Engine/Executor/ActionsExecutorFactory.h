@@ -18,7 +18,7 @@
 
 #pragma once
 
-#include "PTN_Engine/Executor/IActionsExecutor.h"
+#include "PTN_Engine/IActionsExecutor.h"
 
 namespace ptne
 {
@@ -26,8 +26,15 @@ namespace ptne
 class ActionsExecutorFactory
 {
 public:
+	//!
+	//! \brief Create the executor of an actions thread option.
+	//! \param actionsThreadOption - where the actions are run.
+	//! \param options - settings of the executor.
+	//! \return The executor.
+	//!
 	static std::unique_ptr<IActionsExecutor> createExecutor(
-	PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption = PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption = PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP,
+	const ActionsExecutorOptions &options = ActionsExecutorOptions());
 };
 
 } // namespace ptne
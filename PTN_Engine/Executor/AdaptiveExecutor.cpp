@@ -0,0 +1,188 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Executor/AdaptiveExecutor.h"
+#include <mutex>
+
+namespace ptne
+{
+
+using namespace std;
+
+namespace
+{
+
+//! Weight of the last sample in the moving average of the durations, as a power of 2.
+constexpr int averageWeightShift = 3;
+
+} // namespace
+
+AdaptiveExecutor::ActionStatistics::ActionStatistics(atomic<size_t> &actionsInExecution,
+													  const shared_ptr<const ActionCompletedNotifier> &notifier,
+													  const chrono::nanoseconds threshold)
+: actionsInExecution(actionsInExecution)
+, m_threshold(threshold.count())
+, m_averageDuration(threshold.count())
+, m_notifier(notifier)
+, m_hasNotifier(notifier != nullptr)
+{
+}
+
+void AdaptiveExecutor::ActionStatistics::addSample(const chrono::nanoseconds duration)
+{
+	auto average = m_averageDuration.load(memory_order_relaxed);
+	average += (duration.count() - average) >> averageWeightShift;
+	m_averageDuration.store(average, memory_order_relaxed);
+
+	// Hysteresis, between half the threshold and the threshold the classification is kept.
+	if (average > m_threshold)
+	{
+		m_offloaded.store(true, memory_order_relaxed);
+	}
+	else if (average < m_threshold / 2)
+	{
+		m_offloaded.store(false, memory_order_relaxed);
+	}
+}
+
+bool AdaptiveExecutor::ActionStatistics::isOffloaded() const
+{
+	return m_offloaded.load(memory_order_relaxed);
+}
+
+bool AdaptiveExecutor::ActionStatistics::isExpired() const
+{
+	return m_hasNotifier && m_notifier.expired();
+}
+
+AdaptiveExecutor::~AdaptiveExecutor() = default;
+
+AdaptiveExecutor::AdaptiveExecutor(const chrono::nanoseconds inlineActionThreshold)
+: m_inlineActionThreshold(inlineActionThreshold)
+{
+}
+
+AdaptiveExecutor::AdaptiveExecutor(const chrono::nanoseconds inlineActionThreshold,
+								   const size_t capacity,
+								   const PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY overflowPolicy)
+: m_inlineActionThreshold(inlineActionThreshold)
+, m_jobQueue(capacity, overflowPolicy)
+{
+}
+
+void AdaptiveExecutor::executeAction(ActionJob action,
+									 atomic<size_t> &actionsInExecution,
+									 const shared_ptr<const ActionCompletedNotifier> &notifier)
+{
+	ActionStatistics &statistics = getStatistics(actionsInExecution, notifier);
+	++actionsInExecution;
+	if (!statistics.isOffloaded())
+	{
+		// Runs in the thread of the engine, which does not need to be woken up.
+		const auto start = chrono::steady_clock::now();
+		action();
+		statistics.addSample(chrono::steady_clock::now() - start);
+		--actionsInExecution;
+		actionsInExecution.notify_all();
+		return;
+	}
+
+	// Captures the action first, so that the job fits in place without padding.
+	auto f = [action = move(action), &statistics, notifier]() mutable
+	{
+		const auto start = chrono::steady_clock::now();
+		action();
+		statistics.addSample(chrono::steady_clock::now() - start);
+		--statistics.actionsInExecution;
+		statistics.actionsInExecution.notify_all();
+		if (notifier && *notifier)
+		{
+			(*notifier)();
+		}
+	};
+	// Actions dropped or rejected by a bounded job queue no longer count as in execution.
+	auto onDropped = [&statistics, notifier]()
+	{
+		--statistics.actionsInExecution;
+		statistics.actionsInExecution.notify_all();
+		if (notifier && *notifier)
+		{
+			(*notifier)();
+		}
+	};
+	static_assert(Job::isStoredInPlace<decltype(f)>() && Job::isStoredInPlace<decltype(onDropped)>());
+	m_jobQueue.addJob(move(f), move(onDropped));
+}
+
+void AdaptiveExecutor::setThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	m_jobQueue.setThreadScheduling(threadScheduling);
+}
+
+JobQueueMetrics AdaptiveExecutor::getJobQueueMetrics() const
+{
+	return m_jobQueue.getMetrics();
+}
+
+bool AdaptiveExecutor::isOffloaded(const atomic<size_t> &actionsInExecution) const
+{
+	shared_lock guard(m_statisticsMutex);
+	const auto it = m_statistics.find(&actionsInExecution);
+	return it == m_statistics.end() || it->second->isOffloaded();
+}
+
+size_t AdaptiveExecutor::getNumberOfStatistics() const
+{
+	shared_lock guard(m_statisticsMutex);
+	return m_statistics.size();
+}
+
+AdaptiveExecutor::ActionStatistics &
+AdaptiveExecutor::getStatistics(atomic<size_t> &actionsInExecution,
+								const shared_ptr<const ActionCompletedNotifier> &notifier)
+{
+	{
+		shared_lock guard(m_statisticsMutex);
+		if (const auto it = m_statistics.find(&actionsInExecution); it != m_statistics.end() && !it->second->isExpired())
+		{
+			return *it->second;
+		}
+	}
+	unique_lock guard(m_statisticsMutex);
+	auto &statistics = m_statistics[&actionsInExecution];
+	// Expired statistics belong to a place that is gone, whose counter was reused by a new place.
+	if (statistics == nullptr || statistics->isExpired())
+	{
+		statistics = make_unique<ActionStatistics>(actionsInExecution, notifier, m_inlineActionThreshold);
+	}
+	ActionStatistics &result = *statistics;
+	sweepExpiredStatistics();
+	return result;
+}
+
+void AdaptiveExecutor::sweepExpiredStatistics()
+{
+	if (m_statistics.size() < m_nextSweep)
+	{
+		return;
+	}
+	erase_if(m_statistics, [](const auto &statistics) { return statistics.second->isExpired(); });
+	m_nextSweep = max(m_nextSweep, 2 * m_statistics.size());
+}
+
+} // namespace ptne
@@ -0,0 +1,175 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "PTN_Engine/IActionsExecutor.h"
+#include "PTN_Engine/JobQueue/JobQueue.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace ptne
+{
+
+//!
+//! \brief Runs cheap actions inline, in the thread firing the transitions, and offloads expensive actions to a
+//! job queue, so that they do not block the event loop.
+//!
+//! The duration of each action is measured every time it runs, and averaged per action. An action is
+//! offloaded once its average exceeds the threshold, and only runs inline again once its average falls below
+//! half the threshold, so that actions close to the threshold do not switch back and forth. Actions start
+//! offloaded until they are known to be cheap.
+//!
+class AdaptiveExecutor : public IActionsExecutor
+{
+public:
+	~AdaptiveExecutor() override;
+
+	//!
+	//! \brief AdaptiveExecutor constructor with an unbounded job queue.
+	//! \param inlineActionThreshold - average duration above which the actions are offloaded.
+	//!
+	explicit AdaptiveExecutor(const std::chrono::nanoseconds inlineActionThreshold);
+
+	//!
+	//! \brief AdaptiveExecutor constructor with a bounded job queue.
+	//! \param inlineActionThreshold - average duration above which the actions are offloaded.
+	//! \param capacity - maximum number of queued actions, rounded up to a power of 2 of at least 2. At least 1.
+	//! \param overflowPolicy - what to do with actions offloaded while the job queue is full.
+	//!
+	AdaptiveExecutor(const std::chrono::nanoseconds inlineActionThreshold,
+					 const size_t capacity,
+					 const PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY overflowPolicy);
+
+	AdaptiveExecutor(const AdaptiveExecutor &) = delete;
+	AdaptiveExecutor(AdaptiveExecutor &&) = delete;
+	AdaptiveExecutor &operator=(const AdaptiveExecutor &) = delete;
+	AdaptiveExecutor &operator=(AdaptiveExecutor &&) = delete;
+
+	void executeAction(ActionJob action,
+					   std::atomic<size_t> &actionsInExecution,
+					   const std::shared_ptr<const ActionCompletedNotifier> &notifier) override;
+
+	void setThreadScheduling(const ThreadScheduling &threadScheduling) override;
+
+	JobQueueMetrics getJobQueueMetrics() const override;
+
+	//!
+	//! \brief Tells if the actions accounted in a counter are currently offloaded.
+	//! \param actionsInExecution - counter of the actions in execution the actions are accounted in.
+	//! \return True if the actions are offloaded, or were never executed.
+	//!
+	bool isOffloaded(const std::atomic<size_t> &actionsInExecution) const;
+
+	//!
+	//! \brief Number of counters statistics are kept for, including those of places gone since the last sweep.
+	//! \return The number of statistics.
+	//!
+	size_t getNumberOfStatistics() const;
+
+private:
+	//!
+	//! \brief Measured durations of the actions accounted in one counter, that is the on enter or the on exit
+	//! actions of one place.
+	//!
+	class ActionStatistics final
+	{
+	public:
+		ActionStatistics(std::atomic<size_t> &actionsInExecution,
+						 const std::shared_ptr<const ActionCompletedNotifier> &notifier,
+						 const std::chrono::nanoseconds threshold);
+
+		//!
+		//! \brief Add the duration of one execution to the average, and reclassify the action.
+		//! \param duration - duration of the execution.
+		//!
+		void addSample(const std::chrono::nanoseconds duration);
+
+		//!
+		//! \brief Tells if the action is offloaded.
+		//! \return True if the action runs on the job queue.
+		//!
+		bool isOffloaded() const;
+
+		//!
+		//! \brief Tells if the place the statistics belong to is gone, along with all its actions.
+		//! \return True if the statistics can be discarded.
+		//!
+		bool isExpired() const;
+
+		//! Counter of the actions in execution the actions are accounted in.
+		std::atomic<size_t> &actionsInExecution;
+
+	private:
+		//! Average duration above which the action is offloaded.
+		const std::chrono::nanoseconds::rep m_threshold;
+
+		//! Exponential moving average of the duration in nanoseconds. Updates racing each other may be lost,
+		//! which only delays the classification.
+		std::atomic<std::chrono::nanoseconds::rep> m_averageDuration;
+
+		//! If the action runs on the job queue.
+		std::atomic<bool> m_offloaded = true;
+
+		//! Notifier of the place, held by the place and by its actions in execution, so that the counter of the
+		//! place is not reused before it expired. Null if the actions were handed over without notifier, in
+		//! which case the statistics are kept as long as the executor.
+		const std::weak_ptr<const ActionCompletedNotifier> m_notifier;
+
+		//! If the actions were handed over with a notifier.
+		const bool m_hasNotifier;
+	};
+
+	//!
+	//! \brief Get the statistics of the actions accounted in a counter, creating them on first use and replacing
+	//! those of a place that is gone and whose counter was reused.
+	//! \param actionsInExecution - counter of the actions in execution the actions are accounted in.
+	//! \param notifier - notifier handed over with the actions.
+	//! \return The statistics, valid as long as the notifier is held, or as the executor without notifier.
+	//!
+	ActionStatistics &getStatistics(std::atomic<size_t> &actionsInExecution,
+									const std::shared_ptr<const ActionCompletedNotifier> &notifier);
+
+	//!
+	//! \brief Discard the statistics of the places that are gone, once their number doubled since the last
+	//! sweep, so that engines and places created and destroyed over time do not grow the statistics.
+	//!
+	void sweepExpiredStatistics();
+
+	//! Average duration above which the actions are offloaded.
+	const std::chrono::nanoseconds m_inlineActionThreshold;
+
+	//! Protects m_statistics.
+	mutable std::shared_mutex m_statisticsMutex;
+
+	//! Statistics identified by the counter of the place the actions belong to. The statistics of a place
+	//! expire with its notifier, which outlives its actions in execution.
+	std::unordered_map<const std::atomic<size_t> *, std::unique_ptr<ActionStatistics>> m_statistics;
+
+	//! Number of statistics at which the expired ones are swept next.
+	size_t m_nextSweep = 64;
+
+	//! Job queue running the offloaded actions. Destroyed first, so no action outlives its statistics.
+	JobQueue m_jobQueue;
+};
+
+} // namespace ptne
@@ -0,0 +1,83 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/Executor/CoroutineExecutor.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include "PTN_Engine/Utilities/ThreadScheduling.h"
+#include <atomic>
+
+namespace ptne
+{
+
+using namespace std;
+
+CoroutineExecutor::~CoroutineExecutor() = default;
+
+CoroutineExecutor::CoroutineExecutor()
+: m_thread([this](stop_token stopToken) { m_coroutineRunner.run(move(stopToken)); })
+{
+}
+
+void CoroutineExecutor::executeAction(ActionJob action,
+									  atomic<size_t> &actionsInExecution,
+									  const shared_ptr<const ActionCompletedNotifier> &notifier)
+{
+	++actionsInExecution;
+	// Captures the action first, so that the job fits in place without padding.
+	auto f = [action = move(action), &actionsInExecution, notifier]() mutable
+	{
+		action();
+		--actionsInExecution;
+		actionsInExecution.notify_all();
+		if (notifier && *notifier)
+		{
+			(*notifier)();
+		}
+	};
+	static_assert(Job::isStoredInPlace<decltype(f)>());
+	m_coroutineRunner.post(move(f));
+}
+
+void CoroutineExecutor::executeAsyncAction(const AsyncActionFunction &action,
+										   atomic<size_t> &actionsInExecution,
+										   const shared_ptr<const ActionCompletedNotifier> &notifier)
+{
+	++actionsInExecution;
+	// Accounted for once the coroutine completed, not when it first suspends.
+	auto f = [this, &action, &actionsInExecution, notifier]
+	{ m_coroutineRunner.start(action(), &actionsInExecution, notifier); };
+	static_assert(Job::isStoredInPlace<decltype(f)>());
+	m_coroutineRunner.post(move(f));
+}
+
+void CoroutineExecutor::setThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	utility::checkThreadScheduling(threadScheduling);
+	lock_guard guard(m_threadSchedulingMutex);
+	try
+	{
+		utility::applyThreadScheduling(m_thread.native_handle(), threadScheduling);
+	}
+	catch (const PTN_Exception &)
+	{
+		// The actions must run even without the requested scheduling.
+	}
+}
+
+} // namespace ptne
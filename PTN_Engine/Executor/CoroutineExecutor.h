@@ -0,0 +1,72 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "PTN_Engine/IActionsExecutor.h"
+#include "PTN_Engine/JobQueue/CoroutineRunner.h"
+#include <mutex>
+#include <thread>
+
+namespace ptne
+{
+
+//!
+//! \brief Executes the actions in a single thread, where coroutine actions only hold the thread while they
+//! run: suspended on a timer or an asynchronous operation, the thread moves on to the next action.
+//!
+//! Plain actions and the parts of the coroutine actions between suspensions run in the order they are ready.
+//!
+class CoroutineExecutor : public IActionsExecutor
+{
+public:
+	~CoroutineExecutor() override;
+
+	//!
+	//! \brief CoroutineExecutor constructor, launching the thread.
+	//!
+	CoroutineExecutor();
+
+	CoroutineExecutor(const CoroutineExecutor &) = delete;
+	CoroutineExecutor(CoroutineExecutor &&) = delete;
+	CoroutineExecutor &operator=(const CoroutineExecutor &) = delete;
+	CoroutineExecutor &operator=(CoroutineExecutor &&) = delete;
+
+	void executeAction(ActionJob action,
+					   std::atomic<size_t> &actionsInExecution,
+					   const std::shared_ptr<const ActionCompletedNotifier> &notifier) override;
+
+	void executeAsyncAction(const AsyncActionFunction &action,
+							std::atomic<size_t> &actionsInExecution,
+							const std::shared_ptr<const ActionCompletedNotifier> &notifier) override;
+
+	void setThreadScheduling(const ThreadScheduling &threadScheduling) override;
+
+private:
+	//! Runs the actions in m_thread.
+	CoroutineRunner m_coroutineRunner;
+
+	//! Synchronizes applying the thread scheduling.
+	std::mutex m_threadSchedulingMutex;
+
+	//! Thread running the actions. Destroyed first, waiting for the actions in flight.
+	std::jthread m_thread;
+};
+
+} // namespace ptne
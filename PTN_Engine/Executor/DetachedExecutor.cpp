@@ -25,15 +25,22 @@ namespace ptne
 
 using namespace std;
 
-void DetachedExecutor::executeAction(const ActionFunction &action, atomic<size_t> &actionsInExecution)
+void DetachedExecutor::executeAction(ActionJob action,
+									 atomic<size_t> &actionsInExecution,
+									 const shared_ptr<const ActionCompletedNotifier> &notifier)
 {
 	++actionsInExecution;
-	auto job = [&actionsInExecution, &action]()
+	auto job = [action = move(action), &actionsInExecution, notifier]() mutable
 	{
 		action();
 		--actionsInExecution;
+		actionsInExecution.notify_all();
+		if (notifier && *notifier)
+		{
+			(*notifier)();
+		}
 	};
-	auto t = thread(job);
+	auto t = thread(move(job));
 	t.detach();
 }
 
@@ -18,7 +18,7 @@
 
 #pragma once
 
-#include "PTN_Engine/Executor/IActionsExecutor.h"
+#include "PTN_Engine/IActionsExecutor.h"
 
 namespace ptne
 {
@@ -26,7 +26,10 @@ namespace ptne
 class DetachedExecutor : public IActionsExecutor
 {
 public:
-    void executeAction(const ActionFunction &action, std::atomic<size_t> &actionsInExecution) override;
+    void executeAction(ActionJob action,
+					   std::atomic<size_t> &actionsInExecution,
+					   const std::shared_ptr<const ActionCompletedNotifier> &notifier) override;
+
 };
 
 } // namespace ptne
@@ -24,15 +24,51 @@ namespace ptne
 
 using namespace std;
 
-void JobQueueExecutor::executeAction(const ActionFunction &action, atomic<size_t> &actionsInExecution)
+JobQueueExecutor::JobQueueExecutor() = default;
+
+JobQueueExecutor::JobQueueExecutor(const size_t capacity, const PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY overflowPolicy)
+: m_jobQueue(capacity, overflowPolicy)
+{
+}
+
+void JobQueueExecutor::executeAction(ActionJob action,
+									 atomic<size_t> &actionsInExecution,
+									 const shared_ptr<const ActionCompletedNotifier> &notifier)
 {
 	++actionsInExecution;
-	auto f = [&actionsInExecution, &action]()
+	// Captures the action first, so that the job fits in place without padding.
+	auto f = [action = move(action), &actionsInExecution, notifier]() mutable
 	{
 		action();
 		--actionsInExecution;
+		actionsInExecution.notify_all();
+		if (notifier && *notifier)
+		{
+			(*notifier)();
+		}
+	};
+	// Actions dropped or rejected by a bounded job queue no longer count as in execution.
+	auto onDropped = [&actionsInExecution, notifier]()
+	{
+		--actionsInExecution;
+		actionsInExecution.notify_all();
+		if (notifier && *notifier)
+		{
+			(*notifier)();
+		}
 	};
-	m_jobQueue.addJob(f);
+	static_assert(Job::isStoredInPlace<decltype(f)>() && Job::isStoredInPlace<decltype(onDropped)>());
+	m_jobQueue.addJob(move(f), move(onDropped));
+}
+
+void JobQueueExecutor::setThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	m_jobQueue.setThreadScheduling(threadScheduling);
+}
+
+JobQueueMetrics JobQueueExecutor::getJobQueueMetrics() const
+{
+	return m_jobQueue.getMetrics();
 }
 
 } // namespace ptne
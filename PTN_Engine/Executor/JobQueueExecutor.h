@@ -18,7 +18,7 @@
 
 #pragma once
 
-#include "PTN_Engine/Executor/IActionsExecutor.h"
+#include "PTN_Engine/IActionsExecutor.h"
 #include "PTN_Engine/JobQueue/JobQueue.h"
 
 namespace ptne
@@ -27,7 +27,25 @@ namespace ptne
 class JobQueueExecutor : public IActionsExecutor
 {
 public:
-	void executeAction(const ActionFunction &action, std::atomic<size_t> &actionsInExecution) override;
+	//!
+	//! \brief JobQueueExecutor constructor with an unbounded job queue.
+	//!
+	JobQueueExecutor();
+
+	//!
+	//! \brief JobQueueExecutor constructor with a bounded job queue.
+	//! \param capacity - maximum number of queued actions, rounded up to a power of 2 of at least 2. At least 1.
+	//! \param overflowPolicy - what to do with actions dispatched while the job queue is full.
+	//!
+	JobQueueExecutor(const size_t capacity, const PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY overflowPolicy);
+
+	void executeAction(ActionJob action,
+					   std::atomic<size_t> &actionsInExecution,
+					   const std::shared_ptr<const ActionCompletedNotifier> &notifier) override;
+
+	void setThreadScheduling(const ThreadScheduling &threadScheduling) override;
+
+	JobQueueMetrics getJobQueueMetrics() const override;
 
 private:
 	//! Job queue to dispatch actions.
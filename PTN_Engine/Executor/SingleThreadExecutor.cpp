@@ -24,11 +24,16 @@ namespace ptne
 
 using namespace std;
 
-void SingleThreadExecutor::executeAction(const ActionFunction &action, atomic<size_t> &actionsInExecution)
+void SingleThreadExecutor::executeAction(ActionJob action,
+										 atomic<size_t> &actionsInExecution,
+										 const shared_ptr<const ActionCompletedNotifier> &notifier)
 {
+	// Actions run in the thread of the engine, which does not need to be woken up.
+	(void)notifier;
 	++actionsInExecution;
 	action();
 	--actionsInExecution;
+	actionsInExecution.notify_all();
 }
 
 } // namespace ptne
@@ -0,0 +1,57 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Executor/ThreadPoolExecutor.h"
+#include <atomic>
+
+namespace ptne
+{
+
+using namespace std;
+
+ThreadPoolExecutor::ThreadPoolExecutor(const size_t numberOfThreads)
+: m_threadPool(numberOfThreads)
+{
+}
+
+void ThreadPoolExecutor::executeAction(ActionJob action,
+									   atomic<size_t> &actionsInExecution,
+									   const shared_ptr<const ActionCompletedNotifier> &notifier)
+{
+	++actionsInExecution;
+	// Captures the action first, so that the job fits in place without padding.
+	auto f = [action = move(action), &actionsInExecution, notifier]() mutable
+	{
+		action();
+		--actionsInExecution;
+		actionsInExecution.notify_all();
+		if (notifier && *notifier)
+		{
+			(*notifier)();
+		}
+	};
+	static_assert(Job::isStoredInPlace<decltype(f)>());
+	m_threadPool.addJob(move(f));
+}
+
+void ThreadPoolExecutor::setThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	m_threadPool.setThreadScheduling(threadScheduling);
+}
+
+} // namespace ptne
@@ -0,0 +1,50 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/IActionsExecutor.h"
+#include "PTN_Engine/JobQueue/ThreadPool.h"
+
+namespace ptne
+{
+
+//!
+//! \brief Executes the actions on a fixed size work stealing thread pool.
+//!
+class ThreadPoolExecutor : public IActionsExecutor
+{
+public:
+	//!
+	//! \brief ThreadPoolExecutor constructor.
+	//! \param numberOfThreads - number of threads executing the actions. At least 1.
+	//!
+	explicit ThreadPoolExecutor(const size_t numberOfThreads);
+
+	void executeAction(ActionJob action,
+					   std::atomic<size_t> &actionsInExecution,
+					   const std::shared_ptr<const ActionCompletedNotifier> &notifier) override;
+
+	void setThreadScheduling(const ThreadScheduling &threadScheduling) override;
+
+private:
+	//! Threads executing the actions. Destroyed first, waiting for the queued actions.
+	ThreadPool m_threadPool;
+};
+
+} // namespace ptne
@@ -0,0 +1,593 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/FrozenNet.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include "PTN_Engine/Place.h"
+#include "PTN_Engine/Transition.h"
+#include "PTN_Engine/Utilities/LockWeakPtr.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <climits>
+
+namespace ptne
+{
+using namespace std;
+
+FrozenNet::~FrozenNet() = default;
+
+FrozenNet::FrozenNet(const vector<shared_ptr<Place>> &places,
+					 const vector<shared_ptr<Transition>> &transitions,
+					 IConflictResolver &conflictResolver)
+: m_places(places)
+, m_transitions(transitions)
+, m_conflictResolver(conflictResolver)
+{
+	unordered_map<const Place *, size_t> placeIndices;
+	for (size_t i = 0; i < m_places.size(); ++i)
+	{
+		const auto &place = m_places[i];
+		placeIndices[place.get()] = i;
+		m_placeIndices[place->getName()] = i;
+		m_tokens.push_back(place->getNumberOfTokens());
+		m_isInputPlace.push_back(place->isInputPlace());
+
+		m_hasOnEnterAction.push_back(place->hasOnEnterAction());
+		m_hasOnExitAction.push_back(place->hasOnExitAction());
+	}
+
+	auto appendArcs = [&placeIndices](IncidenceMatrix &matrix, const vector<Arc> &arcs)
+	{
+		matrix.offsets.push_back(matrix.places.size());
+		for (const Arc &arc : arcs)
+		{
+			matrix.places.push_back(placeIndices.at(lockWeakPtr(arc.place).get()));
+			matrix.weights.push_back(arc.weight);
+		}
+	};
+
+	for (const auto &transition : m_transitions)
+	{
+		appendArcs(m_activationArcs, transition->getActivationArcs());
+		appendArcs(m_destinationArcs, transition->getDestinationArcs());
+		appendArcs(m_inhibitorArcs, transition->getInhibitorArcs());
+
+		m_conditionsOffsets.push_back(m_conditions.size());
+		ranges::copy(transition->getAdditionalActivationConditions(), back_inserter(m_conditions));
+		m_requireNoActionsInExecution.push_back(transition->requireNoActionsInExecution());
+	}
+	m_activationArcs.offsets.push_back(m_activationArcs.places.size());
+	m_destinationArcs.offsets.push_back(m_destinationArcs.places.size());
+	m_inhibitorArcs.offsets.push_back(m_inhibitorArcs.places.size());
+	m_conditionsOffsets.push_back(m_conditions.size());
+
+	const size_t sentinelPlace = m_tokens.size();
+	m_tokens.push_back(0);
+	m_enablingKernel = make_unique<EnablingKernel>(m_activationArcs, m_inhibitorArcs, sentinelPlace);
+
+	m_conflictGroups.build(m_transitions);
+	m_enabledTransitions.reserve(m_transitions.size());
+}
+
+void FrozenNet::clearInputPlaces()
+{
+	lock_guard guard(m_mutex);
+	for (size_t place = 0; place < m_places.size(); ++place)
+	{
+		if (m_isInputPlace[place])
+		{
+			atomic_ref(m_tokens[place]).store(0, memory_order_relaxed);
+		}
+	}
+}
+
+bool FrozenNet::execute(const bool multiFiring, const bool maximalStep)
+{
+	lock_guard guard(m_mutex);
+
+	m_enablingKernel->computeEnabled(m_tokens, m_enabledMask);
+	m_enabledTransitions.clear();
+	for (size_t word = 0; word < m_enabledMask.size(); ++word)
+	{
+		for (uint64_t bits = m_enabledMask[word]; bits != 0; bits &= bits - 1)
+		{
+			m_enabledTransitions.push_back(word * 64 + countr_zero(bits));
+		}
+	}
+	m_conflictGroups.resolve(m_enabledTransitions, m_conflictResolver);
+
+	if (m_firingPool)
+	{
+		return executeRegions(multiFiring, maximalStep);
+	}
+
+	if (maximalStep)
+	{
+		return executeStep(multiFiring);
+	}
+
+	bool firedAtLeastOneTransition = false;
+	for (const size_t transition : m_enabledTransitions)
+	{
+		// Firing previous transitions may have disabled this one.
+		if (isEnabled(transition) && checkGuards(transition))
+		{
+			const size_t firings = multiFiring ? enablingDegree(transition) : 1;
+			consume(transition, firings);
+			produce(transition, firings);
+			firedAtLeastOneTransition = true;
+		}
+	}
+	return firedAtLeastOneTransition;
+}
+
+size_t FrozenNet::getNumberOfFiringThreads() const
+{
+	lock_guard guard(m_mutex);
+	return m_firingPool ? m_firingPool->getNumberOfThreads() : 1;
+}
+
+size_t FrozenNet::getNumberOfTokens(const string &place) const
+{
+	// Not locked, so that conditions evaluated by the firing threads can read the marking. The places never
+	// change while frozen and the tokens are read atomically.
+	return loadTokens(getPlaceIndex(place));
+}
+
+size_t FrozenNet::getNumberOfTokens(const size_t place) const
+{
+	if (place >= m_places.size())
+	{
+		throw InvalidHandleException(place);
+	}
+	return loadTokens(place);
+}
+
+vector<PlaceProperties> FrozenNet::getPlacesProperties() const
+{
+	lock_guard guard(m_mutex);
+	vector<PlaceProperties> placesProperties;
+	for (size_t place = 0; place < m_places.size(); ++place)
+	{
+		auto placeProperties = m_places[place]->placeProperties();
+		placeProperties.initialNumberOfTokens = m_tokens[place];
+		placesProperties.push_back(placeProperties);
+	}
+	return placesProperties;
+}
+
+void FrozenNet::incrementInputPlace(const string &place, const size_t count)
+{
+	lock_guard guard(m_mutex);
+	const size_t index = getPlaceIndex(place);
+	if (!m_isInputPlace[index])
+	{
+		throw NotInputPlaceException(place);
+	}
+	if (count == 0)
+	{
+		throw NullTokensException();
+	}
+	enterPlace(index, count, count);
+}
+
+void FrozenNet::incrementInputPlace(const size_t place, const size_t count)
+{
+	lock_guard guard(m_mutex);
+	if (place >= m_places.size())
+	{
+		throw InvalidHandleException(place);
+	}
+	if (!m_isInputPlace[place])
+	{
+		throw NotInputPlaceException(m_places[place]->getName());
+	}
+	if (count == 0)
+	{
+		throw NullTokensException();
+	}
+	enterPlace(place, count, count);
+}
+
+void FrozenNet::incrementInputPlaces(span<const pair<PlaceHandle, size_t>> increments)
+{
+	lock_guard guard(m_mutex);
+
+	// The tokens of the batch are accumulated per place, so that the overflow check accounts for places
+	// appearing more than once. The accumulated tokens are cleared on the way out, also if validation fails.
+	m_batchTokens.resize(m_places.size());
+	auto clearBatchTokens = [this, increments]
+	{
+		for (const auto &[handle, _] : increments)
+		{
+			if (handle.index < m_batchTokens.size())
+			{
+				m_batchTokens[handle.index] = 0;
+			}
+		}
+	};
+
+	try
+	{
+		for (const auto &[handle, count] : increments)
+		{
+			const size_t place = handle.index;
+			if (place >= m_places.size())
+			{
+				throw InvalidHandleException(place);
+			}
+			if (!m_isInputPlace[place])
+			{
+				throw NotInputPlaceException(m_places[place]->getName());
+			}
+			if (count == 0)
+			{
+				throw NullTokensException();
+			}
+			if (count > ULLONG_MAX - m_batchTokens[place] ||
+				m_batchTokens[place] + count > ULLONG_MAX - loadTokens(place))
+			{
+				throw OverflowException(count);
+			}
+			m_batchTokens[place] += count;
+		}
+	}
+	catch (...)
+	{
+		clearBatchTokens();
+		throw;
+	}
+	clearBatchTokens();
+
+	for (const auto &[handle, count] : increments)
+	{
+		enterPlace(handle.index, count, count);
+	}
+}
+
+void FrozenNet::setNumberOfFiringThreads(const size_t numberOfFiringThreads)
+{
+	if (numberOfFiringThreads == 0)
+	{
+		throw PTN_Exception("The number of firing threads must be at least 1.");
+	}
+
+	lock_guard guard(m_mutex);
+	if (numberOfFiringThreads == 1)
+	{
+		m_firingPool.reset();
+	}
+	else if (!m_firingPool || m_firingPool->getNumberOfThreads() != numberOfFiringThreads)
+	{
+		m_firingPool = make_unique<WorkStealingPool>(numberOfFiringThreads);
+	}
+}
+
+void FrozenNet::printState(ostream &o) const
+{
+	lock_guard guard(m_mutex);
+	o << "Place; Tokens" << endl;
+	for (const auto &[placeName, place] : m_placeIndices)
+	{
+		o << placeName.c_str() << ": " << m_tokens[place] << endl;
+	}
+	o << endl << endl;
+}
+
+void FrozenNet::thaw() const
+{
+	lock_guard guard(m_mutex);
+	for (size_t place = 0; place < m_places.size(); ++place)
+	{
+		m_places[place]->setNumberOfTokens(m_tokens[place]);
+	}
+}
+
+// Private
+
+bool FrozenNet::isEnabled(const size_t transition) const
+{
+	for (size_t arc = m_inhibitorArcs.offsets[transition]; arc < m_inhibitorArcs.offsets[transition + 1]; ++arc)
+	{
+		if (loadTokens(m_inhibitorArcs.places[arc]) > 0)
+		{
+			return false;
+		}
+	}
+
+	for (size_t arc = m_activationArcs.offsets[transition]; arc < m_activationArcs.offsets[transition + 1];
+		 ++arc)
+	{
+		if (loadTokens(m_activationArcs.places[arc]) < m_activationArcs.weights[arc])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FrozenNet::checkGuards(const size_t transition) const
+{
+	if (m_requireNoActionsInExecution[transition])
+	{
+		for (size_t arc = m_activationArcs.offsets[transition]; arc < m_activationArcs.offsets[transition + 1];
+			 ++arc)
+		{
+			if (m_places[m_activationArcs.places[arc]]->isOnEnterActionInExecution())
+			{
+				return false;
+			}
+		}
+	}
+
+	for (size_t i = m_conditionsOffsets[transition]; i < m_conditionsOffsets[transition + 1]; ++i)
+	{
+		const auto &[name, activationCondition] = m_conditions[i];
+		if (!activationCondition)
+		{
+			throw PTN_Exception("Invalid activation condition " + name);
+		}
+		if (!activationCondition())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+size_t FrozenNet::enablingDegree(const size_t transition) const
+{
+	if (m_activationArcs.offsets[transition] == m_activationArcs.offsets[transition + 1])
+	{
+		return 1;
+	}
+
+	size_t degree = ULLONG_MAX;
+	for (size_t arc = m_activationArcs.offsets[transition]; arc < m_activationArcs.offsets[transition + 1];
+		 ++arc)
+	{
+		degree = min(degree, loadTokens(m_activationArcs.places[arc]) / m_activationArcs.weights[arc]);
+	}
+	return degree;
+}
+
+bool FrozenNet::executeStep(const bool multiFiring)
+{
+	m_stepFirings.clear();
+	for (const size_t transition : m_enabledTransitions)
+	{
+		// Tokens are only produced at the end of the step, so a transition that does not share its activation
+		// places keeps the marking the kernel evaluated. Only conflicting transitions need to be checked again.
+		if ((!m_conflictGroups.hasConflicts(transition) || isEnabled(transition)) && checkGuards(transition))
+		{
+			const size_t firings = multiFiring ? enablingDegree(transition) : 1;
+			consume(transition, firings);
+			m_stepFirings.emplace_back(transition, firings);
+		}
+	}
+
+	for (const auto &[transition, firings] : m_stepFirings)
+	{
+		produce(transition, firings);
+	}
+	return !m_stepFirings.empty();
+}
+
+bool FrozenNet::executeRegions(const bool multiFiring, const bool maximalStep)
+{
+	m_regions.clear();
+	for (size_t begin = 0; begin < m_enabledTransitions.size();)
+	{
+		const size_t group = m_conflictGroups.getGroup(m_enabledTransitions[begin]);
+		size_t end = begin + 1;
+		while (end < m_enabledTransitions.size() && m_conflictGroups.getGroup(m_enabledTransitions[end]) == group)
+		{
+			++end;
+		}
+		m_regions.emplace_back(begin, end);
+		begin = end;
+	}
+
+	if (m_regionResults.size() < m_regions.size())
+	{
+		m_regionResults.resize(m_regions.size());
+	}
+	for (size_t region = 0; region < m_regions.size(); ++region)
+	{
+		auto &regionResult = m_regionResults[region];
+		regionResult.pendingActions.clear();
+		regionResult.stepFirings.clear();
+		regionResult.fired = false;
+	}
+
+	if (m_regions.size() == 1)
+	{
+		fireRegion(0, multiFiring, maximalStep);
+	}
+	else
+	{
+		m_firingPool->run(m_regions.size(), [this, multiFiring, maximalStep](const size_t region)
+						  { fireRegion(region, multiFiring, maximalStep); });
+	}
+
+	bool firedAtLeastOneTransition = false;
+	for (size_t region = 0; region < m_regions.size(); ++region)
+	{
+		dispatchActions(m_regionResults[region].pendingActions);
+		firedAtLeastOneTransition = firedAtLeastOneTransition || m_regionResults[region].fired;
+	}
+
+	if (maximalStep)
+	{
+		for (size_t region = 0; region < m_regions.size(); ++region)
+		{
+			for (const auto &[transition, firings] : m_regionResults[region].stepFirings)
+			{
+				produce(transition, firings);
+			}
+		}
+	}
+	return firedAtLeastOneTransition;
+}
+
+void FrozenNet::fireRegion(const size_t region, const bool multiFiring, const bool maximalStep)
+{
+	auto &regionResult = m_regionResults[region];
+	const auto [begin, end] = m_regions[region];
+	for (size_t i = begin; i < end; ++i)
+	{
+		// No other region consumes from the activation places of this one, their tokens can only grow while the
+		// transition is fired, so checking and consuming them needs no locking.
+		const size_t transition = m_enabledTransitions[i];
+		const bool keepsKernelMarking = maximalStep && !m_conflictGroups.hasConflicts(transition);
+		if (!(keepsKernelMarking || isEnabled(transition)) || !checkGuards(transition))
+		{
+			continue;
+		}
+
+		const size_t firings = multiFiring ? enablingDegree(transition) : 1;
+		consume(transition, firings, &regionResult.pendingActions);
+		if (maximalStep)
+		{
+			regionResult.stepFirings.emplace_back(transition, firings);
+		}
+		else
+		{
+			produce(transition, firings, &regionResult.pendingActions);
+		}
+		regionResult.fired = true;
+	}
+}
+
+void FrozenNet::dispatchActions(const vector<PendingAction> &pendingActions) const
+{
+	for (const auto &[place, tokens, multiplicity, onEnter] : pendingActions)
+	{
+		if (onEnter)
+		{
+			m_places[place]->executeOnEnterAction(tokens, multiplicity);
+		}
+		else
+		{
+			m_places[place]->executeOnExitAction(tokens, multiplicity);
+		}
+	}
+}
+
+void FrozenNet::consume(const size_t transition, const size_t firings, vector<PendingAction> *pendingActions)
+{
+	for (size_t arc = m_destinationArcs.offsets[transition]; arc < m_destinationArcs.offsets[transition + 1];
+		 ++arc)
+	{
+		if (m_destinationArcs.weights[arc] > ULLONG_MAX / firings)
+		{
+			throw OverflowException(m_destinationArcs.weights[arc]);
+		}
+	}
+
+	for (size_t arc = m_activationArcs.offsets[transition]; arc < m_activationArcs.offsets[transition + 1];
+		 ++arc)
+	{
+		exitPlace(m_activationArcs.places[arc], m_activationArcs.weights[arc] * firings, firings, pendingActions);
+	}
+}
+
+void FrozenNet::produce(const size_t transition, const size_t firings, vector<PendingAction> *pendingActions)
+{
+	for (size_t arc = m_destinationArcs.offsets[transition]; arc < m_destinationArcs.offsets[transition + 1];
+		 ++arc)
+	{
+		enterPlace(m_destinationArcs.places[arc], m_destinationArcs.weights[arc] * firings, firings,
+				   pendingActions);
+	}
+}
+
+void FrozenNet::enterPlace(const size_t place,
+						   const size_t tokens,
+						   const size_t multiplicity,
+						   vector<PendingAction> *pendingActions)
+{
+	atomic_ref placeTokens(m_tokens[place]);
+	size_t currentTokens = placeTokens.load(memory_order_relaxed);
+	do
+	{
+		if (tokens > ULLONG_MAX - currentTokens)
+		{
+			throw OverflowException(tokens);
+		}
+	} while (!placeTokens.compare_exchange_weak(currentTokens, currentTokens + tokens, memory_order_relaxed));
+
+	if (!m_hasOnEnterAction[place])
+	{
+		return;
+	}
+	if (pendingActions)
+	{
+		pendingActions->push_back({ place, tokens, multiplicity, true });
+	}
+	else
+	{
+		m_places[place]->executeOnEnterAction(tokens, multiplicity);
+	}
+}
+
+void FrozenNet::exitPlace(const size_t place,
+						  const size_t tokens,
+						  const size_t multiplicity,
+						  vector<PendingAction> *pendingActions)
+{
+	// Only the region owning the place removes tokens, other regions can only add them concurrently.
+	atomic_ref placeTokens(m_tokens[place]);
+	if (placeTokens.load(memory_order_relaxed) < tokens)
+	{
+		throw NotEnoughTokensException();
+	}
+	placeTokens.fetch_sub(tokens, memory_order_relaxed);
+
+	if (!m_hasOnExitAction[place])
+	{
+		return;
+	}
+	if (pendingActions)
+	{
+		pendingActions->push_back({ place, tokens, multiplicity, false });
+	}
+	else
+	{
+		m_places[place]->executeOnExitAction(tokens, multiplicity);
+	}
+}
+
+size_t FrozenNet::loadTokens(const size_t place) const
+{
+	// The token vector itself is not const, only this view of it.
+	return atomic_ref(const_cast<size_t &>(m_tokens[place])).load(memory_order_relaxed);
+}
+
+size_t FrozenNet::getPlaceIndex(const string &place) const
+{
+	const auto it = m_placeIndices.find(place);
+	if (it == m_placeIndices.end())
+	{
+		throw InvalidNameException(place);
+	}
+	return it->second;
+}
+
+} // namespace ptne
@@ -0,0 +1,387 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/ConflictResolution/ConflictGroups.h"
+#include "PTN_Engine/ConflictResolution/IConflictResolver.h"
+#include "PTN_Engine/EnablingKernel.h"
+#include "PTN_Engine/JobQueue/WorkStealingPool.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ptne
+{
+
+class Place;
+class Transition;
+
+//!
+//! \brief Compressed sparse row representation of the arcs of one type.
+//!
+struct IncidenceMatrix
+{
+	//! Position of the first arc of each transition, followed by the total number of arcs.
+	std::vector<size_t> offsets;
+
+	//! Index of the place of each arc.
+	std::vector<size_t> places;
+
+	//! Weight of each arc.
+	std::vector<size_t> weights;
+};
+
+//!
+//! \brief Flat, integer indexed representation of a Petri net whose structure no longer changes.
+//!
+//! The marking is kept in a dense token vector and the arcs in CSR matrices, so enabling checks and firing
+//! run over contiguous memory, without locking weak pointers or per place mutexes. The places and transitions
+//! are still referenced to dispatch their actions and evaluate their additional conditions.
+//!
+//! With more than one firing thread, the conflict groups are fired in parallel as independent regions. Only
+//! the transitions of a region consume tokens from its activation places, so checking and consuming them
+//! needs no locking, while the tokens deposited in the places of other regions are added atomically.
+//!
+class FrozenNet final
+{
+public:
+	~FrozenNet();
+
+	//!
+	//! \brief Compile the net formed by the given places and transitions.
+	//! \param places - all places of the net. The position of each place is its index.
+	//! \param transitions - all transitions of the net, in the order they were created.
+	//! \param conflictResolver - decides the order of enabled transitions competing for the same tokens.
+	//!
+	FrozenNet(const std::vector<std::shared_ptr<Place>> &places,
+			  const std::vector<std::shared_ptr<Transition>> &transitions,
+			  IConflictResolver &conflictResolver);
+
+	FrozenNet(const FrozenNet &) = delete;
+	FrozenNet(FrozenNet &&) = delete;
+	FrozenNet &operator=(const FrozenNet &) = delete;
+	FrozenNet &operator=(FrozenNet &&) = delete;
+
+	//!
+	//! \brief Sets the number of tokens in the input places to 0.
+	//!
+	void clearInputPlaces();
+
+	//!
+	//! \brief Fire all enabled transitions once, ordering those competing for the same tokens with the conflict
+	//! resolver.
+	//! The enabled transitions are found by the enabling kernel, the additional conditions are only
+	//! evaluated for those.
+	//! \param multiFiring - fire each transition as many times as its activation places allow.
+	//! \param maximalStep - fire all transitions as one step, producing tokens only after all consumed theirs.
+	//! \return True if at least one transition was fired.
+	//!
+	bool execute(const bool multiFiring = false, const bool maximalStep = false);
+
+	//!
+	//! \brief Number of threads firing the regions of the net.
+	//! \return 1 if the net is fired sequentially.
+	//!
+	size_t getNumberOfFiringThreads() const;
+
+	//!
+	//! \brief Gets the number of tokens in a given place.
+	//! \param place - identifier of a place.
+	//! \return Number of tokens inside place.
+	//!
+	size_t getNumberOfTokens(const std::string &place) const;
+
+	//!
+	//! \brief Gets the number of tokens in a given place.
+	//! \param place - index of the place, its position in the places the net was compiled from.
+	//! \return Number of tokens inside place.
+	//!
+	size_t getNumberOfTokens(const size_t place) const;
+
+	//!
+	//! \brief Describe all places, with the tokens of the frozen marking.
+	//! \return The properties of all places.
+	//!
+	std::vector<PlaceProperties> getPlacesProperties() const;
+
+	//!
+	//! \brief Increment the number of tokens in an input place.
+	//! \param place - Identifier of the input place to increment.
+	//! \param count - number of tokens to add.
+	//!
+	void incrementInputPlace(const std::string &place, const size_t count = 1);
+
+	//!
+	//! \brief Increment the number of tokens in an input place.
+	//! \param place - index of the input place, its position in the places the net was compiled from.
+	//! \param count - number of tokens to add.
+	//!
+	void incrementInputPlace(const size_t place, const size_t count = 1);
+
+	//!
+	//! \brief Increment the number of tokens in several input places, as one change of the marking. All
+	//! increments are validated before any place is changed.
+	//! \param increments - pairs of place handle and number of tokens to add.
+	//!
+	void incrementInputPlaces(std::span<const std::pair<PlaceHandle, size_t>> increments);
+
+	//!
+	//! \brief Set the number of threads firing the regions of the net.
+	//! \param numberOfFiringThreads - 1 to fire sequentially in the calling thread, more to fire independent
+	//! regions in parallel.
+	//!
+	void setNumberOfFiringThreads(const size_t numberOfFiringThreads);
+
+	//!
+	//! Print the petri net places and number of tokens.
+	//! \param o Output stream.
+	//!
+	void printState(std::ostream &o) const;
+
+	//!
+	//! \brief Store the frozen marking back in the places.
+	//!
+	void thaw() const;
+
+private:
+	//!
+	//! \brief Action of a place reached while firing a region, dispatched once all regions finished.
+	//!
+	struct PendingAction
+	{
+		//! Index of the place.
+		size_t place;
+
+		//! Number of tokens that entered or left the place, passed to a batch action.
+		size_t tokens;
+
+		//! Number of times the action is dispatched, unless it is a batch action.
+		size_t multiplicity;
+
+		//! True for the on enter action, false for the on exit action.
+		bool onEnter;
+	};
+
+	//!
+	//! \brief What happened while firing a region in parallel.
+	//!
+	struct RegionResult
+	{
+		//! Actions to dispatch, in the order the tokens moved.
+		std::vector<PendingAction> pendingActions;
+
+		//! Transitions fired and how many times. Only used for maximal steps.
+		std::vector<std::pair<size_t, size_t>> stepFirings;
+
+		//! Whether at least one transition was fired.
+		bool fired = false;
+	};
+
+	//!
+	//! \brief Checks the tokens of the activation and inhibitor places of a transition.
+	//! \param transition - index of the transition.
+	//! \return True if the transition is enabled.
+	//!
+	bool isEnabled(const size_t transition) const;
+
+	//!
+	//! \brief Checks the additional conditions and the actions in execution of a transition.
+	//! \param transition - index of the transition.
+	//! \return True if all conditions allow firing the transition.
+	//!
+	bool checkGuards(const size_t transition) const;
+
+	//!
+	//! \brief Number of times a transition can fire with the tokens in its activation places.
+	//! \param transition - index of the transition.
+	//! \return The minimum, over all activation arcs, of the tokens divided by the weight. 1 if there are no
+	//! activation arcs.
+	//!
+	size_t enablingDegree(const size_t transition) const;
+
+	//!
+	//! \brief Fire a maximal set of the enabled transitions as one step. The enabled transitions must already
+	//! be collected and ordered.
+	//! \param multiFiring - fire each transition as many times as its activation places allow.
+	//! \return True if at least one transition was fired.
+	//!
+	bool executeStep(const bool multiFiring);
+
+	//!
+	//! \brief Fire the enabled transitions of each region in parallel. The enabled transitions must already be
+	//! collected and ordered.
+	//! \param multiFiring - fire each transition as many times as its activation places allow.
+	//! \param maximalStep - fire all transitions as one step, producing tokens only after all consumed theirs.
+	//! \return True if at least one transition was fired.
+	//!
+	bool executeRegions(const bool multiFiring, const bool maximalStep);
+
+	//!
+	//! \brief Fire the enabled transitions of one region.
+	//! \param region - index of the region in m_regions.
+	//! \param multiFiring - fire each transition as many times as its activation places allow.
+	//! \param maximalStep - only consume the tokens, storing the firings to produce them later.
+	//!
+	void fireRegion(const size_t region, const bool multiFiring, const bool maximalStep);
+
+	//!
+	//! \brief Dispatch the actions postponed while firing in parallel.
+	//! \param pendingActions - the actions, in the order they are dispatched.
+	//!
+	void dispatchActions(const std::vector<PendingAction> &pendingActions) const;
+
+	//!
+	//! \brief Removes the tokens from the activation places of a transition and dispatches their actions.
+	//! \param transition - index of the transition.
+	//! \param firings - number of times the transition is fired.
+	//! \param pendingActions - if not null, the actions are stored there instead of dispatched.
+	//!
+	void consume(const size_t transition,
+				 const size_t firings,
+				 std::vector<PendingAction> *pendingActions = nullptr);
+
+	//!
+	//! \brief Adds the tokens to the destination places of a transition and dispatches their actions.
+	//! \param transition - index of the transition.
+	//! \param firings - number of times the transition is fired.
+	//! \param pendingActions - if not null, the actions are stored there instead of dispatched.
+	//!
+	void produce(const size_t transition,
+				 const size_t firings,
+				 std::vector<PendingAction> *pendingActions = nullptr);
+
+	//!
+	//! \brief Add tokens to a place and dispatch its on enter action.
+	//! \param place - index of the place.
+	//! \param tokens - number of tokens to add.
+	//! \param multiplicity - number of times the on enter action is dispatched.
+	//! \param pendingActions - if not null, the action is stored there instead of dispatched.
+	//!
+	void enterPlace(const size_t place,
+					const size_t tokens,
+					const size_t multiplicity = 1,
+					std::vector<PendingAction> *pendingActions = nullptr);
+
+	//!
+	//! \brief Remove tokens from a place and dispatch its on exit action.
+	//! \param place - index of the place.
+	//! \param tokens - number of tokens to remove.
+	//! \param multiplicity - number of times the on exit action is dispatched.
+	//! \param pendingActions - if not null, the action is stored there instead of dispatched.
+	//!
+	void exitPlace(const size_t place,
+				   const size_t tokens,
+				   const size_t multiplicity,
+				   std::vector<PendingAction> *pendingActions = nullptr);
+
+	//!
+	//! \brief Read the tokens of a place, which other regions may be adding to.
+	//! \param place - index of the place.
+	//! \return The number of tokens.
+	//!
+	size_t loadTokens(const size_t place) const;
+
+	//!
+	//! \brief Get the index of a place.
+	//! \throws InvalidNameException
+	//! \param place - name of the place.
+	//! \return The index of the place.
+	//!
+	size_t getPlaceIndex(const std::string &place) const;
+
+	//! Synchronizes the marking. Recursive, so that actions and conditions run while firing may query the net.
+	mutable std::recursive_mutex m_mutex;
+
+	//! Places of the net, used to dispatch actions.
+	std::vector<std::shared_ptr<Place>> m_places;
+
+	//! Index of each place, by name.
+	std::unordered_map<std::string, size_t> m_placeIndices;
+
+	//! Number of tokens in each place, followed by a sentinel place that never has tokens. Changed atomically,
+	//! since regions fired in parallel deposit tokens in each other's places.
+	std::vector<size_t> m_tokens;
+
+	//! Tokens added to each place by the batch being validated. Reused between batches.
+	std::vector<size_t> m_batchTokens;
+
+	//! Whether each place is an input place.
+	std::vector<bool> m_isInputPlace;
+
+	//! Whether each place has an on enter action.
+	std::vector<bool> m_hasOnEnterAction;
+
+	//! Whether each place has an on exit action.
+	std::vector<bool> m_hasOnExitAction;
+
+	//! Transitions of the net.
+	std::vector<std::shared_ptr<Transition>> m_transitions;
+
+	//! Activation arcs (pre-conditions).
+	IncidenceMatrix m_activationArcs;
+
+	//! Destination arcs (post-conditions).
+	IncidenceMatrix m_destinationArcs;
+
+	//! Inhibitor arcs. The weights are not used.
+	IncidenceMatrix m_inhibitorArcs;
+
+	//! Position of the first additional condition of each transition, followed by the total.
+	std::vector<size_t> m_conditionsOffsets;
+
+	//! Additional conditions of all transitions.
+	std::vector<std::pair<std::string, ConditionFunction>> m_conditions;
+
+	//! Whether each transition requires no on enter actions in execution in its activation places.
+	std::vector<bool> m_requireNoActionsInExecution;
+
+	//! Computes the transitions with enough tokens to fire.
+	std::unique_ptr<EnablingKernel> m_enablingKernel;
+
+	//! One bit per transition, set by the enabling kernel. Reused between cycles.
+	std::vector<uint64_t> m_enabledMask;
+
+	//! Transitions found enabled in the current cycle. Reused between cycles.
+	std::vector<size_t> m_enabledTransitions;
+
+	//! Transitions fired in the current step and how many times. Reused between steps.
+	std::vector<std::pair<size_t, size_t>> m_stepFirings;
+
+	//! Transitions that can compete for the same tokens.
+	ConflictGroups m_conflictGroups;
+
+	//! Decides the order of enabled transitions competing for the same tokens.
+	IConflictResolver &m_conflictResolver;
+
+	//! Fires the regions in parallel. Null if the net is fired sequentially.
+	std::unique_ptr<WorkStealingPool> m_firingPool;
+
+	//! Begin and end positions in m_enabledTransitions of the transitions of each region. Reused between cycles.
+	std::vector<std::pair<size_t, size_t>> m_regions;
+
+	//! Result of firing each region. Reused between cycles.
+	std::vector<RegionResult> m_regionResults;
+};
+
+} // namespace ptne
@@ -0,0 +1,42 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/IActionsExecutor.h"
+#include "PTN_Engine/JobQueue/CoroutineRunner.h"
+
+namespace ptne
+{
+
+using namespace std;
+
+void IActionsExecutor::executeAsyncAction(const AsyncActionFunction &action,
+										  atomic<size_t> &counter,
+										  const shared_ptr<const ActionCompletedNotifier> &notifier)
+{
+	executeAction(
+	[&action]
+	{
+		CoroutineRunner coroutineRunner;
+		coroutineRunner.start(action(), nullptr, nullptr);
+		coroutineRunner.runUntilIdle();
+	},
+	counter, notifier);
+}
+
+} // namespace ptne
@@ -35,8 +35,6 @@ public:
 	virtual bool executeInt(const bool log = false, std::ostream &o = std::cout) = 0;
 
 	virtual PTN_Engine::ACTIONS_THREAD_OPTION getActionsThreadOption() const = 0;
-
-	virtual bool getNewInputReceived() const = 0;
 };
 
 } // namespace ptne
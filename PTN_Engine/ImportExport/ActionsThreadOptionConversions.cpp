@@ -27,6 +27,10 @@ const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_SINGLE_THREAD
 const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_EVENT_LOOP = "EVENT_LOOP";
 const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_DETACHED = "DETACHED";
 const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_JOB_QUEUE = "JOB_QUEUE";
+const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_THREAD_POOL = "THREAD_POOL";
+const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_CUSTOM = "CUSTOM";
+const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_COROUTINE = "COROUTINE";
+const string ActionsThreadOptionConversions::ACTIONS_THREAD_OPTION_ADAPTIVE = "ADAPTIVE";
 
 PTN_Engine::ACTIONS_THREAD_OPTION
 ActionsThreadOptionConversions::toACTIONS_THREAD_OPTION(const string &actionsThreadOptionStr)
@@ -48,6 +52,22 @@ ActionsThreadOptionConversions::toACTIONS_THREAD_OPTION(const string &actionsThr
 	{
 		return JOB_QUEUE;
 	}
+	else if (actionsThreadOptionStr == ACTIONS_THREAD_OPTION_THREAD_POOL)
+	{
+		return THREAD_POOL;
+	}
+	else if (actionsThreadOptionStr == ACTIONS_THREAD_OPTION_CUSTOM)
+	{
+		return CUSTOM;
+	}
+	else if (actionsThreadOptionStr == ACTIONS_THREAD_OPTION_COROUTINE)
+	{
+		return COROUTINE;
+	}
+	else if (actionsThreadOptionStr == ACTIONS_THREAD_OPTION_ADAPTIVE)
+	{
+		return ADAPTIVE;
+	}
 	else
 	{
 		throw PTN_Exception("Could not convert " + actionsThreadOptionStr + " to ACTIONS_THREAD_OPTION");
@@ -79,6 +99,22 @@ string ActionsThreadOptionConversions::toString(PTN_Engine::ACTIONS_THREAD_OPTIO
 	{
 		return ACTIONS_THREAD_OPTION_JOB_QUEUE;
 	}
+	case THREAD_POOL:
+	{
+		return ACTIONS_THREAD_OPTION_THREAD_POOL;
+	}
+	case CUSTOM:
+	{
+		return ACTIONS_THREAD_OPTION_CUSTOM;
+	}
+	case COROUTINE:
+	{
+		return ACTIONS_THREAD_OPTION_COROUTINE;
+	}
+	case ADAPTIVE:
+	{
+		return ACTIONS_THREAD_OPTION_ADAPTIVE;
+	}
 	}
 }
 
@@ -31,6 +31,10 @@ private:
 	static const std::string ACTIONS_THREAD_OPTION_EVENT_LOOP;
 	static const std::string ACTIONS_THREAD_OPTION_DETACHED;
 	static const std::string ACTIONS_THREAD_OPTION_JOB_QUEUE;
+	static const std::string ACTIONS_THREAD_OPTION_THREAD_POOL;
+	static const std::string ACTIONS_THREAD_OPTION_CUSTOM;
+	static const std::string ACTIONS_THREAD_OPTION_COROUTINE;
+	static const std::string ACTIONS_THREAD_OPTION_ADAPTIVE;
 };
 
 } // namespace ptne
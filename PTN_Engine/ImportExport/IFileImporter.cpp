@@ -33,9 +33,14 @@ void IFileImporter::_importInt(PTN_Engine &ptnEngine) const
 		ptnEngine.stop();
 	}
 
-	string actionsThreadOptionStr = importActionsThreadOption();
-	ptnEngine.setActionsThreadOption(
-	std::move(ActionsThreadOptionConversions::toACTIONS_THREAD_OPTION(actionsThreadOptionStr)));
+	// The executor of a CUSTOM engine is not part of the file, the target engine keeps its own.
+	using enum PTN_Engine::ACTIONS_THREAD_OPTION;
+	if (const auto actionsThreadOption =
+		ActionsThreadOptionConversions::toACTIONS_THREAD_OPTION(importActionsThreadOption());
+		actionsThreadOption != CUSTOM)
+	{
+		ptnEngine.setActionsThreadOption(actionsThreadOption);
+	}
 
 	for (const auto &placeProperties : importPlaces())
 	{
@@ -55,6 +55,14 @@ void XML_FileExporter::exportPlace(const PlaceProperties &placeProperties)
 	placeNode.append_attribute("input").set_value(placeProperties.input ? true : false);
 	placeNode.append_attribute("onEnterAction").set_value(placeProperties.onEnterActionFunctionName.c_str());
 	placeNode.append_attribute("onExitAction").set_value(placeProperties.onExitActionFunctionName.c_str());
+	if (!placeProperties.executorLane.empty())
+	{
+		placeNode.append_attribute("executorLane").set_value(placeProperties.executorLane.c_str());
+	}
+	if (placeProperties.coalesceActions)
+	{
+		placeNode.append_attribute("coalesceActions").set_value(true);
+	}
 }
 
 void XML_FileExporter::exportTransition(const TransitionProperties &transitionProperties)
@@ -75,6 +83,9 @@ void XML_FileExporter::exportTransition(const TransitionProperties &transitionPr
 	requireNoActionsInExecution.append_attribute("value").set_value(
 	transitionProperties.requireNoActionsInExecution ? "true" : "false");
 
+	xml_node priority = transitionNode.append_child("Priority");
+	priority.append_attribute("value").set_value(to_string(transitionProperties.priority).c_str());
+
 	auto exportArcs = [this](const vector<ArcProperties> &arcsProperties, const string &typeStr)
 	{
 		for (const auto &arcProperties : arcsProperties)
@@ -146,6 +146,8 @@ vector<PlaceProperties> XML_FileImporter::importPlaces() const
 		placeProperties.onEnterActionFunctionName = getAttributeValue(place, "onEnterAction");
 		placeProperties.onExitActionFunctionName = getAttributeValue(place, "onExitAction");
 		placeProperties.input = isInput;
+		placeProperties.executorLane = getAttributeValue(place, "executorLane");
+		placeProperties.coalesceActions = getAttributeValue(place, "coalesceActions") == "true";
 
 		placesInfoCollection.emplace_back(placeProperties);
 	}
@@ -168,6 +170,10 @@ vector<TransitionProperties> XML_FileImporter::importTransitions() const
 		transitionProperties.additionalConditionsNames = activationConditions;
 		transitionProperties.requireNoActionsInExecution =
 		getNodeValue<bool>("RequireNoActionsInExecution", transition);
+		if (transition.child("Priority"))
+		{
+			transitionProperties.priority = getNodeValue<size_t>("Priority", transition);
+		}
 		transitionInfoCollection.emplace_back(transitionProperties);
 	}
 	return transitionInfoCollection;
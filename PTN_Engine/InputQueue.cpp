@@ -0,0 +1,67 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/InputQueue.h"
+#include "PTN_Engine/PTN_Exception.h"
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+size_t checkCapacity(const size_t capacity)
+{
+	if (capacity == 0)
+	{
+		throw PTN_Exception("The capacity of the input queue must be at least 1.");
+	}
+	return capacity;
+}
+
+} // namespace
+
+InputQueue::InputQueue(const size_t capacity)
+: m_ring(checkCapacity(capacity))
+{
+}
+
+InputQueue::~InputQueue() = default;
+
+size_t InputQueue::getCapacity() const
+{
+	return m_ring.capacity();
+}
+
+bool InputQueue::push(const Input &input)
+{
+	return m_ring.push(input);
+}
+
+bool InputQueue::pop(Input &input)
+{
+	return m_ring.popSingleConsumer(input);
+}
+
+bool InputQueue::empty() const
+{
+	return m_ring.empty();
+}
+
+} // namespace ptne
@@ -0,0 +1,90 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/Utilities/SequenceRing.h"
+#include <cstddef>
+
+namespace ptne
+{
+
+//!
+//! \brief Bounded lock-free queue of input place increments, written by many producer threads and read by
+//! the thread executing the net, its only consumer.
+//!
+class InputQueue final
+{
+public:
+	//!
+	//! \brief Tokens to be added to an input place.
+	//!
+	struct Input
+	{
+		//! Index of the input place.
+		size_t place = 0;
+
+		//! Number of tokens.
+		size_t count = 0;
+	};
+
+	~InputQueue();
+
+	//!
+	//! \brief InputQueue constructor.
+	//! \param capacity - maximum number of pending inputs, rounded up to a power of 2 of at least 2. At least 1.
+	//!
+	explicit InputQueue(const size_t capacity);
+
+	InputQueue(const InputQueue &) = delete;
+	InputQueue(InputQueue &&) = delete;
+	InputQueue &operator=(const InputQueue &) = delete;
+	InputQueue &operator=(InputQueue &&) = delete;
+
+	//!
+	//! \brief Maximum number of pending inputs.
+	//! \return The capacity of the queue.
+	//!
+	size_t getCapacity() const;
+
+	//!
+	//! \brief Add an input to the queue. Can be called from any thread.
+	//! \param input - the input to add.
+	//! \return False if the queue is full, in which case the input is not added.
+	//!
+	bool push(const Input &input);
+
+	//!
+	//! \brief Take the oldest input from the queue. Must only be called by the consumer thread.
+	//! \param input - receives the input taken.
+	//! \return False if the queue is empty.
+	//!
+	bool pop(Input &input);
+
+	//!
+	//! \brief Tells if there are no inputs ready to be taken. Must only be called by the consumer thread.
+	//! \return True if the queue is empty.
+	//!
+	bool empty() const;
+
+private:
+	//! Ring of the pending inputs.
+	utility::SequenceRing<Input> m_ring;
+};
+
+} // namespace ptne
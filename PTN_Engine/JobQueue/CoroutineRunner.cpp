@@ -0,0 +1,134 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/JobQueue/CoroutineRunner.h"
+
+namespace ptne
+{
+
+using namespace std;
+
+CoroutineRunner::~CoroutineRunner() = default;
+
+CoroutineRunner::CoroutineRunner() = default;
+
+void CoroutineRunner::resume(coroutine_handle<> coroutine)
+{
+	post([coroutine] { coroutine.resume(); });
+}
+
+void CoroutineRunner::resumeAt(const chrono::steady_clock::time_point timePoint, coroutine_handle<> coroutine)
+{
+	{
+		lock_guard guard(m_mutex);
+		m_timers.push(Timer{ .timePoint = timePoint, .coroutine = coroutine });
+	}
+	m_jobAdded.notify_one();
+}
+
+void CoroutineRunner::post(Job job)
+{
+	{
+		lock_guard guard(m_mutex);
+		m_jobs.push_back(move(job));
+	}
+	m_jobAdded.notify_one();
+}
+
+void CoroutineRunner::start(ActionTask task,
+							atomic<size_t> *actionsInExecution,
+							shared_ptr<const ActionCompletedNotifier> notifier)
+{
+	++m_actionsInFlight;
+	auto onCompleted = [this, actionsInExecution, notifier = move(notifier)]
+	{
+		--m_actionsInFlight;
+		if (actionsInExecution != nullptr)
+		{
+			--*actionsInExecution;
+			actionsInExecution->notify_all();
+		}
+		if (notifier && *notifier)
+		{
+			(*notifier)();
+		}
+	};
+	static_assert(ActionTaskCompletion::isStoredInPlace<decltype(onCompleted)>());
+	task.start(*this, move(onCompleted));
+}
+
+void CoroutineRunner::run(stop_token stopToken)
+{
+	run(move(stopToken), false);
+}
+
+void CoroutineRunner::runUntilIdle()
+{
+	run(stop_token(), true);
+}
+
+void CoroutineRunner::run(stop_token stopToken, const bool untilIdle)
+{
+	unique_lock guard(m_mutex);
+	while (true)
+	{
+		queueExpiredTimers(Clock::now());
+		if (!m_jobs.empty())
+		{
+			Job job = move(m_jobs.front());
+			m_jobs.pop_front();
+			guard.unlock();
+			job();
+			job = nullptr;
+			guard.lock();
+			continue;
+		}
+
+		const bool stopping = untilIdle || stopToken.stop_requested();
+		if (stopping && m_timers.empty() && m_actionsInFlight == 0)
+		{
+			return;
+		}
+
+		// Woken up by new jobs and new timers, which may be earlier than the one waited for. Once stopping, the
+		// actions still in flight are waited for without being woken up by the stop request.
+		const auto hasWork = [this, timers = m_timers.size()] { return !m_jobs.empty() || m_timers.size() != timers; };
+		const stop_token waitStopToken = stopping ? stop_token() : stopToken;
+		if (m_timers.empty())
+		{
+			m_jobAdded.wait(guard, waitStopToken, hasWork);
+		}
+		else
+		{
+			m_jobAdded.wait_until(guard, waitStopToken, m_timers.top().timePoint, hasWork);
+		}
+	}
+}
+
+void CoroutineRunner::queueExpiredTimers(const Clock::time_point now)
+{
+	while (!m_timers.empty() && m_timers.top().timePoint <= now)
+	{
+		const coroutine_handle<> coroutine = m_timers.top().coroutine;
+		m_timers.pop();
+		m_jobs.push_back([coroutine] { coroutine.resume(); });
+	}
+}
+
+} // namespace ptne
@@ -0,0 +1,132 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "PTN_Engine/ActionTask.h"
+#include "PTN_Engine/IActionsExecutor.h"
+#include "PTN_Engine/JobQueue/Job.h"
+#include "PTN_Engine/Utilities/RingDeque.h"
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <mutex>
+#include <queue>
+#include <stop_token>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Runs jobs and coroutine actions in the thread calling run, resuming the suspended actions once
+//! their timers expire or their callbacks resume them.
+//!
+//! A single thread keeps any number of actions in flight, as suspended actions hold no thread.
+//!
+class CoroutineRunner final : public IActionTaskScheduler
+{
+public:
+	~CoroutineRunner() override;
+	CoroutineRunner();
+	CoroutineRunner(const CoroutineRunner &) = delete;
+	CoroutineRunner(CoroutineRunner &&) = delete;
+	CoroutineRunner &operator=(const CoroutineRunner &) = delete;
+	CoroutineRunner &operator=(CoroutineRunner &&) = delete;
+
+	void resume(std::coroutine_handle<> coroutine) override;
+
+	void resumeAt(std::chrono::steady_clock::time_point timePoint, std::coroutine_handle<> coroutine) override;
+
+	//!
+	//! \brief Add a job, executed by the thread calling run. Can be called from any thread.
+	//! \param job - the job to add.
+	//!
+	void post(Job job);
+
+	//!
+	//! \brief Start a coroutine action. Must be called by the thread calling run.
+	//! \param task - the action.
+	//! \param actionsInExecution - decremented once the action completed. May be null.
+	//! \param notifier - called once the action completed. May be null.
+	//!
+	void start(ActionTask task,
+			   std::atomic<size_t> *actionsInExecution,
+			   std::shared_ptr<const ActionCompletedNotifier> notifier);
+
+	//!
+	//! \brief Execute the jobs and resume the actions until a stop is requested and no jobs, timers or actions
+	//! are left.
+	//! \param stopToken - requests the runner to stop once idle.
+	//!
+	void run(std::stop_token stopToken);
+
+	//!
+	//! \brief Execute the jobs and resume the actions until no jobs, timers or actions are left.
+	//!
+	void runUntilIdle();
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	//!
+	//! \brief Suspended coroutine waiting for its time point.
+	//!
+	struct Timer final
+	{
+		Clock::time_point timePoint;
+		std::coroutine_handle<> coroutine;
+
+		bool operator>(const Timer &other) const
+		{
+			return timePoint > other.timePoint;
+		}
+	};
+
+	//!
+	//! \brief Execute the jobs and resume the actions until idle and, unless untilIdle is set, a stop is
+	//! requested.
+	//! \param stopToken - requests the runner to stop once idle.
+	//! \param untilIdle - return as soon as idle.
+	//!
+	void run(std::stop_token stopToken, const bool untilIdle);
+
+	//!
+	//! \brief Move the coroutines whose time point was reached to the jobs. Must be called with m_mutex locked.
+	//! \param now - the current time.
+	//!
+	void queueExpiredTimers(const Clock::time_point now);
+
+	//! Protects the jobs and the timers.
+	std::mutex m_mutex;
+
+	//! Wakes up the thread calling run when jobs are added.
+	std::condition_variable_any m_jobAdded;
+
+	//! Jobs to execute, including the coroutines to resume.
+	utility::RingDeque<Job> m_jobs;
+
+	//! Suspended coroutines waiting for their time point, the earliest on top.
+	std::priority_queue<Timer, std::vector<Timer>, std::greater<>> m_timers;
+
+	//! Number of actions started and not completed yet. Only accessed by the thread calling run.
+	size_t m_actionsInFlight = 0;
+};
+
+} // namespace ptne
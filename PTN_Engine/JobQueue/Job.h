@@ -0,0 +1,33 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/Utilities/InPlaceFunction.h"
+
+namespace ptne
+{
+
+//!
+//! \brief Job executed by job queues and thread pools. Holds an action handed over to an executor together
+//! with the counter and notifier the executor needs to account for it, one cache line in total, without
+//! allocating.
+//!
+using Job = utility::InPlaceFunction<void(), 48>;
+
+} // namespace ptne
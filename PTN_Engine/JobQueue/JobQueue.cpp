@@ -17,19 +17,36 @@
  */
 
 #include "PTN_Engine/JobQueue/JobQueue.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include "PTN_Engine/Utilities/ThreadScheduling.h"
 #include <thread>
 
 namespace ptne
 {
 using namespace std;
 
+namespace
+{
+
+//! Number of times the worker yields, waiting for new jobs, before parking.
+constexpr size_t spinIterations = 16;
+
+} // namespace
+
 JobQueue::JobQueue() = default;
 
-//! The thread destructor will request to stop and then join, by default.
+JobQueue::JobQueue(const size_t capacity, const PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY overflowPolicy)
+: m_jobRing(make_unique<JobRing>(capacity))
+, m_overflowPolicy(overflowPolicy)
+{
+}
+
+//! The thread destructor requests the worker to stop, which executes the queued jobs, and then joins it.
 JobQueue::~JobQueue() = default;
 
 void JobQueue::activate()
 {
+	lock_guard l(m_jobQueueMutex);
 	if (m_isJobQueueActive)
 	{
 		return;
@@ -40,16 +57,23 @@ void JobQueue::activate()
 
 void JobQueue::deactivate() noexcept
 {
-	if (!m_isJobQueueActive)
+	jthread workerThread;
 	{
-		return;
+		lock_guard l(m_jobQueueMutex);
+		if (!m_isJobQueueActive)
+		{
+			return;
+		}
+		m_isJobQueueActive = false;
+		m_isWorkerLaunched = false;
+		workerThread = move(m_workerThread);
 	}
-	if (m_workerThread.get_stop_token().stop_possible())
+	// Joined outside the lock, so that the worker can finish the queued jobs.
+	if (workerThread.joinable())
 	{
-		m_workerThread.request_stop();
-		m_workerThread.join();
+		workerThread.request_stop();
+		workerThread.join();
 	}
-	m_isJobQueueActive = false;
 }
 
 bool JobQueue::isActive() const
@@ -57,44 +81,223 @@ bool JobQueue::isActive() const
 	return m_isJobQueueActive;
 }
 
-void JobQueue::launch()
+size_t JobQueue::getCapacity() const
+{
+	return m_jobRing ? m_jobRing->getCapacity() : 0;
+}
+
+JobQueueMetrics JobQueue::getMetrics() const
 {
+	JobQueueMetrics metrics;
+	metrics.enqueuedJobs = m_enqueuedJobs;
+	metrics.dequeuedJobs = m_dequeuedJobs;
+	metrics.droppedJobs = m_droppedJobs;
+	metrics.rejectedJobs = m_rejectedJobs;
+	metrics.highWaterMark = m_highWaterMark;
+	const size_t removedJobs = metrics.dequeuedJobs + metrics.droppedJobs;
+	metrics.depth = metrics.enqueuedJobs > removedJobs ? metrics.enqueuedJobs - removedJobs : 0;
+	return metrics;
+}
+
+void JobQueue::setThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	utility::checkThreadScheduling(threadScheduling);
 	lock_guard l(m_jobQueueMutex);
-	if (!m_isJobQueueRunning && !m_jobQueue.empty() && m_isJobQueueActive)
+	m_threadScheduling = threadScheduling;
+	if (m_workerThread.joinable())
 	{
-		m_isJobQueueRunning = true;
 		try
 		{
-			m_workerThread = jthread(bind_front(&JobQueue::run, this));
+			utility::applyThreadScheduling(m_workerThread.native_handle(), m_threadScheduling);
 		}
-		catch (const std::system_error &)
+		catch (const PTN_Exception &)
 		{
-			m_isJobQueueRunning = false;
+			// The jobs must run even without the requested scheduling.
 		}
 	}
 }
 
+void JobQueue::launch()
+{
+	if (m_workerThread.joinable() || !m_isJobQueueActive || isEmpty())
+	{
+		return;
+	}
+	try
+	{
+		m_workerThread = jthread(bind_front(&JobQueue::run, this));
+	}
+	catch (const std::system_error &)
+	{
+		// Retried with the next job.
+		return;
+	}
+	m_isWorkerLaunched = true;
+	try
+	{
+		utility::applyThreadScheduling(m_workerThread.native_handle(), m_threadScheduling);
+	}
+	catch (const PTN_Exception &)
+	{
+		// The jobs must run even without the requested scheduling.
+	}
+}
+
 void JobQueue::run(stop_token stopToken)
 {
-	unique_lock l(m_jobQueueMutex);
-	while (!m_jobQueue.empty() && !stopToken.stop_requested())
+	QueuedJob job;
+	while (true)
+	{
+		bool hasJob = takeJob(job);
+		// Bursts of jobs are usually added one at a time, let the producer add the next one before parking.
+		for (size_t i = 0; !hasJob && i < spinIterations && !stopToken.stop_requested(); ++i)
+		{
+			this_thread::yield();
+			hasJob = takeJob(job);
+		}
+		if (hasJob)
+		{
+			job.function();
+			job = QueuedJob();
+			continue;
+		}
+
+		unique_lock l(m_jobQueueMutex);
+		m_isWorkerParked = true;
+		// Either a producer sees the worker parked, or the worker sees the job of that producer.
+		atomic_thread_fence(memory_order_seq_cst);
+		// Once a stop is requested the wait no longer blocks, so the queued jobs are executed before exiting.
+		const bool hasJobs = m_jobAdded.wait(l, stopToken, [this] { return !isEmpty(); });
+		m_isWorkerParked = false;
+		if (!hasJobs)
+		{
+			break;
+		}
+	}
+}
+
+bool JobQueue::addJob(Job function, Job onDropped)
+{
+	QueuedJob job{ .function = move(function), .onDropped = move(onDropped) };
+	if (m_jobRing)
+	{
+		if (!pushToRing(job))
+		{
+			++m_rejectedJobs;
+			if (job.onDropped)
+			{
+				job.onDropped();
+			}
+			return false;
+		}
+	}
+	else
 	{
-		ActionFunction job = m_jobQueue.back();
-		m_jobQueue.pop_back();
-		l.unlock();
-		job();
-		l.lock();
+		lock_guard l(m_jobQueueMutex);
+		m_jobQueue.push_back(move(job));
+	}
+
+	// Approximate, the worker may have taken the job before it was counted.
+	const size_t removedJobs = m_dequeuedJobs + m_droppedJobs;
+	const size_t enqueuedJobs = ++m_enqueuedJobs;
+	const size_t depth = enqueuedJobs > removedJobs ? enqueuedJobs - removedJobs : 0;
+	size_t highWaterMark = m_highWaterMark;
+	while (depth > highWaterMark && !m_highWaterMark.compare_exchange_weak(highWaterMark, depth))
+		;
+
+	if (!m_isWorkerLaunched)
+	{
+		lock_guard l(m_jobQueueMutex);
+		launch();
 	}
-	m_isJobQueueRunning = false;
+	wakeUpWorker();
+	return true;
 }
 
-void JobQueue::addJob(const ActionFunction &actionFunction)
+bool JobQueue::pushToRing(QueuedJob &job)
 {
+	using enum PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY;
+	switch (m_overflowPolicy)
+	{
+	case FAIL_FAST:
+	{
+		return m_jobRing->push(job);
+	}
+	case DROP_OLDEST:
+	{
+		while (!m_jobRing->push(job))
+		{
+			QueuedJob oldestJob;
+			if (m_jobRing->pop(oldestJob))
+			{
+				++m_droppedJobs;
+				if (oldestJob.onDropped)
+				{
+					oldestJob.onDropped();
+				}
+			}
+		}
+		return true;
+	}
+	case BLOCK:
+	default:
+	{
+		while (true)
+		{
+			const size_t dequeuedJobs = m_dequeuedJobs;
+			if (m_jobRing->push(job))
+			{
+				return true;
+			}
+			// Returns immediately if a job was taken since the counter was read.
+			++m_blockedProducers;
+			m_dequeuedJobs.wait(dequeuedJobs);
+			--m_blockedProducers;
+		}
+	}
+	}
+}
+
+bool JobQueue::takeJob(QueuedJob &job)
+{
+	if (m_jobRing)
+	{
+		if (!m_jobRing->pop(job))
+		{
+			return false;
+		}
+	}
+	else
 	{
 		lock_guard l(m_jobQueueMutex);
-		m_jobQueue.push_front(actionFunction);
+		if (m_jobQueue.empty())
+		{
+			return false;
+		}
+		job = move(m_jobQueue.front());
+		m_jobQueue.pop_front();
+	}
+	++m_dequeuedJobs;
+	if (m_blockedProducers > 0)
+	{
+		m_dequeuedJobs.notify_all();
+	}
+	return true;
+}
+
+bool JobQueue::isEmpty() const
+{
+	return m_jobRing ? m_jobRing->empty() : m_jobQueue.empty();
+}
+
+void JobQueue::wakeUpWorker()
+{
+	atomic_thread_fence(memory_order_seq_cst);
+	if (m_isWorkerParked && m_isWorkerParked.exchange(false))
+	{
+		lock_guard l(m_jobQueueMutex);
+		m_jobAdded.notify_one();
 	}
-	launch();
 }
 
 } // namespace ptne
@@ -18,9 +18,12 @@
 
 #pragma once
 
+#include "PTN_Engine/JobQueue/JobRing.h"
 #include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/Utilities/RingDeque.h"
 #include <atomic>
-#include <deque>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -30,11 +33,30 @@ namespace ptne
 //!
 //! \brief Manages a thread that accepts tasks to be executed in sequence.
 //!
+//! The worker thread is launched with the first job and then kept, parked while there are no jobs, until the
+//! job queue is deactivated or destroyed. Jobs queued before that are still executed.
+//!
+//! The jobs are kept either in an unbounded deque protected by a mutex or, if a capacity is given on
+//! construction, in a bounded lock-free ring, where the overflow policy decides what happens to jobs added
+//! while it is full.
+//!
 class JobQueue
 {
 public:
 	~JobQueue();
+
+	//!
+	//! \brief Unbounded JobQueue constructor.
+	//!
 	JobQueue();
+
+	//!
+	//! \brief Bounded JobQueue constructor.
+	//! \param capacity - maximum number of queued jobs, rounded up to a power of 2 of at least 2. At least 1.
+	//! \param overflowPolicy - what to do when a job is added while the queue is full.
+	//!
+	JobQueue(const size_t capacity, const PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY overflowPolicy);
+
 	JobQueue(const JobQueue &) = delete;
 	JobQueue(JobQueue &&) = delete;
 	JobQueue &operator=(const JobQueue &) = delete;
@@ -44,12 +66,16 @@ public:
 	void activate();
 
 	//!
-	//! \brief Adds a job to the job queue.
-	//! \param Function/job to be executed.
+	//! \brief Adds a job to the job queue. With the BLOCK overflow policy, waits while the queue is full, so it
+	//! must not be called by the jobs themselves.
+	//! \param job - function/job to be executed.
+	//! \param onDropped - called instead of the job if it is dropped or rejected. May be empty.
+	//! \return False if the job was rejected because the queue is full.
 	//!
-	void addJob(const ActionFunction &actionFunction);
+	bool addJob(Job job, Job onDropped = nullptr);
 
-	//! Deactivate the job queue.
+	//! Deactivate the job queue, waiting for the worker thread to execute the queued jobs and exit. Jobs
+	//! added while deactivated are kept until the job queue is activated again.
 	void deactivate() noexcept;
 
 	//!
@@ -58,10 +84,29 @@ public:
 	//!
 	bool isActive() const;
 
+	//!
+	//! \brief Maximum number of queued jobs.
+	//! \return The capacity, 0 if unbounded.
+	//!
+	size_t getCapacity() const;
+
+	//!
+	//! \brief Counters of the jobs that went through the queue.
+	//! \return The metrics of the queue.
+	//!
+	JobQueueMetrics getMetrics() const;
+
+	//!
+	//! \brief Set the core pinning and priority of the worker thread, also applied to a running worker.
+	//! Applying it is best effort: a worker the system refuses to reschedule still runs its jobs.
+	//! \param threadScheduling - scheduling of the worker threads.
+	//!
+	void setThreadScheduling(const ThreadScheduling &threadScheduling);
 
 private:
 	//!
-	//! \brief Launch the job queue.
+	//! \brief Launch the worker thread, if the job queue is active and it is not running yet. Must be called
+	//! with m_jobQueueMutex locked.
 	//!
 	void launch();
 
@@ -70,19 +115,77 @@ private:
 	//!
 	void run(std::stop_token stopToken);
 
+	//!
+	//! \brief Add a job to the ring, applying the overflow policy if it is full.
+	//! \param job - the job to add.
+	//! \return False if the job was rejected.
+	//!
+	bool pushToRing(QueuedJob &job);
+
+	//!
+	//! \brief Take the oldest job.
+	//! \param job - receives the job taken.
+	//! \return False if there are no jobs.
+	//!
+	bool takeJob(QueuedJob &job);
+
+	//!
+	//! \brief Tells if there are no jobs. Must be called with m_jobQueueMutex locked.
+	//! \return True if there are no jobs.
+	//!
+	bool isEmpty() const;
+
+	//!
+	//! \brief Wake up the worker thread if it is parked.
+	//!
+	void wakeUpWorker();
+
 	//! Whether the job queue is active or not.
 	std::atomic<bool> m_isJobQueueActive = true;
 
-	//! Whether the job queue is running or not.
-	std::atomic<bool> m_isJobQueueRunning = false;
+	//! Bounded ring with the jobs to be executed, if the job queue is bounded.
+	const std::unique_ptr<JobRing> m_jobRing;
+
+	//! What to do with jobs added while the ring is full.
+	const PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY m_overflowPolicy = PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY::BLOCK;
 
-	//! The collection of jobs to be executed.
-	std::deque<ActionFunction> m_jobQueue;
+	//! The collection of jobs to be executed, if the job queue is unbounded.
+	utility::RingDeque<QueuedJob> m_jobQueue;
 
 	//! Mutex to synchronize the job queue operations.
 	std::mutex m_jobQueueMutex;
 
-	//! Thread where the jobs are executed.
+	//! Wakes up the parked worker thread when jobs are added or it is asked to stop.
+	std::condition_variable_any m_jobAdded;
+
+	//! Whether the worker thread is parked and not notified yet.
+	std::atomic<bool> m_isWorkerParked = false;
+
+	//! Whether the worker thread was launched and not stopped.
+	std::atomic<bool> m_isWorkerLaunched = false;
+
+	//! Number of producers waiting for room in the ring.
+	std::atomic<size_t> m_blockedProducers = 0;
+
+	//! Number of jobs added.
+	std::atomic<size_t> m_enqueuedJobs = 0;
+
+	//! Number of jobs taken by the worker thread, also waited on by blocked producers.
+	std::atomic<size_t> m_dequeuedJobs = 0;
+
+	//! Number of queued jobs dropped to make room for new ones.
+	std::atomic<size_t> m_droppedJobs = 0;
+
+	//! Number of jobs rejected because the ring was full.
+	std::atomic<size_t> m_rejectedJobs = 0;
+
+	//! Highest number of queued jobs.
+	std::atomic<size_t> m_highWaterMark = 0;
+
+	//! Core pinning and priority of the worker threads. Protected by m_jobQueueMutex.
+	ThreadScheduling m_threadScheduling;
+
+	//! Thread where the jobs are executed. Protected by m_jobQueueMutex, joinable while the worker runs.
 	std::jthread m_workerThread;
 };
 
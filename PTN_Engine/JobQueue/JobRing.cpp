@@ -0,0 +1,68 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/JobQueue/JobRing.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <utility>
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+size_t checkCapacity(const size_t capacity)
+{
+	if (capacity == 0)
+	{
+		throw PTN_Exception("The capacity of the job queue must be at least 1.");
+	}
+	return capacity;
+}
+
+} // namespace
+
+JobRing::JobRing(const size_t capacity)
+: m_ring(checkCapacity(capacity))
+{
+}
+
+JobRing::~JobRing() = default;
+
+size_t JobRing::getCapacity() const
+{
+	return m_ring.capacity();
+}
+
+bool JobRing::push(QueuedJob &job)
+{
+	return m_ring.push(move(job));
+}
+
+bool JobRing::pop(QueuedJob &job)
+{
+	return m_ring.pop(job);
+}
+
+bool JobRing::empty() const
+{
+	return m_ring.empty();
+}
+
+} // namespace ptne
@@ -0,0 +1,91 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/JobQueue/Job.h"
+#include "PTN_Engine/Utilities/SequenceRing.h"
+#include <cstddef>
+
+namespace ptne
+{
+
+//!
+//! \brief Job waiting in a job queue.
+//!
+struct QueuedJob
+{
+	//! Function executing the job.
+	Job function;
+
+	//! Function called instead, if the job is dropped or rejected. May be empty.
+	Job onDropped;
+};
+
+//!
+//! \brief Bounded lock-free ring of jobs, written and read by any number of threads. Consumers other than the
+//! job queue worker are producers dropping the oldest job to make room for theirs.
+//!
+class JobRing final
+{
+public:
+	~JobRing();
+
+	//!
+	//! \brief JobRing constructor.
+	//! \param capacity - maximum number of queued jobs, rounded up to a power of 2 of at least 2. At least 1.
+	//!
+	explicit JobRing(const size_t capacity);
+
+	JobRing(const JobRing &) = delete;
+	JobRing(JobRing &&) = delete;
+	JobRing &operator=(const JobRing &) = delete;
+	JobRing &operator=(JobRing &&) = delete;
+
+	//!
+	//! \brief Maximum number of queued jobs.
+	//! \return The capacity of the ring.
+	//!
+	size_t getCapacity() const;
+
+	//!
+	//! \brief Add a job to the ring.
+	//! \param job - the job to add, moved from only if it was added.
+	//! \return False if the ring is full.
+	//!
+	bool push(QueuedJob &job);
+
+	//!
+	//! \brief Take the oldest job from the ring.
+	//! \param job - receives the job taken.
+	//! \return False if the ring is empty.
+	//!
+	bool pop(QueuedJob &job);
+
+	//!
+	//! \brief Tells if there are no jobs ready to be taken.
+	//! \return True if the ring is empty.
+	//!
+	bool empty() const;
+
+private:
+	//! Ring of the queued jobs.
+	utility::SequenceRing<QueuedJob> m_ring;
+};
+
+} // namespace ptne
@@ -0,0 +1,162 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/JobQueue/ThreadPool.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include "PTN_Engine/Utilities/ThreadScheduling.h"
+
+namespace ptne
+{
+using namespace std;
+
+namespace
+{
+
+//! Number of times an idle thread yields, looking for new jobs, before parking.
+constexpr size_t spinIterations = 16;
+
+} // namespace
+
+ThreadPool::ThreadPool(const size_t numberOfThreads)
+{
+	if (numberOfThreads == 0)
+	{
+		throw PTN_Exception("The number of threads must be at least 1.");
+	}
+	for (size_t i = 0; i < numberOfThreads; ++i)
+	{
+		m_queues.push_back(make_unique<JobsQueue>());
+	}
+	for (size_t i = 0; i < numberOfThreads; ++i)
+	{
+		m_threads.emplace_back(&ThreadPool::run, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard guard(m_parkMutex);
+		m_stopping = true;
+	}
+	m_jobAdded.notify_all();
+	for (auto &thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+size_t ThreadPool::getNumberOfThreads() const
+{
+	return m_threads.size();
+}
+
+void ThreadPool::addJob(Job job)
+{
+	// Counted before it is queued, so that the count never drops below the number of queued jobs. Both
+	// sequentially consistent: either a parking thread sees the job, or this sees it parked.
+	m_pendingJobs.fetch_add(1);
+	JobsQueue &queue = *m_queues[m_nextQueue.fetch_add(1, memory_order_relaxed) % m_queues.size()];
+	{
+		lock_guard guard(queue.mutex);
+		queue.jobs.push_back(move(job));
+	}
+	if (m_parkedThreads.load() > 0)
+	{
+		lock_guard guard(m_parkMutex);
+		m_jobAdded.notify_one();
+	}
+}
+
+void ThreadPool::setThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	utility::checkThreadScheduling(threadScheduling);
+	for (auto &thread : m_threads)
+	{
+		try
+		{
+			utility::applyThreadScheduling(thread.native_handle(), threadScheduling);
+		}
+		catch (const PTN_Exception &)
+		{
+			// The jobs must run even without the requested scheduling.
+		}
+	}
+}
+
+void ThreadPool::run(const size_t thread)
+{
+	Job job;
+	while (true)
+	{
+		bool hasJob = takeJob(thread, job);
+		for (size_t i = 0; !hasJob && i < spinIterations; ++i)
+		{
+			this_thread::yield();
+			hasJob = takeJob(thread, job);
+		}
+		if (hasJob)
+		{
+			job();
+			job = nullptr;
+			continue;
+		}
+
+		unique_lock lock(m_parkMutex);
+		if (m_stopping && m_pendingJobs == 0)
+		{
+			return;
+		}
+		++m_parkedThreads;
+		m_jobAdded.wait(lock, [this] { return m_pendingJobs > 0 || m_stopping; });
+		--m_parkedThreads;
+	}
+}
+
+bool ThreadPool::takeJob(const size_t thread, Job &job)
+{
+	if (m_pendingJobs == 0)
+	{
+		return false;
+	}
+	for (size_t i = 0; i < m_queues.size(); ++i)
+	{
+		JobsQueue &queue = *m_queues[(thread + i) % m_queues.size()];
+		lock_guard guard(queue.mutex);
+		if (queue.jobs.empty())
+		{
+			continue;
+		}
+		// The owner takes the oldest job, thieves the newest one.
+		if (i == 0)
+		{
+			job = move(queue.jobs.front());
+			queue.jobs.pop_front();
+		}
+		else
+		{
+			job = move(queue.jobs.back());
+			queue.jobs.pop_back();
+		}
+		--m_pendingJobs;
+		return true;
+	}
+	return false;
+}
+
+} // namespace ptne
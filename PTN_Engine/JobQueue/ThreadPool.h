@@ -0,0 +1,129 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/JobQueue/Job.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/Utilities/RingDeque.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Fixed set of threads executing independent jobs, in no particular order.
+//!
+//! Each thread owns a queue of jobs, and new jobs are distributed over the queues in turn. Threads take jobs
+//! from the front of their own queue and, once it is empty, steal from the back of the queues of the other
+//! threads, so that a long job does not hold back the jobs queued behind it. Idle threads park until jobs
+//! are added. Destroying the pool waits for the queued jobs to be executed.
+//!
+class ThreadPool final
+{
+public:
+	~ThreadPool();
+
+	//!
+	//! \brief ThreadPool constructor, launching the threads.
+	//! \param numberOfThreads - number of threads executing the jobs. At least 1.
+	//!
+	explicit ThreadPool(const size_t numberOfThreads);
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool(ThreadPool &&) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+	ThreadPool &operator=(ThreadPool &&) = delete;
+
+	//!
+	//! \brief Number of threads executing the jobs.
+	//! \return The number of threads.
+	//!
+	size_t getNumberOfThreads() const;
+
+	//!
+	//! \brief Add a job to be executed by one of the threads. Can be called from any thread.
+	//! \param job - function to execute.
+	//!
+	void addJob(Job job);
+
+	//!
+	//! \brief Set the core pinning and priority of the threads. Applying it is best effort: threads the system
+	//! refuses to reschedule still execute jobs.
+	//! \param threadScheduling - scheduling of the threads.
+	//!
+	void setThreadScheduling(const ThreadScheduling &threadScheduling);
+
+private:
+	//!
+	//! \brief Queue of jobs owned by one thread.
+	//!
+	struct JobsQueue
+	{
+		//! Synchronizes the owner with the threads adding jobs and stealing from it.
+		std::mutex mutex;
+
+		//! Jobs waiting to be executed.
+		utility::RingDeque<Job> jobs;
+	};
+
+	//!
+	//! \brief Execute jobs until the pool is destroyed and no jobs are left.
+	//! \param thread - index of the thread.
+	//!
+	void run(const size_t thread);
+
+	//!
+	//! \brief Take a job from the queue of a thread or, if it is empty, steal one from another queue.
+	//! \param thread - index of the thread.
+	//! \param job - set to the job taken.
+	//! \return True if a job was taken.
+	//!
+	bool takeJob(const size_t thread, Job &job);
+
+	//! Queues of jobs, one per thread.
+	std::vector<std::unique_ptr<JobsQueue>> m_queues;
+
+	//! Queue receiving the next job, modulo the number of queues.
+	std::atomic<size_t> m_nextQueue = 0;
+
+	//! Number of jobs in all queues.
+	std::atomic<size_t> m_pendingJobs = 0;
+
+	//! Number of parked threads.
+	std::atomic<size_t> m_parkedThreads = 0;
+
+	//! Flag set when the pool is destroyed, letting the threads exit once no jobs are left.
+	std::atomic<bool> m_stopping = false;
+
+	//! Mutex protecting the condition variable.
+	std::mutex m_parkMutex;
+
+	//! Wakes up parked threads when jobs are added or the pool is destroyed.
+	std::condition_variable m_jobAdded;
+
+	//! Threads executing the jobs.
+	std::vector<std::jthread> m_threads;
+};
+
+} // namespace ptne
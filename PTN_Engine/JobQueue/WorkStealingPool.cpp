@@ -0,0 +1,171 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/JobQueue/WorkStealingPool.h"
+#include "PTN_Engine/PTN_Exception.h"
+
+namespace ptne
+{
+using namespace std;
+
+//! The threads are requested to stop and joined by their destructors.
+WorkStealingPool::~WorkStealingPool() = default;
+
+WorkStealingPool::WorkStealingPool(const size_t numberOfThreads)
+{
+	if (numberOfThreads == 0)
+	{
+		throw PTN_Exception("The work stealing pool needs at least one thread.");
+	}
+
+	for (size_t thread = 0; thread < numberOfThreads; ++thread)
+	{
+		m_queues.push_back(make_unique<TaskQueue>());
+	}
+	for (size_t thread = 1; thread < numberOfThreads; ++thread)
+	{
+		m_workers.emplace_back(bind_front(&WorkStealingPool::work, this), thread);
+	}
+}
+
+size_t WorkStealingPool::getNumberOfThreads() const
+{
+	return m_queues.size();
+}
+
+void WorkStealingPool::run(const size_t numberOfTasks, const function<void(size_t)> &task)
+{
+	if (numberOfTasks == 0)
+	{
+		return;
+	}
+
+	m_task = &task;
+	m_exception = nullptr;
+	m_remainingTasks = numberOfTasks;
+	for (size_t i = 0; i < numberOfTasks; ++i)
+	{
+		auto &queue = *m_queues[i % m_queues.size()];
+		lock_guard queueGuard(queue.mutex);
+		queue.tasks.push_back(i);
+	}
+
+	if (!m_workers.empty())
+	{
+		{
+			lock_guard guard(m_mutex);
+			++m_batch;
+		}
+		m_batchStarted.notify_all();
+	}
+
+	while (runOneTask(0))
+	{
+	}
+
+	{
+		unique_lock guard(m_mutex);
+		m_batchFinished.wait(guard, [this] { return m_remainingTasks == 0; });
+	}
+	m_task = nullptr;
+
+	if (m_exception)
+	{
+		rethrow_exception(m_exception);
+	}
+}
+
+// Private
+
+void WorkStealingPool::work(stop_token stopToken, const size_t thread)
+{
+	size_t lastBatch = 0;
+	while (!stopToken.stop_requested())
+	{
+		{
+			unique_lock guard(m_mutex);
+			if (!m_batchStarted.wait(guard, stopToken, [this, lastBatch] { return m_batch != lastBatch; }))
+			{
+				return;
+			}
+			lastBatch = m_batch;
+		}
+
+		while (runOneTask(thread))
+		{
+		}
+	}
+}
+
+bool WorkStealingPool::runOneTask(const size_t thread)
+{
+	size_t task = 0;
+	if (!takeTask(thread, task))
+	{
+		return false;
+	}
+
+	try
+	{
+		(*m_task)(task);
+	}
+	catch (...)
+	{
+		lock_guard exceptionGuard(m_exceptionMutex);
+		if (!m_exception)
+		{
+			m_exception = current_exception();
+		}
+	}
+
+	if (m_remainingTasks.fetch_sub(1) == 1)
+	{
+		lock_guard guard(m_mutex);
+		m_batchFinished.notify_all();
+	}
+	return true;
+}
+
+bool WorkStealingPool::takeTask(const size_t thread, size_t &task)
+{
+	{
+		auto &queue = *m_queues[thread];
+		lock_guard queueGuard(queue.mutex);
+		if (!queue.tasks.empty())
+		{
+			task = queue.tasks.front();
+			queue.tasks.pop_front();
+			return true;
+		}
+	}
+
+	for (size_t i = 1; i < m_queues.size(); ++i)
+	{
+		auto &victim = *m_queues[(thread + i) % m_queues.size()];
+		lock_guard queueGuard(victim.mutex);
+		if (!victim.tasks.empty())
+		{
+			task = victim.tasks.back();
+			victim.tasks.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace ptne
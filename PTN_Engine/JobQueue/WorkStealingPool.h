@@ -0,0 +1,137 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ptne
+{
+
+//!
+//! \brief Fork-join pool running batches of independent tasks on a fixed set of threads.
+//!
+//! Each thread owns a queue of tasks. Threads take tasks from the front of their own queue and, once it is
+//! empty, steal from the back of the queues of the other threads, so uneven tasks are balanced between them.
+//! The thread calling run takes part in the work, a pool of N threads launches N - 1 worker threads.
+//!
+class WorkStealingPool final
+{
+public:
+	~WorkStealingPool();
+
+	//!
+	//! \brief WorkStealingPool constructor.
+	//! \param numberOfThreads - number of threads running the tasks, including the caller of run. At least 1.
+	//!
+	explicit WorkStealingPool(const size_t numberOfThreads);
+
+	WorkStealingPool(const WorkStealingPool &) = delete;
+	WorkStealingPool(WorkStealingPool &&) = delete;
+	WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+	WorkStealingPool &operator=(WorkStealingPool &&) = delete;
+
+	//!
+	//! \brief Number of threads running the tasks, including the caller of run.
+	//! \return The number of threads.
+	//!
+	size_t getNumberOfThreads() const;
+
+	//!
+	//! \brief Run a batch of tasks and wait until all of them finished. Not reentrant: tasks must not call run.
+	//! If tasks throw, all the other tasks still run and the first exception is rethrown afterwards.
+	//! \param numberOfTasks - number of tasks in the batch.
+	//! \param task - function called once with each task index, from 0 to numberOfTasks - 1.
+	//!
+	void run(const size_t numberOfTasks, const std::function<void(size_t)> &task);
+
+private:
+	//!
+	//! \brief Queue of tasks owned by one thread.
+	//!
+	struct TaskQueue
+	{
+		//! Synchronizes the owner with the threads stealing from it.
+		std::mutex mutex;
+
+		//! Indexes of the tasks.
+		std::deque<size_t> tasks;
+	};
+
+	//!
+	//! \brief Run tasks while there are tasks left to take. Should be executed in its own thread.
+	//! \param stopToken - requests the thread to finish.
+	//! \param thread - index of the queue owned by the thread.
+	//!
+	void work(std::stop_token stopToken, const size_t thread);
+
+	//!
+	//! \brief Take a task from the own queue or steal one from another thread, and run it.
+	//! \param thread - index of the queue owned by the calling thread.
+	//! \return False if there were no tasks left to take.
+	//!
+	bool runOneTask(const size_t thread);
+
+	//!
+	//! \brief Take a task from the front of the own queue, or from the back of the queue of another thread.
+	//! \param thread - index of the queue owned by the calling thread.
+	//! \param task - the task taken.
+	//! \return False if all queues are empty.
+	//!
+	bool takeTask(const size_t thread, size_t &task);
+
+	//! One queue per thread. The caller of run owns the first one.
+	std::vector<std::unique_ptr<TaskQueue>> m_queues;
+
+	//! Function running the tasks of the current batch.
+	const std::function<void(size_t)> *m_task = nullptr;
+
+	//! Tasks of the current batch that did not finish yet.
+	std::atomic<size_t> m_remainingTasks = 0;
+
+	//! First exception thrown by a task of the current batch.
+	std::exception_ptr m_exception;
+
+	//! Synchronizes m_exception.
+	std::mutex m_exceptionMutex;
+
+	//! Incremented on each batch, so that the worker threads know when there is new work.
+	size_t m_batch = 0;
+
+	//! Synchronizes m_batch and the waits on the condition variables.
+	std::mutex m_mutex;
+
+	//! Wakes up the worker threads when a batch starts.
+	std::condition_variable_any m_batchStarted;
+
+	//! Wakes up the caller of run when the last task of the batch finishes.
+	std::condition_variable m_batchFinished;
+
+	//! Worker threads. Declared last so that they are joined before the rest of the pool is destroyed.
+	std::vector<std::jthread> m_workers;
+};
+
+} // namespace ptne
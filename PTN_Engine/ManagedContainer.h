@@ -63,6 +63,17 @@ public:
 		m_items[name] = item;
 	}
 
+	//!
+	//! \brief Tells if an item is in the container.
+	//! \param name - Identifier of the item.
+	//! \return True if the container has an item identified by name.
+	//!
+	bool contains(const std::string &name) const
+	{
+		std::shared_lock lock(m_mutex);
+		return m_items.contains(name);
+	}
+
 	//!
 	//! \brief Retrieve a copy of the item.
 	//! \param name - Identifier of the item.
@@ -30,6 +30,25 @@ PTN_Engine::PTN_Engine(ACTIONS_THREAD_OPTION actionsRuntimeThread)
 {
 }
 
+PTN_Engine::PTN_Engine(ACTIONS_THREAD_OPTION actionsRuntimeThread,
+					   CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy,
+					   optional<uint64_t> seed)
+: m_impProxy(make_unique<PTN_EngineImpProxy>(actionsRuntimeThread, conflictResolutionPolicy, seed))
+{
+}
+
+PTN_Engine::PTN_Engine(shared_ptr<IActionsExecutor> actionsExecutor,
+					   CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy,
+					   optional<uint64_t> seed)
+: m_impProxy(make_unique<PTN_EngineImpProxy>(move(actionsExecutor), conflictResolutionPolicy, seed))
+{
+}
+
+PTN_Engine::CONFLICT_RESOLUTION_POLICY PTN_Engine::getConflictResolutionPolicy() const
+{
+	return m_impProxy->getConflictResolutionPolicy();
+}
+
 void PTN_Engine::setEventLoopSleepDuration(const EventLoopSleepDuration sleepDuration)
 {
 	m_impProxy->setEventLoopSleepDuration(sleepDuration);
@@ -40,16 +59,174 @@ PTN_Engine::EventLoopSleepDuration PTN_Engine::getEventLoopSleepDuration() const
 	return m_impProxy->getEventLoopSleepDuration();
 }
 
+void PTN_Engine::setEventLoopSpinDuration(const EventLoopSpinDuration spinDuration)
+{
+	m_impProxy->setEventLoopSpinDuration(spinDuration);
+}
+
+PTN_Engine::EventLoopSpinDuration PTN_Engine::getEventLoopSpinDuration() const
+{
+	return m_impProxy->getEventLoopSpinDuration();
+}
+
+void PTN_Engine::setEventLoopWatchdogEnabled(const bool watchdogEnabled)
+{
+	m_impProxy->setEventLoopWatchdogEnabled(watchdogEnabled);
+}
+
+bool PTN_Engine::isEventLoopWatchdogEnabled() const
+{
+	return m_impProxy->isEventLoopWatchdogEnabled();
+}
+
+void PTN_Engine::setEventLoopBusyPolling(const bool busyPolling)
+{
+	m_impProxy->setEventLoopBusyPolling(busyPolling);
+}
+
+bool PTN_Engine::isEventLoopBusyPolling() const
+{
+	return m_impProxy->isEventLoopBusyPolling();
+}
+
+void PTN_Engine::setEngineScheduler(shared_ptr<EngineScheduler> engineScheduler)
+{
+	m_impProxy->setEngineScheduler(std::move(engineScheduler));
+}
+
+shared_ptr<EngineScheduler> PTN_Engine::getEngineScheduler() const
+{
+	return m_impProxy->getEngineScheduler();
+}
+
+void PTN_Engine::setEventLoopThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	m_impProxy->setEventLoopThreadScheduling(threadScheduling);
+}
+
+ThreadScheduling PTN_Engine::getEventLoopThreadScheduling() const
+{
+	return m_impProxy->getEventLoopThreadScheduling();
+}
+
+void PTN_Engine::setJobQueueThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	m_impProxy->setJobQueueThreadScheduling(threadScheduling);
+}
+
+ThreadScheduling PTN_Engine::getJobQueueThreadScheduling() const
+{
+	return m_impProxy->getJobQueueThreadScheduling();
+}
+
+void PTN_Engine::notifyConditionsChanged()
+{
+	m_impProxy->notifyConditionsChanged();
+}
+
+void PTN_Engine::setMaximalStepFiring(const bool maximalStepFiring)
+{
+	m_impProxy->setMaximalStepFiring(maximalStepFiring);
+}
+
+bool PTN_Engine::isMaximalStepFiring() const
+{
+	return m_impProxy->isMaximalStepFiring();
+}
+
+void PTN_Engine::setMultiFiring(const bool multiFiring)
+{
+	m_impProxy->setMultiFiring(multiFiring);
+}
+
+bool PTN_Engine::isMultiFiring() const
+{
+	return m_impProxy->isMultiFiring();
+}
+
+void PTN_Engine::setNumberOfFiringThreads(const size_t numberOfFiringThreads)
+{
+	m_impProxy->setNumberOfFiringThreads(numberOfFiringThreads);
+}
+
+size_t PTN_Engine::getNumberOfFiringThreads() const
+{
+	return m_impProxy->getNumberOfFiringThreads();
+}
+
+void PTN_Engine::setJobQueueCapacity(const size_t capacity, const JOB_QUEUE_OVERFLOW_POLICY overflowPolicy)
+{
+	m_impProxy->setJobQueueCapacity(capacity, overflowPolicy);
+}
+
+size_t PTN_Engine::getJobQueueCapacity() const
+{
+	return m_impProxy->getJobQueueCapacity();
+}
+
+PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY PTN_Engine::getJobQueueOverflowPolicy() const
+{
+	return m_impProxy->getJobQueueOverflowPolicy();
+}
+
+JobQueueMetrics PTN_Engine::getJobQueueMetrics() const
+{
+	return m_impProxy->getJobQueueMetrics();
+}
+
+void PTN_Engine::setNumberOfActionThreads(const size_t numberOfActionThreads)
+{
+	m_impProxy->setNumberOfActionThreads(numberOfActionThreads);
+}
+
+size_t PTN_Engine::getNumberOfActionThreads() const
+{
+	return m_impProxy->getNumberOfActionThreads();
+}
+
+void PTN_Engine::setInlineActionThreshold(const chrono::nanoseconds inlineActionThreshold)
+{
+	m_impProxy->setInlineActionThreshold(inlineActionThreshold);
+}
+
+chrono::nanoseconds PTN_Engine::getInlineActionThreshold() const
+{
+	return m_impProxy->getInlineActionThreshold();
+}
+
+void PTN_Engine::setInputQueueCapacity(const size_t capacity)
+{
+	m_impProxy->setInputQueueCapacity(capacity);
+}
+
+size_t PTN_Engine::getInputQueueCapacity() const
+{
+	return m_impProxy->getInputQueueCapacity();
+}
+
 void PTN_Engine::addArc(const ArcProperties &arcProperties)
 {
 	m_impProxy->addArc(arcProperties);
 }
 
+void PTN_Engine::addArc(const PlaceHandle place,
+						const TransitionHandle transition,
+						const ArcProperties::Type type,
+						const size_t weight)
+{
+	m_impProxy->addArc(place, transition, type, weight);
+}
+
 void PTN_Engine::removeArc(const ArcProperties &arcProperties)
 {
 	m_impProxy->removeArc(arcProperties);
 }
 
+void PTN_Engine::removeArc(const PlaceHandle place, const TransitionHandle transition, const ArcProperties::Type type)
+{
+	m_impProxy->removeArc(place, transition, type);
+}
+
 void PTN_Engine::clearNet()
 {
 	m_impProxy->clearNet();
@@ -65,14 +242,24 @@ vector<TransitionProperties> PTN_Engine::getTransitionsProperties() const
 	return m_impProxy->getTransitionsProperties();
 }
 
-void PTN_Engine::createTransition(const TransitionProperties &transitionProperties)
+TransitionHandle PTN_Engine::createTransition(const TransitionProperties &transitionProperties)
+{
+	return m_impProxy->createTransition(transitionProperties);
+}
+
+PlaceHandle PTN_Engine::createPlace(const PlaceProperties &placeProperties)
+{
+	return m_impProxy->createPlace(placeProperties);
+}
+
+PlaceHandle PTN_Engine::getPlaceHandle(const string &place) const
 {
-	m_impProxy->createTransition(transitionProperties);
+	return m_impProxy->getPlaceHandle(place);
 }
 
-void PTN_Engine::createPlace(const PlaceProperties &placeProperties)
+TransitionHandle PTN_Engine::getTransitionHandle(const string &transition) const
 {
-	m_impProxy->createPlace(placeProperties);
+	return m_impProxy->getTransitionHandle(transition);
 }
 
 void PTN_Engine::registerAction(const string &name, const ActionFunction &action) const
@@ -80,11 +267,26 @@ void PTN_Engine::registerAction(const string &name, const ActionFunction &action
 	m_impProxy->registerAction(name, action);
 }
 
+void PTN_Engine::registerBatchAction(const string &name, const BatchActionFunction &action) const
+{
+	m_impProxy->registerBatchAction(name, action);
+}
+
+void PTN_Engine::registerAsyncAction(const string &name, const AsyncActionFunction &action) const
+{
+	m_impProxy->registerAsyncAction(name, action);
+}
+
 void PTN_Engine::registerCondition(const string &name, const ConditionFunction &condition) const
 {
 	m_impProxy->registerCondition(name, condition);
 }
 
+void PTN_Engine::registerExecutorLane(const string &name, shared_ptr<IActionsExecutor> executor) const
+{
+	m_impProxy->registerExecutorLane(name, move(executor));
+}
+
 void PTN_Engine::execute(const bool log, ostream &o)
 {
 	m_impProxy->execute(log, o);
@@ -95,11 +297,46 @@ size_t PTN_Engine::getNumberOfTokens(const string &place) const
 	return m_impProxy->getNumberOfTokens(place);
 }
 
+size_t PTN_Engine::getNumberOfTokens(const PlaceHandle place) const
+{
+	return m_impProxy->getNumberOfTokens(place);
+}
+
+size_t PTN_Engine::getNumberOfCoalescedActions(const string &place) const
+{
+	return m_impProxy->getNumberOfCoalescedActions(place);
+}
+
 void PTN_Engine::incrementInputPlace(const string &place)
 {
 	m_impProxy->incrementInputPlace(place);
 }
 
+void PTN_Engine::incrementInputPlace(const PlaceHandle place)
+{
+	m_impProxy->incrementInputPlace(place);
+}
+
+void PTN_Engine::incrementInputPlace(const string &place, const size_t count)
+{
+	m_impProxy->incrementInputPlace(place, count);
+}
+
+void PTN_Engine::incrementInputPlace(const PlaceHandle place, const size_t count)
+{
+	m_impProxy->incrementInputPlace(place, count);
+}
+
+void PTN_Engine::incrementInputPlace(span<const pair<string, size_t>> increments)
+{
+	m_impProxy->incrementInputPlace(increments);
+}
+
+void PTN_Engine::incrementInputPlace(span<const pair<PlaceHandle, size_t>> increments)
+{
+	m_impProxy->incrementInputPlace(increments);
+}
+
 void PTN_Engine::printState(ostream &o) const
 {
 	m_impProxy->printState(o);
@@ -125,4 +362,19 @@ void PTN_Engine::stop()
 	m_impProxy->stop();
 }
 
+void PTN_Engine::freeze()
+{
+	m_impProxy->freeze();
+}
+
+void PTN_Engine::thaw()
+{
+	m_impProxy->thaw();
+}
+
+bool PTN_Engine::isFrozen() const
+{
+	return m_impProxy->isFrozen();
+}
+
 } // namespace ptne
@@ -19,69 +19,142 @@
  */
 
 #include "PTN_Engine/PTN_EngineImp.h"
+#include "PTN_Engine/ConflictResolution/ConflictResolverFactory.h"
 #include "PTN_Engine/Executor/ActionsExecutorFactory.h"
 #include "PTN_Engine/Utilities/LockWeakPtr.h"
+#include "PTN_Engine/Utilities/ThreadScheduling.h"
 #include <algorithm>
+#include <bit>
+#include <limits>
 
 namespace ptne
 {
 using namespace std;
 using enum PTN_Engine::ACTIONS_THREAD_OPTION;
 
-PTN_EngineImp::PTN_EngineImp(PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption)
-: m_actionsThreadOption(actionsThreadOption)
-, m_actionsExecutor(ActionsExecutorFactory::createExecutor(actionsThreadOption))
+PTN_EngineImp::PTN_EngineImp(PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption,
+							 PTN_Engine::CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy,
+							 optional<uint64_t> seed)
+: m_executorOptions{ .numberOfActionThreads = max<size_t>(1, thread::hardware_concurrency()) }
+, m_actionsExecutor(ActionsExecutorFactory::createExecutor(actionsThreadOption, m_executorOptions))
+, m_actionsThreadOption(actionsThreadOption)
+, m_conflictResolutionPolicy(conflictResolutionPolicy)
 , m_eventLoop(*this)
+, m_actionsInExecution(make_shared<ActionsInExecution>(m_eventLoop.getEventNotifier()))
+, m_transitions(ConflictResolverFactory::createConflictResolver(conflictResolutionPolicy, seed))
 {
 }
 
+PTN_EngineImp::PTN_EngineImp(shared_ptr<IActionsExecutor> actionsExecutor,
+							 PTN_Engine::CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy,
+							 optional<uint64_t> seed)
+: m_executorOptions{ .numberOfActionThreads = max<size_t>(1, thread::hardware_concurrency()) }
+, m_actionsExecutor(move(actionsExecutor))
+, m_actionsThreadOption(CUSTOM)
+, m_conflictResolutionPolicy(conflictResolutionPolicy)
+, m_eventLoop(*this)
+, m_actionsInExecution(make_shared<ActionsInExecution>(m_eventLoop.getEventNotifier()))
+, m_transitions(ConflictResolverFactory::createConflictResolver(conflictResolutionPolicy, seed))
+{
+	if (m_actionsExecutor == nullptr)
+	{
+		throw PTN_Exception("The actions executor must not be null.");
+	}
+}
+
 PTN_EngineImp::~PTN_EngineImp()
 {
 	stop();
+	// The executor may be shared with other engines and outlive this one, so the queued actions, which refer
+	// to the places, must finish first.
+	m_places.waitForActionsInExecution();
+	m_actionsExecutor.reset();
 }
 
 void PTN_EngineImp::clearInputPlaces()
 {
+	if (m_frozenNet)
+	{
+		m_frozenNet->clearInputPlaces();
+		m_newInputReceived = false;
+		return;
+	}
 	m_places.clearInputPlaces();
+	m_transitions.markAllDirty();
 	m_newInputReceived = false;
 }
 
 void PTN_EngineImp::clearNet()
 {
-	if (isEventLoopRunning())
-	{
-		throw PTN_Exception("Cannot clear net while the event loop is running.");
-	}
+	throwIfStructureLocked("clear net");
+	m_places.waitForActionsInExecution();
 	m_transitions.clear();
 	m_places.clear();
+	m_actionsInExecution->clear();
+	// Only once the places are gone, so that the new queue only receives increments validated against the new net.
+	discardInputQueue();
 }
 
-void PTN_EngineImp::createTransition(const TransitionProperties &transitionProperties)
+TransitionHandle PTN_EngineImp::createTransition(const TransitionProperties &transitionProperties)
 {
-	createTransition(transitionProperties.name, transitionProperties.activationArcs,
+	if (m_frozenNet)
+	{
+		throw PTN_Exception("Cannot create transition while the net is frozen. Call thaw first.");
+	}
+	return createTransition(transitionProperties.name, transitionProperties.activationArcs,
 					 transitionProperties.destinationArcs, transitionProperties.inhibitorArcs,
 					 !transitionProperties.additionalConditionsNames.empty() ?
 					 m_conditions.getItems(transitionProperties.additionalConditionsNames) :
 					 createAnonymousConditions(transitionProperties.additionalConditions),
-					 transitionProperties.requireNoActionsInExecution);
+					 transitionProperties.requireNoActionsInExecution, transitionProperties.priority);
 }
 
-void PTN_EngineImp::createPlace(PlaceProperties placeProperties)
+PlaceHandle PTN_EngineImp::createPlace(PlaceProperties placeProperties)
 {
+	if (m_frozenNet)
+	{
+		throw PTN_Exception("Cannot create place while the net is frozen. Call thaw first.");
+	}
 	ActionFunction onEnterAction = placeProperties.onEnterAction;
-	if (!placeProperties.onEnterActionFunctionName.empty())
+	if (m_asyncActions.contains(placeProperties.onEnterActionFunctionName))
+	{
+		placeProperties.onEnterAsyncAction = m_asyncActions.getItem(placeProperties.onEnterActionFunctionName);
+	}
+	else if (m_batchActions.contains(placeProperties.onEnterActionFunctionName))
+	{
+		placeProperties.onEnterBatchAction = m_batchActions.getItem(placeProperties.onEnterActionFunctionName);
+	}
+	else if (!placeProperties.onEnterActionFunctionName.empty())
 	{
 		placeProperties.onEnterAction = m_actions.getItem(placeProperties.onEnterActionFunctionName);
 	}
 
 	ActionFunction onExitAction = placeProperties.onExitAction;
-	if (!placeProperties.onExitActionFunctionName.empty())
+	if (m_asyncActions.contains(placeProperties.onExitActionFunctionName))
+	{
+		placeProperties.onExitAsyncAction = m_asyncActions.getItem(placeProperties.onExitActionFunctionName);
+	}
+	else if (m_batchActions.contains(placeProperties.onExitActionFunctionName))
+	{
+		placeProperties.onExitBatchAction = m_batchActions.getItem(placeProperties.onExitActionFunctionName);
+	}
+	else if (!placeProperties.onExitActionFunctionName.empty())
 	{
 		placeProperties.onExitAction = m_actions.getItem(placeProperties.onExitActionFunctionName);
 	}
 
-	auto place = make_shared<Place>(placeProperties, m_actionsExecutor);
-	m_places.insert(place);
+	shared_ptr<IActionsExecutor> actionsExecutor = m_actionsExecutor;
+	if (!placeProperties.executorLane.empty())
+	{
+		if (!m_executorLanes.contains(placeProperties.executorLane))
+		{
+			throw PTN_Exception("The executor lane is not yet registered: " + placeProperties.executorLane + ".");
+		}
+		actionsExecutor = m_executorLanes.getItem(placeProperties.executorLane);
+	}
+
+	auto place = make_shared<Place>(placeProperties, actionsExecutor, m_actionsInExecution);
+	return PlaceHandle{ .index = m_places.insert(place) };
 }
 
 bool PTN_EngineImp::isEventLoopRunning() const
@@ -96,26 +169,264 @@ void PTN_EngineImp::stop() noexcept
 
 void PTN_EngineImp::registerAction(const string &name, const ActionFunction &action)
 {
+	if (m_batchActions.contains(name) || m_asyncActions.contains(name))
+	{
+		throw RepeatedFunctionException(name);
+	}
 	m_actions.addItem(name, action);
 }
 
+void PTN_EngineImp::registerBatchAction(const string &name, const BatchActionFunction &action)
+{
+	if (m_actions.contains(name) || m_asyncActions.contains(name))
+	{
+		throw RepeatedFunctionException(name);
+	}
+	m_batchActions.addItem(name, action);
+}
+
+void PTN_EngineImp::registerAsyncAction(const string &name, const AsyncActionFunction &action)
+{
+	if (m_actions.contains(name) || m_batchActions.contains(name))
+	{
+		throw RepeatedFunctionException(name);
+	}
+	m_asyncActions.addItem(name, action);
+}
+
 void PTN_EngineImp::registerCondition(const string &name, const ConditionFunction &condition)
 {
 	m_conditions.addItem(name, condition);
 }
 
+void PTN_EngineImp::registerExecutorLane(const string &name, shared_ptr<IActionsExecutor> executor)
+{
+	if (executor == nullptr)
+	{
+		throw PTN_Exception("The executor of a lane must not be null.");
+	}
+	if (m_executorLanes.contains(name))
+	{
+		throw PTN_Exception("Trying to add an already existing executor lane: " + name + ".");
+	}
+	m_executorLanes.addItem(name, move(executor));
+}
+
 size_t PTN_EngineImp::getNumberOfTokens(const string &place) const
 {
+	if (m_frozenNet)
+	{
+		return m_frozenNet->getNumberOfTokens(place);
+	}
 	return m_places.getNumberOfTokens(place);
 }
 
+size_t PTN_EngineImp::getNumberOfTokens(const PlaceHandle place) const
+{
+	if (m_frozenNet)
+	{
+		return m_frozenNet->getNumberOfTokens(place.index);
+	}
+	return m_places.getNumberOfTokens(place.index);
+}
+
+size_t PTN_EngineImp::getNumberOfCoalescedActions(const string &place) const
+{
+	return m_places.getPlace(place)->getNumberOfCoalescedActions();
+}
+
+PlaceHandle PTN_EngineImp::getPlaceHandle(const string &place) const
+{
+	return PlaceHandle{ .index = m_places.getPlaceIndex(place) };
+}
+
+TransitionHandle PTN_EngineImp::getTransitionHandle(const string &transition) const
+{
+	return TransitionHandle{ .index = m_transitions.getTransitionIndex(transition) };
+}
+
 void PTN_EngineImp::incrementInputPlace(const string &place)
 {
-	m_places.incrementInputPlace(place);
-	m_newInputReceived = true;
+	incrementInputPlace(place, 1);
+}
+
+void PTN_EngineImp::incrementInputPlace(const PlaceHandle place)
+{
+	incrementInputPlace(place, 1);
+}
+
+void PTN_EngineImp::incrementInputPlace(const string &place, const size_t count)
+{
+	if (queueInput(place, count))
+	{
+		return;
+	}
+	if (m_frozenNet)
+	{
+		m_frozenNet->incrementInputPlace(place, count);
+	}
+	else
+	{
+		m_transitions.markDirty(*m_places.incrementInputPlace(place, count));
+	}
+	notifyNewInput();
+}
+
+void PTN_EngineImp::incrementInputPlace(const PlaceHandle place, const size_t count)
+{
+	if (queueInput(place, count))
+	{
+		return;
+	}
+	if (m_frozenNet)
+	{
+		m_frozenNet->incrementInputPlace(place.index, count);
+	}
+	else
+	{
+		m_transitions.markDirty(*m_places.incrementInputPlace(place.index, count));
+	}
+	notifyNewInput();
+}
+
+void PTN_EngineImp::incrementInputPlace(span<const pair<string, size_t>> increments)
+{
+	vector<pair<PlaceHandle, size_t>> handleIncrements;
+	handleIncrements.reserve(increments.size());
+	for (const auto &[place, count] : increments)
+	{
+		handleIncrements.emplace_back(getPlaceHandle(place), count);
+	}
+	incrementInputPlace(handleIncrements);
+}
+
+void PTN_EngineImp::incrementInputPlace(span<const pair<PlaceHandle, size_t>> increments)
+{
+	if (increments.empty())
+	{
+		return;
+	}
+	addInputTokens(increments);
+	notifyNewInput();
+}
+
+void PTN_EngineImp::addInputTokens(span<const pair<PlaceHandle, size_t>> increments)
+{
+	if (m_frozenNet)
+	{
+		m_frozenNet->incrementInputPlaces(increments);
+		return;
+	}
+	for (const auto &place : m_places.incrementInputPlaces(increments))
+	{
+		m_transitions.markDirty(*place);
+	}
+}
+
+bool PTN_EngineImp::queueInput(const string &place, const size_t count)
+{
+	const shared_ptr<InputQueue> inputQueue = m_inputQueue.load();
+	if (!inputQueue)
+	{
+		return false;
+	}
+	pushInput(*inputQueue, getPlaceHandle(place), count);
+	return true;
+}
+
+bool PTN_EngineImp::queueInput(const PlaceHandle place, const size_t count)
+{
+	const shared_ptr<InputQueue> inputQueue = m_inputQueue.load();
+	if (!inputQueue)
+	{
+		return false;
+	}
+	pushInput(*inputQueue, place, count);
+	return true;
+}
+
+void PTN_EngineImp::pushInput(InputQueue &inputQueue, const PlaceHandle place, const size_t count)
+{
+	if (count == 0)
+	{
+		throw NullTokensException();
+	}
+	m_places.checkInputPlace(place.index);
+	if (!inputQueue.push({ .place = place.index, .count = count }))
+	{
+		throw InputQueueFullException();
+	}
 	m_eventLoop.notifyNewEvent();
 }
 
+shared_ptr<InputQueue> PTN_EngineImp::replaceInputQueue(shared_ptr<InputQueue> inputQueue)
+{
+	shared_ptr<InputQueue> oldInputQueue = m_inputQueue.exchange(move(inputQueue));
+	// Producers can no longer load the old queue and only hold it while pushing an increment.
+	while (oldInputQueue && oldInputQueue.use_count() > 1)
+	{
+		this_thread::yield();
+	}
+	// Pairs with the release of the producers' references, making their pushes visible.
+	atomic_thread_fence(memory_order_acquire);
+	return oldInputQueue;
+}
+
+void PTN_EngineImp::drainInputQueue()
+{
+	if (const shared_ptr<InputQueue> inputQueue = m_inputQueue.load())
+	{
+		drainInputQueue(*inputQueue);
+	}
+}
+
+void PTN_EngineImp::drainInputQueue(InputQueue &inputQueue)
+{
+	m_queuedInputs.clear();
+	InputQueue::Input input;
+	while (inputQueue.pop(input))
+	{
+		m_queuedInputs.emplace_back(PlaceHandle{ .index = input.place }, input.count);
+	}
+	if (!m_queuedInputs.empty())
+	{
+		addInputTokens(m_queuedInputs);
+	}
+}
+
+void PTN_EngineImp::discardInputQueue()
+{
+	// The increments of producers part-way through a push are discarded with the old queue.
+	if (const size_t capacity = getInputQueueCapacity(); capacity != 0)
+	{
+		replaceInputQueue(make_shared<InputQueue>(capacity));
+	}
+}
+
+void PTN_EngineImp::setInputQueueCapacity(const size_t capacity)
+{
+	if (isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot change the input queue while the event loop is running.");
+	}
+	if (getInputQueueCapacity() == capacity)
+	{
+		return;
+	}
+	// Tokens queued before the change, even by producers racing with it, are not lost.
+	if (const shared_ptr<InputQueue> oldInputQueue =
+			replaceInputQueue(capacity == 0 ? nullptr : make_shared<InputQueue>(capacity)))
+	{
+		drainInputQueue(*oldInputQueue);
+	}
+}
+
+size_t PTN_EngineImp::getInputQueueCapacity() const
+{
+	const shared_ptr<InputQueue> inputQueue = m_inputQueue.load();
+	return inputQueue ? inputQueue->getCapacity() : 0;
+}
+
 void PTN_EngineImp::setActionsThreadOption(const PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption)
 {
 	if (isEventLoopRunning())
@@ -129,21 +440,136 @@ void PTN_EngineImp::setActionsThreadOption(const PTN_Engine::ACTIONS_THREAD_OPTI
 	{
 		return;
 	}
+	if (actionsThreadOption == CUSTOM)
+	{
+		throw PTN_Exception("The executor of the CUSTOM actions thread option is given on construction.");
+	}
 
-	m_actionsExecutor = ActionsExecutorFactory::createExecutor(actionsThreadOption);
 	m_actionsThreadOption = actionsThreadOption;
+	recreateActionsExecutor();
+}
+
+void PTN_EngineImp::recreateActionsExecutor()
+{
+	m_actionsExecutor = ActionsExecutorFactory::createExecutor(m_actionsThreadOption, m_executorOptions);
+	m_actionsExecutor->setThreadScheduling(m_jobQueueThreadScheduling);
 
 	m_places.setActionsExecutor(m_actionsExecutor);
 }
 
+void PTN_EngineImp::setNumberOfActionThreads(const size_t numberOfActionThreads)
+{
+	if (numberOfActionThreads == 0)
+	{
+		throw PTN_Exception("The number of action threads must be at least 1.");
+	}
+	if (isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot change the number of action threads while the event loop is running.");
+	}
+
+	unique_lock actionsThreadOptionGuard(m_actionsThreadOptionMutex);
+
+	if (m_executorOptions.numberOfActionThreads == numberOfActionThreads)
+	{
+		return;
+	}
+
+	m_executorOptions.numberOfActionThreads = numberOfActionThreads;
+	if (m_actionsThreadOption == THREAD_POOL)
+	{
+		recreateActionsExecutor();
+	}
+}
+
+size_t PTN_EngineImp::getNumberOfActionThreads() const
+{
+	shared_lock actionsThreadOptionGuard(m_actionsThreadOptionMutex);
+	return m_executorOptions.numberOfActionThreads;
+}
+
+void PTN_EngineImp::setInlineActionThreshold(const chrono::nanoseconds inlineActionThreshold)
+{
+	if (isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot change the inline action threshold while the event loop is running.");
+	}
+
+	unique_lock actionsThreadOptionGuard(m_actionsThreadOptionMutex);
+
+	if (m_executorOptions.inlineActionThreshold == inlineActionThreshold)
+	{
+		return;
+	}
+
+	m_executorOptions.inlineActionThreshold = inlineActionThreshold;
+	if (m_actionsThreadOption == ADAPTIVE)
+	{
+		recreateActionsExecutor();
+	}
+}
+
+chrono::nanoseconds PTN_EngineImp::getInlineActionThreshold() const
+{
+	shared_lock actionsThreadOptionGuard(m_actionsThreadOptionMutex);
+	return m_executorOptions.inlineActionThreshold;
+}
+
+void PTN_EngineImp::setJobQueueCapacity(const size_t capacity,
+										const PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY overflowPolicy)
+{
+	if (isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot change the job queue capacity while the event loop is running.");
+	}
+
+	unique_lock actionsThreadOptionGuard(m_actionsThreadOptionMutex);
+
+	m_executorOptions.jobQueueCapacity = capacity;
+	m_executorOptions.jobQueueOverflowPolicy = overflowPolicy;
+	if (m_actionsThreadOption == JOB_QUEUE || m_actionsThreadOption == ADAPTIVE)
+	{
+		recreateActionsExecutor();
+	}
+}
+
+size_t PTN_EngineImp::getJobQueueCapacity() const
+{
+	shared_lock actionsThreadOptionGuard(m_actionsThreadOptionMutex);
+	const size_t capacity = m_executorOptions.jobQueueCapacity;
+	return capacity == 0 ? 0 : bit_ceil(max<size_t>(capacity, 2));
+}
+
+PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY PTN_EngineImp::getJobQueueOverflowPolicy() const
+{
+	shared_lock actionsThreadOptionGuard(m_actionsThreadOptionMutex);
+	return m_executorOptions.jobQueueOverflowPolicy;
+}
+
+JobQueueMetrics PTN_EngineImp::getJobQueueMetrics() const
+{
+	shared_lock actionsThreadOptionGuard(m_actionsThreadOptionMutex);
+	return m_actionsExecutor->getJobQueueMetrics();
+}
+
 PTN_Engine::ACTIONS_THREAD_OPTION PTN_EngineImp::getActionsThreadOption() const
 {
 	shared_lock actionsThreadOptionGuard(m_actionsThreadOptionMutex);
 	return m_actionsThreadOption;
 }
 
+PTN_Engine::CONFLICT_RESOLUTION_POLICY PTN_EngineImp::getConflictResolutionPolicy() const
+{
+	return m_conflictResolutionPolicy;
+}
+
 void PTN_EngineImp::printState(ostream &o) const
 {
+	if (m_frozenNet)
+	{
+		m_frozenNet->printState(o);
+		return;
+	}
 	m_places.printState(o);
 }
 
@@ -152,21 +578,74 @@ void PTN_EngineImp::execute(const bool log, ostream &o)
 	m_eventLoop.start(log, o);
 }
 
+void PTN_EngineImp::freeze()
+{
+	if (isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot freeze the net while the event loop is running.");
+	}
+	if (m_frozenNet)
+	{
+		return;
+	}
+	auto frozenNet = make_unique<FrozenNet>(m_places.getAllPlaces(), m_transitions.getAllTransitions(),
+											m_transitions.getConflictResolver());
+	frozenNet->setNumberOfFiringThreads(m_numberOfFiringThreads);
+	m_frozenNet = move(frozenNet);
+}
+
+void PTN_EngineImp::thaw()
+{
+	if (isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot thaw the net while the event loop is running.");
+	}
+	if (!m_frozenNet)
+	{
+		return;
+	}
+	m_frozenNet->thaw();
+	m_frozenNet.reset();
+	m_transitions.markAllDirty();
+}
+
+bool PTN_EngineImp::isFrozen() const
+{
+	return m_frozenNet != nullptr;
+}
+
 bool PTN_EngineImp::executeInt(const bool log, ostream &o)
 {
 	bool firedAtLeastOneTransition = false;
 	setNewInputReceived(false);
+	drainInputQueue();
+	for (const Place *place : m_actionsInExecution->takeCompletedPlaces())
+	{
+		m_transitions.markDirty(*place);
+	}
 
 	if (log)
 	{
 		printState(o);
 	}
 
+	if (m_frozenNet)
+	{
+		return m_frozenNet->execute(m_multiFiring, m_maximalStepFiring);
+	}
+
+	const size_t maxFirings = m_multiFiring ? numeric_limits<size_t>::max() : 1;
+	if (m_maximalStepFiring)
+	{
+		return executeStep(maxFirings);
+	}
+
 	for (const auto &transition : enabledTransitions())
 	{
-		if (auto enabledTransition = lockWeakPtr(transition))
+		if (auto enabledTransition = lockWeakPtr(transition); enabledTransition->execute(maxFirings) > 0)
 		{
-			firedAtLeastOneTransition |= enabledTransition->execute();
+			m_transitions.markDirty(*enabledTransition);
+			firedAtLeastOneTransition = true;
 		}
 	}
 	return firedAtLeastOneTransition;
@@ -174,15 +653,25 @@ bool PTN_EngineImp::executeInt(const bool log, ostream &o)
 
 bool PTN_EngineImp::getNewInputReceived() const
 {
+	if (const shared_ptr<InputQueue> inputQueue = m_inputQueue.load(); inputQueue && !inputQueue->empty())
+	{
+		return true;
+	}
 	return m_newInputReceived;
 }
 
+void PTN_EngineImp::notifyNewInput()
+{
+	m_newInputReceived = true;
+	m_eventLoop.notifyNewEvent();
+}
+
 void PTN_EngineImp::setNewInputReceived(const bool newInputReceived)
 {
 	m_newInputReceived = newInputReceived;
 }
 
-vector<weak_ptr<Transition>> PTN_EngineImp::enabledTransitions() const
+vector<weak_ptr<Transition>> PTN_EngineImp::enabledTransitions()
 {
 	return m_transitions.collectEnabledTransitionsRandomly();
 }
@@ -197,12 +686,120 @@ PTN_Engine::EventLoopSleepDuration PTN_EngineImp::getEventLoopSleepDuration() co
 	return m_eventLoop.getSleepDuration();
 }
 
-void PTN_EngineImp::addArc(const ArcProperties &arcProperties) const
+void PTN_EngineImp::setEventLoopSpinDuration(const PTN_Engine::EventLoopSpinDuration spinDuration)
 {
-	if (isEventLoopRunning())
+	m_eventLoop.setSpinDuration(spinDuration);
+}
+
+PTN_Engine::EventLoopSpinDuration PTN_EngineImp::getEventLoopSpinDuration() const
+{
+	return m_eventLoop.getSpinDuration();
+}
+
+void PTN_EngineImp::setEventLoopWatchdogEnabled(const bool watchdogEnabled)
+{
+	m_eventLoop.setWatchdogEnabled(watchdogEnabled);
+}
+
+bool PTN_EngineImp::isEventLoopWatchdogEnabled() const
+{
+	return m_eventLoop.isWatchdogEnabled();
+}
+
+void PTN_EngineImp::setEventLoopBusyPolling(const bool busyPolling)
+{
+	m_eventLoop.setBusyPolling(busyPolling);
+}
+
+bool PTN_EngineImp::isEventLoopBusyPolling() const
+{
+	return m_eventLoop.isBusyPolling();
+}
+
+void PTN_EngineImp::setEngineScheduler(shared_ptr<EngineScheduler> engineScheduler)
+{
+	m_eventLoop.setEngineScheduler(std::move(engineScheduler));
+}
+
+shared_ptr<EngineScheduler> PTN_EngineImp::getEngineScheduler() const
+{
+	return m_eventLoop.getEngineScheduler();
+}
+
+void PTN_EngineImp::setEventLoopThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	m_eventLoop.setThreadScheduling(threadScheduling);
+}
+
+ThreadScheduling PTN_EngineImp::getEventLoopThreadScheduling() const
+{
+	return m_eventLoop.getThreadScheduling();
+}
+
+void PTN_EngineImp::setJobQueueThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	utility::checkThreadScheduling(threadScheduling);
+	unique_lock actionsThreadOptionGuard(m_actionsThreadOptionMutex);
+	// A custom executor may be shared, its threads are scheduled by its owner.
+	if (m_actionsThreadOption != CUSTOM)
 	{
-		throw PTN_Exception("Cannot add arc while the event loop is running.");
+		m_actionsExecutor->setThreadScheduling(threadScheduling);
 	}
+	m_jobQueueThreadScheduling = threadScheduling;
+}
+
+ThreadScheduling PTN_EngineImp::getJobQueueThreadScheduling() const
+{
+	shared_lock actionsThreadOptionGuard(m_actionsThreadOptionMutex);
+	return m_jobQueueThreadScheduling;
+}
+
+void PTN_EngineImp::notifyConditionsChanged()
+{
+	m_eventLoop.notifyNewEvent();
+}
+
+void PTN_EngineImp::setMaximalStepFiring(const bool maximalStepFiring)
+{
+	m_maximalStepFiring = maximalStepFiring;
+}
+
+bool PTN_EngineImp::isMaximalStepFiring() const
+{
+	return m_maximalStepFiring;
+}
+
+void PTN_EngineImp::setMultiFiring(const bool multiFiring)
+{
+	m_multiFiring = multiFiring;
+}
+
+bool PTN_EngineImp::isMultiFiring() const
+{
+	return m_multiFiring;
+}
+
+void PTN_EngineImp::setNumberOfFiringThreads(const size_t numberOfFiringThreads)
+{
+	if (numberOfFiringThreads == 0)
+	{
+		throw PTN_Exception("The number of firing threads must be at least 1.");
+	}
+	if (m_frozenNet)
+	{
+		m_frozenNet->setNumberOfFiringThreads(numberOfFiringThreads);
+	}
+	m_numberOfFiringThreads = numberOfFiringThreads;
+}
+
+size_t PTN_EngineImp::getNumberOfFiringThreads() const
+{
+	return m_numberOfFiringThreads;
+}
+
+void PTN_EngineImp::addArc(const ArcProperties &arcProperties)
+{
+	throwIfStructureLocked("add arc");
 
 	if (!m_places.contains(arcProperties.placeName))
 	{
@@ -217,16 +814,21 @@ void PTN_EngineImp::addArc(const ArcProperties &arcProperties) const
 							" must already exist in order to link to an arc.");
 	}
 
-	auto spTransition = m_transitions.getTransition(arcProperties.transitionName);
-	spTransition->addArc(spPlace, arcProperties.type, arcProperties.weight);
+	m_transitions.addArc(arcProperties.transitionName, spPlace, arcProperties.type, arcProperties.weight);
 }
 
-void PTN_EngineImp::removeArc(const ArcProperties &arcProperties) const
+void PTN_EngineImp::addArc(const PlaceHandle place,
+						   const TransitionHandle transition,
+						   const ArcProperties::Type type,
+						   const size_t weight)
 {
-	if (isEventLoopRunning())
-	{
-		throw PTN_Exception("Cannot remove arc while the event loop is running.");
-	}
+	throwIfStructureLocked("add arc");
+	m_transitions.addArc(transition.index, m_places.getPlace(place.index), type, weight);
+}
+
+void PTN_EngineImp::removeArc(const ArcProperties &arcProperties)
+{
+	throwIfStructureLocked("remove arc");
 
 	if (!m_places.contains(arcProperties.placeName))
 	{
@@ -241,12 +843,23 @@ void PTN_EngineImp::removeArc(const ArcProperties &arcProperties) const
 							" must already exist in order to unlink an arc.");
 	}
 
-	auto spTransition = m_transitions.getTransition(arcProperties.transitionName);
-	spTransition->removeArc(spPlace, arcProperties.type);
+	m_transitions.removeArc(arcProperties.transitionName, spPlace, arcProperties.type);
+}
+
+void PTN_EngineImp::removeArc(const PlaceHandle place,
+							  const TransitionHandle transition,
+							  const ArcProperties::Type type)
+{
+	throwIfStructureLocked("remove arc");
+	m_transitions.removeArc(transition.index, m_places.getPlace(place.index), type);
 }
 
 vector<PlaceProperties> PTN_EngineImp::getPlacesProperties() const
 {
+	if (m_frozenNet)
+	{
+		return m_frozenNet->getPlacesProperties();
+	}
 	return m_places.getPlacesProperties();
 }
 
@@ -257,12 +870,54 @@ vector<TransitionProperties> PTN_EngineImp::getTransitionsProperties() const
 
 // Private
 
-void PTN_EngineImp::createTransition(const string &name,
-                                     const vector<ArcProperties> &activationArcs,
-                                     const vector<ArcProperties> &destinationArcs,
-                                     const vector<ArcProperties> &inhibitorArcs,
-                                     const vector<pair<string, ConditionFunction>> &additionalConditions,
-                                     const bool requireNoActionsInExecution)
+bool PTN_EngineImp::executeStep(const size_t maxFirings)
+{
+	// All transitions consume their tokens before any tokens are produced, so tokens produced in this step
+	// can only be used in the next one.
+	m_stepFirings.clear();
+	const auto transitions = enabledTransitions();
+	for (size_t i = 0; i < transitions.size(); ++i)
+	{
+		// A transition that does not share its activation places keeps the marking it was found enabled with.
+		// Only conflicting transitions need their marking to be checked again.
+		const bool markingChecked = !m_transitions.enabledTransitionHasConflicts(i);
+		auto enabledTransition = lockWeakPtr(transitions[i]);
+		if (const size_t firings = enabledTransition->consumeTokens(maxFirings, markingChecked); firings > 0)
+		{
+			m_stepFirings.emplace_back(move(enabledTransition), firings);
+		}
+	}
+
+	for (const auto &[transition, firings] : m_stepFirings)
+	{
+		transition->produceTokens(firings);
+		m_transitions.markDirty(*transition);
+	}
+	const bool firedAtLeastOneTransition = !m_stepFirings.empty();
+	// Does not keep the transitions alive until the next step.
+	m_stepFirings.clear();
+	return firedAtLeastOneTransition;
+}
+
+void PTN_EngineImp::throwIfStructureLocked(const string &operation) const
+{
+	if (isEventLoopRunning())
+	{
+		throw PTN_Exception("Cannot " + operation + " while the event loop is running.");
+	}
+	if (m_frozenNet)
+	{
+		throw PTN_Exception("Cannot " + operation + " while the net is frozen. Call thaw first.");
+	}
+}
+
+TransitionHandle PTN_EngineImp::createTransition(const string &name,
+                                                 const vector<ArcProperties> &activationArcs,
+                                                 const vector<ArcProperties> &destinationArcs,
+                                                 const vector<ArcProperties> &inhibitorArcs,
+                                                 const vector<pair<string, ConditionFunction>> &additionalConditions,
+                                                 const bool requireNoActionsInExecution,
+                                                 const size_t priority)
 {
 	// if a transition with this name already exists in the net, throw an exception
 	if (m_transitions.contains(name))
@@ -280,10 +935,11 @@ void PTN_EngineImp::createTransition(const string &name,
 		return arcs;
 	};
 
-	m_transitions.insert(make_shared<Transition>(name, getArcsFromArcsProperties(activationArcs),
-												 getArcsFromArcsProperties(destinationArcs),
-												 getArcsFromArcsProperties(inhibitorArcs), additionalConditions,
-												 requireNoActionsInExecution));
+	const size_t index = m_transitions.insert(
+	make_shared<Transition>(name, getArcsFromArcsProperties(activationArcs), getArcsFromArcsProperties(destinationArcs),
+							getArcsFromArcsProperties(inhibitorArcs), additionalConditions, requireNoActionsInExecution,
+							priority));
+	return TransitionHandle{ .index = index };
 }
 
 vector<pair<string, ConditionFunction>>
@@ -21,13 +21,17 @@
 #pragma once
 
 #include "PTN_Engine/EventLoop.h"
+#include "PTN_Engine/Executor/ActionsExecutorFactory.h"
+#include "PTN_Engine/FrozenNet.h"
 #include "PTN_Engine/IPTN_EngineEL.h"
+#include "PTN_Engine/InputQueue.h"
 #include "PTN_Engine/ManagedContainer.h"
 #include "PTN_Engine/PTN_Engine.h"
 #include "PTN_Engine/Place.h"
 #include "PTN_Engine/PlacesManager.h"
 #include "PTN_Engine/TransitionsManager.h"
 #include <atomic>
+#include <memory>
 #include <shared_mutex>
 
 namespace ptne
@@ -49,7 +53,21 @@ class PTN_EngineImp final : public IPTN_EngineEL
 {
 public:
 	~PTN_EngineImp() override;
-	explicit PTN_EngineImp(PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption);
+	explicit PTN_EngineImp(PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption,
+						   PTN_Engine::CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy =
+						   PTN_Engine::CONFLICT_RESOLUTION_POLICY::RANDOM,
+						   std::optional<uint64_t> seed = std::nullopt);
+
+	//!
+	//! \brief PTN_EngineImp constructor running the actions on a given executor, possibly shared with other
+	//! engines. The actions thread option is CUSTOM.
+	//! \param actionsExecutor - executor running the actions. Must not be null.
+	//! \param conflictResolutionPolicy - policy deciding the firing order of transitions competing for tokens.
+	//! \param seed - seed of the random conflict resolution policies.
+	//!
+	PTN_EngineImp(std::shared_ptr<IActionsExecutor> actionsExecutor,
+				  PTN_Engine::CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy,
+				  std::optional<uint64_t> seed);
 	PTN_EngineImp(const PTN_EngineImp &) = delete;
 	PTN_EngineImp(PTN_EngineImp &&) = delete;
 	PTN_EngineImp &operator=(const PTN_EngineImp &) = delete;
@@ -57,13 +75,31 @@ public:
 
 	PTN_Engine::ACTIONS_THREAD_OPTION getActionsThreadOption() const override;
 
+	//!
+	//! \brief Get the policy deciding the firing order of transitions competing for tokens.
+	//! \return The conflict resolution policy chosen on construction.
+	//!
+	PTN_Engine::CONFLICT_RESOLUTION_POLICY getConflictResolutionPolicy() const;
+
 	//!
 	//! \brief Indicates if there are new tokens in any input places.
 	//! \return True of there is a new token in an input place.
 	//!
-	bool getNewInputReceived() const override;
+	bool getNewInputReceived() const;
 
-	void addArc(const ArcProperties &arcProperties) const;
+	void addArc(const ArcProperties &arcProperties);
+
+	//!
+	//! \brief Add an arc between a place and a transition identified by their handles.
+	//! \param place - handle of the place.
+	//! \param transition - handle of the transition.
+	//! \param type - the type of arc.
+	//! \param weight - the weight of the arc.
+	//!
+	void addArc(const PlaceHandle place,
+				const TransitionHandle transition,
+				const ArcProperties::Type type,
+				const size_t weight);
 
 	//!
 	//! Clear the token counter from all input places.
@@ -72,15 +108,22 @@ public:
 
 	void clearNet();
 
-	void createPlace(PlaceProperties placeProperties);
+	PlaceHandle createPlace(PlaceProperties placeProperties);
 
-	void createTransition(const TransitionProperties &transitionProperties);
+	TransitionHandle createTransition(const TransitionProperties &transitionProperties);
 
 	//!
 	//! \brief Gets the transitions that are currently enabled.
+	//! Only the transitions depending on places whose tokens changed are re-evaluated.
 	//! \return Weak pointers to the transitions that are enabled.
 	//!
-	std::vector<std::weak_ptr<Transition>> enabledTransitions() const;
+	std::vector<std::weak_ptr<Transition>> enabledTransitions();
+
+	//!
+	//! \brief Compile the net into a flat representation used for firing, until thaw is called.
+	//! Structural changes are not allowed while the net is frozen.
+	//!
+	void freeze();
 
 	//!
 	//! Start the petri net event loop.
@@ -95,6 +138,47 @@ public:
 	//!
 	PTN_Engine::EventLoopSleepDuration getEventLoopSleepDuration() const;
 
+	//!
+	//! \brief Gets the maximum time the event loop spins before parking.
+	//! \return The spin duration of the event loop.
+	//!
+	PTN_Engine::EventLoopSpinDuration getEventLoopSpinDuration() const;
+
+	//!
+	//! \brief Tells if the parked event loop also wakes up once per sleep duration.
+	//! \return True if the watchdog is enabled.
+	//!
+	bool isEventLoopWatchdogEnabled() const;
+
+	//!
+	//! \brief Tells if the waiting event loop busy polls instead of parking.
+	//! \return True if busy polling.
+	//!
+	bool isEventLoopBusyPolling() const;
+
+	//!
+	//! \brief Gets the scheduler driving the engine, if any.
+	//! \return The engine scheduler, or nullptr if the engine runs its own event loop thread.
+	//!
+	std::shared_ptr<EngineScheduler> getEngineScheduler() const;
+
+	//!
+	//! \brief Gets the core pinning and priority of the event loop thread.
+	//! \return The scheduling of the event loop thread.
+	//!
+	ThreadScheduling getEventLoopThreadScheduling() const;
+
+	//!
+	//! \brief Gets the core pinning and priority of the job queue worker threads.
+	//! \return The scheduling of the job queue worker threads.
+	//!
+	ThreadScheduling getJobQueueThreadScheduling() const;
+
+	//!
+	//! \brief Wake up the event loop, because the results of additional conditions may have changed.
+	//!
+	void notifyConditionsChanged();
+
 	//!
 	//! Return the number of tokens in a given place.
 	//! \param place The name of the place to get the number of tokens from.
@@ -102,6 +186,34 @@ public:
 	//!
 	size_t getNumberOfTokens(const std::string &place) const;
 
+	//!
+	//! Return the number of tokens in a given place.
+	//! \param place Handle of the place to get the number of tokens from.
+	//! \return The number of tokens present in the place.
+	//!
+	size_t getNumberOfTokens(const PlaceHandle place) const;
+
+	//!
+	//! Return how many invocations of the actions of a place were folded into a queued one.
+	//! \param place The name of the place.
+	//! \return The number of coalesced invocations.
+	//!
+	size_t getNumberOfCoalescedActions(const std::string &place) const;
+
+	//!
+	//! \brief Look up the handle of a place.
+	//! \param place - name of the place.
+	//! \return Handle identifying the place.
+	//!
+	PlaceHandle getPlaceHandle(const std::string &place) const;
+
+	//!
+	//! \brief Look up the handle of a transition.
+	//! \param transition - name of the transition.
+	//! \return Handle identifying the transition.
+	//!
+	TransitionHandle getTransitionHandle(const std::string &transition) const;
+
 	std::vector<PlaceProperties> getPlacesProperties() const;
 
 	std::vector<TransitionProperties> getTransitionsProperties() const;
@@ -112,8 +224,46 @@ public:
 	//!
 	void incrementInputPlace(const std::string &place);
 
+	//!
+	//! Add a token in an input place.
+	//! \param place Handle of the place to be incremented.
+	//!
+	void incrementInputPlace(const PlaceHandle place);
+
+	//!
+	//! Add tokens in an input place.
+	//! \param place Name of the place to be incremented.
+	//! \param count Number of tokens to add.
+	//!
+	void incrementInputPlace(const std::string &place, const size_t count);
+
+	//!
+	//! Add tokens in an input place.
+	//! \param place Handle of the place to be incremented.
+	//! \param count Number of tokens to add.
+	//!
+	void incrementInputPlace(const PlaceHandle place, const size_t count);
+
+	//!
+	//! Add tokens in several input places, validating all increments before changing any place.
+	//! \param increments Pairs of place name and number of tokens to add.
+	//!
+	void incrementInputPlace(std::span<const std::pair<std::string, size_t>> increments);
+
+	//!
+	//! Add tokens in several input places, validating all increments before changing any place.
+	//! \param increments Pairs of place handle and number of tokens to add.
+	//!
+	void incrementInputPlace(std::span<const std::pair<PlaceHandle, size_t>> increments);
+
 	bool isEventLoopRunning() const;
 
+	//!
+	//! \brief Whether the net is frozen or not.
+	//! \return True if the net is frozen.
+	//!
+	bool isFrozen() const;
+
 	//!
 	//! Print the petri net places and number of tokens.
 	//! \param o Output stream.
@@ -127,6 +277,20 @@ public:
 	//!
 	void registerAction(const std::string &name, const ActionFunction &action);
 
+	//!
+	//! Register a batch action to be called by the Petri net with the number of tokens.
+	//! \param name The name of the action, unique among all actions.
+	//! \param action The function to be called with the number of tokens that entered or left the place.
+	//!
+	void registerBatchAction(const std::string &name, const BatchActionFunction &action);
+
+	//!
+	//! Register a coroutine action to be started by the Petri net.
+	//! \param name The name of the action, unique among all actions.
+	//! \param action The function creating the coroutine.
+	//!
+	void registerAsyncAction(const std::string &name, const AsyncActionFunction &action);
+
 	//!
 	//! Register a condition
 	//! \param name The name of the condition
@@ -134,7 +298,22 @@ public:
 	//!
 	void registerCondition(const std::string &name, const ConditionFunction &condition);
 
-	void removeArc(const ArcProperties &arcProperties) const;
+	//!
+	//! Register an executor lane, on which places can run their actions instead of the actions executor.
+	//! \param name The name of the lane.
+	//! \param executor Executor running the actions of the places on the lane. Must not be null.
+	//!
+	void registerExecutorLane(const std::string &name, std::shared_ptr<IActionsExecutor> executor);
+
+	void removeArc(const ArcProperties &arcProperties);
+
+	//!
+	//! \brief Remove an arc between a place and a transition identified by their handles.
+	//! \param place - handle of the place.
+	//! \param transition - handle of the transition.
+	//! \param type - the type of arc.
+	//!
+	void removeArc(const PlaceHandle place, const TransitionHandle transition, const ArcProperties::Type type);
 
 	//! Specify the thread where the actions should be run.
 	void setActionsThreadOption(const PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption);
@@ -145,11 +324,170 @@ public:
 	//!
 	void setEventLoopSleepDuration(const PTN_Engine::EventLoopSleepDuration sleepDuration);
 
+	//!
+	//! \brief Set the maximum time the event loop spins, waiting for an event, before parking.
+	//! \param spinDuration - 0 to park immediately.
+	//!
+	void setEventLoopSpinDuration(const PTN_Engine::EventLoopSpinDuration spinDuration);
+
+	//!
+	//! \brief Enable or disable waking up the parked event loop once per sleep duration.
+	//! \param watchdogEnabled - false to only wake up when notified.
+	//!
+	void setEventLoopWatchdogEnabled(const bool watchdogEnabled);
+
+	//!
+	//! \brief Enable or disable busy polling, the waiting event loop spinning until notified and never parking.
+	//! \param busyPolling - true to busy poll.
+	//!
+	void setEventLoopBusyPolling(const bool busyPolling);
+
+	//!
+	//! \brief Set the scheduler that drives the engine instead of a dedicated event loop thread.
+	//! \param engineScheduler - shared scheduler, or nullptr to use a dedicated event loop thread.
+	//!
+	void setEngineScheduler(std::shared_ptr<EngineScheduler> engineScheduler);
+
+	//!
+	//! \brief Set the core pinning and priority of the event loop thread, applied when it starts.
+	//! \param threadScheduling - scheduling of the event loop thread.
+	//!
+	void setEventLoopThreadScheduling(const ThreadScheduling &threadScheduling);
+
+	//!
+	//! \brief Set the core pinning and priority of the job queue worker threads.
+	//! \param threadScheduling - scheduling of the job queue worker threads.
+	//!
+	void setJobQueueThreadScheduling(const ThreadScheduling &threadScheduling);
+
+	//!
+	//! \brief Enable or disable firing all enabled transitions of a cycle as one step.
+	//! \param maximalStepFiring - true to produce tokens only after all fired transitions consumed theirs.
+	//!
+	void setMaximalStepFiring(const bool maximalStepFiring);
+
+	//!
+	//! \brief Whether all enabled transitions of a cycle are fired as one step.
+	//! \return True if maximal step firing is enabled.
+	//!
+	bool isMaximalStepFiring() const;
+
+	//!
+	//! \brief Enable or disable firing transitions by their enabling degree.
+	//! \param multiFiring - true to fire each transition as many times as its activation places allow.
+	//!
+	void setMultiFiring(const bool multiFiring);
+
+	//!
+	//! \brief Whether transitions are fired by their enabling degree.
+	//! \return True if multi-firing is enabled.
+	//!
+	bool isMultiFiring() const;
+
+	//!
+	//! \brief Set the number of threads firing independent regions of the net in parallel, while frozen.
+	//! \param numberOfFiringThreads - 1 to fire sequentially, at least 1.
+	//!
+	void setNumberOfFiringThreads(const size_t numberOfFiringThreads);
+
+	//!
+	//! \brief Get the number of threads firing the net while frozen.
+	//! \return The number of threads.
+	//!
+	size_t getNumberOfFiringThreads() const;
+
+	//!
+	//! \brief Set the number of threads running the actions in THREAD_POOL mode.
+	//! \param numberOfActionThreads - at least 1.
+	//!
+	void setNumberOfActionThreads(const size_t numberOfActionThreads);
+
+	//!
+	//! \brief Get the number of threads running the actions in THREAD_POOL mode.
+	//! \return The number of threads.
+	//!
+	size_t getNumberOfActionThreads() const;
+
+	//!
+	//! \brief Set the average duration above which the actions are offloaded in ADAPTIVE mode.
+	//! \param inlineActionThreshold - the threshold.
+	//!
+	void setInlineActionThreshold(const std::chrono::nanoseconds inlineActionThreshold);
+
+	//!
+	//! \brief Get the average duration above which the actions are offloaded in ADAPTIVE mode.
+	//! \return The threshold.
+	//!
+	std::chrono::nanoseconds getInlineActionThreshold() const;
+
+	//!
+	//! \brief Bound the job queue of the JOB_QUEUE and ADAPTIVE modes.
+	//! \param capacity - maximum number of queued actions, 0 for an unbounded job queue.
+	//! \param overflowPolicy - what to do with actions dispatched while the job queue is full.
+	//!
+	void setJobQueueCapacity(const size_t capacity, const PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY overflowPolicy);
+
+	//!
+	//! \brief Get the capacity of the job queue of the JOB_QUEUE mode.
+	//! \return The maximum number of queued actions, 0 if unbounded.
+	//!
+	size_t getJobQueueCapacity() const;
+
+	//!
+	//! \brief Get what happens to actions dispatched while the bounded job queue is full.
+	//! \return The overflow policy.
+	//!
+	PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY getJobQueueOverflowPolicy() const;
+
+	//!
+	//! \brief Get the counters of the job queue dispatching the actions.
+	//! \return The metrics of the job queue, all 0 if the actions are not dispatched through a job queue.
+	//!
+	JobQueueMetrics getJobQueueMetrics() const;
+
+	//!
+	//! \brief Queue the increments of single input places, to be applied by the thread executing the net.
+	//! Can be called concurrently with queueInput, the increments queued in the old queue are added.
+	//! \param capacity - maximum number of pending increments, 0 to add the tokens directly.
+	//!
+	void setInputQueueCapacity(const size_t capacity);
+
+	//!
+	//! \brief Get the capacity of the input queue.
+	//! \return The maximum number of pending increments, 0 if tokens are added directly.
+	//!
+	size_t getInputQueueCapacity() const;
+
+	//!
+	//! \brief Validate an increment and add it to the input queue, if enabled. Can be called without
+	//! synchronization.
+	//! \throws InputQueueFullException
+	//! \param place Name of the place to be incremented.
+	//! \param count Number of tokens to add.
+	//! \return False if the input queue is disabled, in which case the tokens must be added directly.
+	//!
+	bool queueInput(const std::string &place, const size_t count);
+
+	//!
+	//! \brief Validate an increment and add it to the input queue, if enabled. Can be called without
+	//! synchronization.
+	//! \throws InputQueueFullException
+	//! \param place Handle of the place to be incremented.
+	//! \param count Number of tokens to add.
+	//! \return False if the input queue is disabled, in which case the tokens must be added directly.
+	//!
+	bool queueInput(const PlaceHandle place, const size_t count);
+
 	//!
 	//! \brief Stop the execution of the petri net.
 	//!
 	void stop() noexcept;
 
+	//!
+	//! \brief Discard the frozen representation of the net, storing its tokens back in the places.
+	//!
+	void thaw();
+
 private:
 	//!
 	//! \brief Execute the Petri net.
@@ -176,13 +514,80 @@ private:
 	//! \param additionalConditions - boolean functions that provide additional conditions, necessary to fire a
 	//! transition. \param requireNoActionsInExecution - flag that determines if the on enter actions of each
 	//! activation place, must have finished before fireing the transition.
+	//! \param priority - priority over the transitions competing for the same tokens.
+	//! \return Handle identifying the new transition.
 	//!
-	void createTransition(const std::string &name,
+	TransitionHandle createTransition(const std::string &name,
 						  const std::vector<ArcProperties> &activationArcs,
 						  const std::vector<ArcProperties> &destinationArcs,
 						  const std::vector<ArcProperties> &inhibitorArcs,
 						  const std::vector<std::pair<std::string, ConditionFunction>> &additionalConditions,
-						  const bool requireNoActionsInExecution);
+						  const bool requireNoActionsInExecution,
+						  const size_t priority);
+
+	//!
+	//! \brief Fire a maximal set of the enabled transitions as one step.
+	//! \param maxFirings - maximum number of times each transition fires.
+	//! \return True if at least one transition was fired.
+	//!
+	bool executeStep(const size_t maxFirings);
+
+	//!
+	//! \brief Throws if the structure of the net cannot be changed.
+	//! \param operation - Description of the attempted change, used in the exception message.
+	//!
+	void throwIfStructureLocked(const std::string &operation) const;
+
+	//!
+	//! \brief Flag new tokens in input places and wake up the event loop.
+	//!
+	void notifyNewInput();
+
+	//!
+	//! \brief Add tokens in several input places, without notifying the event loop.
+	//! \param increments Pairs of place handle and number of tokens to add.
+	//!
+	void addInputTokens(std::span<const std::pair<PlaceHandle, size_t>> increments);
+
+	//!
+	//! \brief Validate an increment and add it to an input queue, waking up the event loop if it is waiting.
+	//! \throws InputQueueFullException
+	//! \param inputQueue Queue receiving the increment.
+	//! \param place Handle of the place to be incremented.
+	//! \param count Number of tokens to add.
+	//!
+	void pushInput(InputQueue &inputQueue, const PlaceHandle place, const size_t count);
+
+	//!
+	//! \brief Publish a new input queue and wait for the producers still pushing into the old one.
+	//! Must only be called while the event loop is not running.
+	//! \param inputQueue The new queue, nullptr to add the tokens directly.
+	//! \return The old queue, no longer used by any producer.
+	//!
+	std::shared_ptr<InputQueue> replaceInputQueue(std::shared_ptr<InputQueue> inputQueue);
+
+	//!
+	//! \brief Add the tokens of all queued increments. Must only be called by the thread executing the net.
+	//!
+	void drainInputQueue();
+
+	//!
+	//! \brief Add the tokens of all increments queued in an input queue.
+	//! \param inputQueue The queue to drain.
+	//!
+	void drainInputQueue(InputQueue &inputQueue);
+
+	//!
+	//! \brief Discard the queued increments, including those of producers part-way through a push.
+	//! Must only be called while the event loop is not running.
+	//!
+	void discardInputQueue();
+
+	//!
+	//! \brief Replace the actions executor by a new one for the current actions thread option. Must be called
+	//! with m_actionsThreadOptionMutex locked.
+	//!
+	void recreateActionsExecutor();
 
 	//!
 	//! \brief Flags or clears flag of new tokens in input places.
@@ -193,13 +598,31 @@ private:
 	//! Container with all the actions available to this Petri net.
 	ManagedContainer<ActionFunction> m_actions;
 
+	//! Container with all the batch actions available to this Petri net.
+	ManagedContainer<BatchActionFunction> m_batchActions;
+
+	//! Container with all the coroutine actions available to this Petri net.
+	ManagedContainer<AsyncActionFunction> m_asyncActions;
+
+	//! Settings of the actions executor, such as the number of threads in THREAD_POOL mode.
+	ActionsExecutorOptions m_executorOptions;
+
 	//! Executes the actions associated to each place, when tokens enter or exit them.z
 	std::shared_ptr<IActionsExecutor> m_actionsExecutor;
 
+	//! Executors of the lanes places can run their actions on, instead of m_actionsExecutor.
+	ManagedContainer<std::shared_ptr<IActionsExecutor>> m_executorLanes;
+
 	//! Determines how the actions will be executed.
 	PTN_Engine::ACTIONS_THREAD_OPTION m_actionsThreadOption;
 
-	//! Mutex to synchronize m_actionsThreadOption.
+	//! Determines the firing order of transitions competing for tokens.
+	const PTN_Engine::CONFLICT_RESOLUTION_POLICY m_conflictResolutionPolicy;
+
+	//! Core pinning and priority of the job queue worker threads, kept across executor changes.
+	ThreadScheduling m_jobQueueThreadScheduling;
+
+	//! Mutex to synchronize m_actionsThreadOption, m_executorOptions and m_jobQueueThreadScheduling.
 	mutable std::shared_mutex m_actionsThreadOptionMutex;
 
 	//! Conditions that can be used by the Petri net.
@@ -208,9 +631,36 @@ private:
 	//! Loop that processes events and executes the Petri net.
 	EventLoop m_eventLoop;
 
+	//! Counters of the actions in execution of the places and their completion events, which wake up the event
+	//! loop. The notifiers are handed over with each action, so that executors shared among engines wake up
+	//! the right one.
+	const std::shared_ptr<ActionsInExecution> m_actionsInExecution;
+
+	//! Flat representation of the net, used instead of the places and transitions while frozen.
+	std::unique_ptr<FrozenNet> m_frozenNet;
+
+	//! Transitions fired in the current maximal step, with their number of firings. Reused between steps.
+	std::vector<std::pair<SharedPtrTransition, size_t>> m_stepFirings;
+
+	//! Fire all enabled transitions of a cycle as one step.
+	std::atomic<bool> m_maximalStepFiring = false;
+
+	//! Fire transitions by their enabling degree instead of once per cycle.
+	std::atomic<bool> m_multiFiring = false;
+
+	//! Number of threads firing the frozen net.
+	std::atomic<size_t> m_numberOfFiringThreads = 1;
+
 	//! Flag reporting a new input event.
 	std::atomic<bool> m_newInputReceived = false;
 
+	//! Increments of input places waiting to be applied by the thread executing the net, if enabled.
+	//! Producers load it without any lock, so replacing it waits until they release the old one.
+	std::atomic<std::shared_ptr<InputQueue>> m_inputQueue;
+
+	//! Increments taken from the input queue, kept to reuse its memory.
+	std::vector<std::pair<PlaceHandle, size_t>> m_queuedInputs;
+
 	PlacesManager m_places;
 
 	TransitionsManager m_transitions;
@@ -24,12 +24,21 @@ namespace ptne
 {
 using namespace std;
 
-PTN_Engine::PTN_EngineImpProxy::PTN_EngineImpProxy(ACTIONS_THREAD_OPTION actionsThreadOption)
-: m_ptnEngineImp(actionsThreadOption)
+PTN_Engine::PTN_EngineImpProxy::PTN_EngineImpProxy(ACTIONS_THREAD_OPTION actionsThreadOption,
+												   CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy,
+												   optional<uint64_t> seed)
+: m_ptnEngineImp(actionsThreadOption, conflictResolutionPolicy, seed)
 {
 	setActionsThreadOption(actionsThreadOption);
 }
 
+PTN_Engine::PTN_EngineImpProxy::PTN_EngineImpProxy(shared_ptr<IActionsExecutor> actionsExecutor,
+												   CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy,
+												   optional<uint64_t> seed)
+: m_ptnEngineImp(move(actionsExecutor), conflictResolutionPolicy, seed)
+{
+}
+
 PTN_Engine::PTN_EngineImpProxy::~PTN_EngineImpProxy()
 {
 	m_ptnEngineImp.stop();
@@ -47,18 +56,113 @@ PTN_Engine::EventLoopSleepDuration PTN_Engine::PTN_EngineImpProxy::getEventLoopS
 	return m_ptnEngineImp.getEventLoopSleepDuration();
 }
 
+void PTN_Engine::PTN_EngineImpProxy::setEventLoopSpinDuration(const EventLoopSpinDuration spinDuration)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setEventLoopSpinDuration(spinDuration);
+}
+
+PTN_Engine::EventLoopSpinDuration PTN_Engine::PTN_EngineImpProxy::getEventLoopSpinDuration() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getEventLoopSpinDuration();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setEventLoopWatchdogEnabled(const bool watchdogEnabled)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setEventLoopWatchdogEnabled(watchdogEnabled);
+}
+
+bool PTN_Engine::PTN_EngineImpProxy::isEventLoopWatchdogEnabled() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.isEventLoopWatchdogEnabled();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setEngineScheduler(shared_ptr<EngineScheduler> engineScheduler)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setEngineScheduler(std::move(engineScheduler));
+}
+
+shared_ptr<EngineScheduler> PTN_Engine::PTN_EngineImpProxy::getEngineScheduler() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getEngineScheduler();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setEventLoopBusyPolling(const bool busyPolling)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setEventLoopBusyPolling(busyPolling);
+}
+
+bool PTN_Engine::PTN_EngineImpProxy::isEventLoopBusyPolling() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.isEventLoopBusyPolling();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setEventLoopThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setEventLoopThreadScheduling(threadScheduling);
+}
+
+ThreadScheduling PTN_Engine::PTN_EngineImpProxy::getEventLoopThreadScheduling() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getEventLoopThreadScheduling();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setJobQueueThreadScheduling(const ThreadScheduling &threadScheduling)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setJobQueueThreadScheduling(threadScheduling);
+}
+
+ThreadScheduling PTN_Engine::PTN_EngineImpProxy::getJobQueueThreadScheduling() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getJobQueueThreadScheduling();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::notifyConditionsChanged()
+{
+	// Not locked, so that it can be called from actions run while the engine is locked.
+	m_ptnEngineImp.notifyConditionsChanged();
+}
+
 void PTN_Engine::PTN_EngineImpProxy::addArc(const ArcProperties &arcProperties)
 {
 	unique_lock guard(m_mutex);
 	m_ptnEngineImp.addArc(arcProperties);
 }
 
+void PTN_Engine::PTN_EngineImpProxy::addArc(const PlaceHandle place,
+											 const TransitionHandle transition,
+											 const ArcProperties::Type type,
+											 const size_t weight)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.addArc(place, transition, type, weight);
+}
+
 void PTN_Engine::PTN_EngineImpProxy::removeArc(const ArcProperties &arcProperties)
 {
 	unique_lock guard(m_mutex);
 	m_ptnEngineImp.removeArc(arcProperties);
 }
 
+void PTN_Engine::PTN_EngineImpProxy::removeArc(const PlaceHandle place,
+												const TransitionHandle transition,
+												const ArcProperties::Type type)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.removeArc(place, transition, type);
+}
+
 void PTN_Engine::PTN_EngineImpProxy::clearNet()
 {
 	unique_lock guard(m_mutex);
@@ -77,16 +181,28 @@ vector<TransitionProperties> PTN_Engine::PTN_EngineImpProxy::getTransitionsPrope
 	return m_ptnEngineImp.getTransitionsProperties();
 }
 
-void PTN_Engine::PTN_EngineImpProxy::createTransition(const TransitionProperties &transitionProperties)
+TransitionHandle PTN_Engine::PTN_EngineImpProxy::createTransition(const TransitionProperties &transitionProperties)
 {
 	unique_lock guard(m_mutex);
-	m_ptnEngineImp.createTransition(transitionProperties);
+	return m_ptnEngineImp.createTransition(transitionProperties);
 }
 
-void PTN_Engine::PTN_EngineImpProxy::createPlace(const PlaceProperties &placeProperties)
+PlaceHandle PTN_Engine::PTN_EngineImpProxy::createPlace(const PlaceProperties &placeProperties)
 {
 	unique_lock guard(m_mutex);
-	m_ptnEngineImp.createPlace(placeProperties);
+	return m_ptnEngineImp.createPlace(placeProperties);
+}
+
+PlaceHandle PTN_Engine::PTN_EngineImpProxy::getPlaceHandle(const string &place) const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getPlaceHandle(place);
+}
+
+TransitionHandle PTN_Engine::PTN_EngineImpProxy::getTransitionHandle(const string &transition) const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getTransitionHandle(transition);
 }
 
 void PTN_Engine::PTN_EngineImpProxy::registerAction(const string &name, const ActionFunction &action)
@@ -95,12 +211,31 @@ void PTN_Engine::PTN_EngineImpProxy::registerAction(const string &name, const Ac
 	m_ptnEngineImp.registerAction(name, action);
 }
 
+void PTN_Engine::PTN_EngineImpProxy::registerBatchAction(const string &name, const BatchActionFunction &action)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.registerBatchAction(name, action);
+}
+
+void PTN_Engine::PTN_EngineImpProxy::registerAsyncAction(const string &name, const AsyncActionFunction &action)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.registerAsyncAction(name, action);
+}
+
 void PTN_Engine::PTN_EngineImpProxy::registerCondition(const string &name, const ConditionFunction &condition)
 {
 	unique_lock guard(m_mutex);
 	m_ptnEngineImp.registerCondition(name, condition);
 }
 
+void PTN_Engine::PTN_EngineImpProxy::registerExecutorLane(const string &name,
+														   shared_ptr<IActionsExecutor> executor)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.registerExecutorLane(name, move(executor));
+}
+
 void PTN_Engine::PTN_EngineImpProxy::execute(const bool log, ostream &o)
 {
 	unique_lock guard(m_mutex);
@@ -113,18 +248,92 @@ void PTN_Engine::PTN_EngineImpProxy::stop()
 	m_ptnEngineImp.stop();
 }
 
+void PTN_Engine::PTN_EngineImpProxy::freeze()
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.freeze();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::thaw()
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.thaw();
+}
+
 size_t PTN_Engine::PTN_EngineImpProxy::getNumberOfTokens(const string &place) const
 {
 	shared_lock guard(m_mutex);
 	return m_ptnEngineImp.getNumberOfTokens(place);
 }
 
+size_t PTN_Engine::PTN_EngineImpProxy::getNumberOfTokens(const PlaceHandle place) const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getNumberOfTokens(place);
+}
+
+size_t PTN_Engine::PTN_EngineImpProxy::getNumberOfCoalescedActions(const string &place) const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getNumberOfCoalescedActions(place);
+}
+
 void PTN_Engine::PTN_EngineImpProxy::incrementInputPlace(const string &place)
 {
+	// The input queue synchronizes the producers with the event loop.
+	if (m_ptnEngineImp.queueInput(place, 1))
+	{
+		return;
+	}
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.incrementInputPlace(place);
+}
+
+void PTN_Engine::PTN_EngineImpProxy::incrementInputPlace(const PlaceHandle place)
+{
+	// The input queue synchronizes the producers with the event loop.
+	if (m_ptnEngineImp.queueInput(place, 1))
+	{
+		return;
+	}
 	unique_lock guard(m_mutex);
 	m_ptnEngineImp.incrementInputPlace(place);
 }
 
+void PTN_Engine::PTN_EngineImpProxy::incrementInputPlace(const string &place, const size_t count)
+{
+	// The input queue synchronizes the producers with the event loop.
+	if (m_ptnEngineImp.queueInput(place, count))
+	{
+		return;
+	}
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.incrementInputPlace(place, count);
+}
+
+void PTN_Engine::PTN_EngineImpProxy::incrementInputPlace(const PlaceHandle place, const size_t count)
+{
+	// The input queue synchronizes the producers with the event loop.
+	if (m_ptnEngineImp.queueInput(place, count))
+	{
+		return;
+	}
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.incrementInputPlace(place, count);
+}
+
+void PTN_Engine::PTN_EngineImpProxy::incrementInputPlace(span<const pair<string, size_t>> increments)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.incrementInputPlace(increments);
+}
+
+void PTN_Engine::PTN_EngineImpProxy::incrementInputPlace(span<const pair<PlaceHandle, size_t>> increments)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.incrementInputPlace(increments);
+}
+
 void PTN_Engine::PTN_EngineImpProxy::printState(ostream &o) const
 {
 	shared_lock guard(m_mutex);
@@ -137,6 +346,115 @@ bool PTN_Engine::PTN_EngineImpProxy::isEventLoopRunning() const
 	return m_ptnEngineImp.isEventLoopRunning();
 }
 
+PTN_Engine::CONFLICT_RESOLUTION_POLICY PTN_Engine::PTN_EngineImpProxy::getConflictResolutionPolicy() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getConflictResolutionPolicy();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setMaximalStepFiring(const bool maximalStepFiring)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setMaximalStepFiring(maximalStepFiring);
+}
+
+bool PTN_Engine::PTN_EngineImpProxy::isMaximalStepFiring() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.isMaximalStepFiring();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setMultiFiring(const bool multiFiring)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setMultiFiring(multiFiring);
+}
+
+bool PTN_Engine::PTN_EngineImpProxy::isMultiFiring() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.isMultiFiring();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setNumberOfFiringThreads(const size_t numberOfFiringThreads)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setNumberOfFiringThreads(numberOfFiringThreads);
+}
+
+size_t PTN_Engine::PTN_EngineImpProxy::getNumberOfFiringThreads() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getNumberOfFiringThreads();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setJobQueueCapacity(const size_t capacity,
+														 const JOB_QUEUE_OVERFLOW_POLICY overflowPolicy)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setJobQueueCapacity(capacity, overflowPolicy);
+}
+
+size_t PTN_Engine::PTN_EngineImpProxy::getJobQueueCapacity() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getJobQueueCapacity();
+}
+
+PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY PTN_Engine::PTN_EngineImpProxy::getJobQueueOverflowPolicy() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getJobQueueOverflowPolicy();
+}
+
+JobQueueMetrics PTN_Engine::PTN_EngineImpProxy::getJobQueueMetrics() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getJobQueueMetrics();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setNumberOfActionThreads(const size_t numberOfActionThreads)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setNumberOfActionThreads(numberOfActionThreads);
+}
+
+size_t PTN_Engine::PTN_EngineImpProxy::getNumberOfActionThreads() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getNumberOfActionThreads();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setInlineActionThreshold(const chrono::nanoseconds inlineActionThreshold)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setInlineActionThreshold(inlineActionThreshold);
+}
+
+chrono::nanoseconds PTN_Engine::PTN_EngineImpProxy::getInlineActionThreshold() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getInlineActionThreshold();
+}
+
+void PTN_Engine::PTN_EngineImpProxy::setInputQueueCapacity(const size_t capacity)
+{
+	unique_lock guard(m_mutex);
+	m_ptnEngineImp.setInputQueueCapacity(capacity);
+}
+
+size_t PTN_Engine::PTN_EngineImpProxy::getInputQueueCapacity() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.getInputQueueCapacity();
+}
+
+bool PTN_Engine::PTN_EngineImpProxy::isFrozen() const
+{
+	shared_lock guard(m_mutex);
+	return m_ptnEngineImp.isFrozen();
+}
+
 void PTN_Engine::PTN_EngineImpProxy::setActionsThreadOption(const ACTIONS_THREAD_OPTION actionsThreadOption)
 {
 	unique_lock guard(m_mutex);
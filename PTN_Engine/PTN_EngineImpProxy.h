@@ -35,7 +35,13 @@ class PTN_Engine::PTN_EngineImpProxy final
 {
 public:
 	~PTN_EngineImpProxy();
-	explicit PTN_EngineImpProxy(ACTIONS_THREAD_OPTION actionsThreadOption);
+	explicit PTN_EngineImpProxy(
+	ACTIONS_THREAD_OPTION actionsThreadOption,
+	CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy = CONFLICT_RESOLUTION_POLICY::RANDOM,
+	std::optional<uint64_t> seed = std::nullopt);
+	PTN_EngineImpProxy(std::shared_ptr<IActionsExecutor> actionsExecutor,
+					   CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy,
+					   std::optional<uint64_t> seed);
 	PTN_EngineImpProxy(const PTN_EngineImpProxy &) = delete;
 	PTN_EngineImpProxy(PTN_EngineImpProxy &&) = delete;
 	PTN_EngineImpProxy &operator=(const PTN_EngineImpProxy &) = delete;
@@ -43,42 +49,139 @@ public:
 
 	void addArc(const ArcProperties &arcProperties);
 
+	void addArc(const PlaceHandle place,
+				const TransitionHandle transition,
+				const ArcProperties::Type type,
+				const size_t weight);
+
 	void clearNet();
 
-	void createTransition(const TransitionProperties &transitionProperties);
+	TransitionHandle createTransition(const TransitionProperties &transitionProperties);
 
-	void createPlace(const PlaceProperties &placeProperties);
+	PlaceHandle createPlace(const PlaceProperties &placeProperties);
 
 	void execute(const bool log = false, std::ostream &o = std::cout);
 
+	void freeze();
+
 	ACTIONS_THREAD_OPTION getActionsThreadOption() const;
 
+	CONFLICT_RESOLUTION_POLICY getConflictResolutionPolicy() const;
+
+	std::shared_ptr<EngineScheduler> getEngineScheduler() const;
+
 	EventLoopSleepDuration getEventLoopSleepDuration() const;
 
+	EventLoopSpinDuration getEventLoopSpinDuration() const;
+
+	ThreadScheduling getEventLoopThreadScheduling() const;
+
+	std::chrono::nanoseconds getInlineActionThreshold() const;
+
+	size_t getInputQueueCapacity() const;
+
+	size_t getJobQueueCapacity() const;
+
+	JobQueueMetrics getJobQueueMetrics() const;
+
+	JOB_QUEUE_OVERFLOW_POLICY getJobQueueOverflowPolicy() const;
+
+	ThreadScheduling getJobQueueThreadScheduling() const;
+
+	size_t getNumberOfActionThreads() const;
+
+	size_t getNumberOfFiringThreads() const;
+
+	size_t getNumberOfCoalescedActions(const std::string &place) const;
+
 	size_t getNumberOfTokens(const std::string &place) const;
 
+	size_t getNumberOfTokens(const PlaceHandle place) const;
+
+	PlaceHandle getPlaceHandle(const std::string &place) const;
+
 	std::vector<PlaceProperties> getPlacesProperties() const;
 
+	TransitionHandle getTransitionHandle(const std::string &transition) const;
+
 	std::vector<TransitionProperties> getTransitionsProperties() const;
 
 	void incrementInputPlace(const std::string &place);
 
+	void incrementInputPlace(const PlaceHandle place);
+
+	void incrementInputPlace(const std::string &place, const size_t count);
+
+	void incrementInputPlace(const PlaceHandle place, const size_t count);
+
+	void incrementInputPlace(std::span<const std::pair<std::string, size_t>> increments);
+
+	void incrementInputPlace(std::span<const std::pair<PlaceHandle, size_t>> increments);
+
+	bool isEventLoopBusyPolling() const;
+
 	bool isEventLoopRunning() const;
 
+	bool isEventLoopWatchdogEnabled() const;
+
+	bool isFrozen() const;
+
+	bool isMaximalStepFiring() const;
+
+	bool isMultiFiring() const;
+
+	void notifyConditionsChanged();
+
 	void printState(std::ostream &o) const;
 
 	void registerAction(const std::string &name, const ActionFunction &action);
 
+	void registerBatchAction(const std::string &name, const BatchActionFunction &action);
+
+	void registerAsyncAction(const std::string &name, const AsyncActionFunction &action);
+
 	void registerCondition(const std::string &name, const ConditionFunction &condition);
 
+	void registerExecutorLane(const std::string &name, std::shared_ptr<IActionsExecutor> executor);
+
 	void removeArc(const ArcProperties &arcProperties);
 
+	void removeArc(const PlaceHandle place, const TransitionHandle transition, const ArcProperties::Type type);
+
 	void setActionsThreadOption(const ACTIONS_THREAD_OPTION actionsThreadOption);
 
+	void setEngineScheduler(std::shared_ptr<EngineScheduler> engineScheduler);
+
+	void setEventLoopBusyPolling(const bool busyPolling);
+
 	void setEventLoopSleepDuration(const EventLoopSleepDuration sleepDuration);
 
+	void setEventLoopSpinDuration(const EventLoopSpinDuration spinDuration);
+
+	void setEventLoopThreadScheduling(const ThreadScheduling &threadScheduling);
+
+	void setEventLoopWatchdogEnabled(const bool watchdogEnabled);
+
+	void setInlineActionThreshold(const std::chrono::nanoseconds inlineActionThreshold);
+
+	void setInputQueueCapacity(const size_t capacity);
+
+	void setJobQueueCapacity(const size_t capacity, const JOB_QUEUE_OVERFLOW_POLICY overflowPolicy);
+
+	void setJobQueueThreadScheduling(const ThreadScheduling &threadScheduling);
+
+	void setMaximalStepFiring(const bool maximalStepFiring);
+
+	void setMultiFiring(const bool multiFiring);
+
+	void setNumberOfActionThreads(const size_t numberOfActionThreads);
+
+	void setNumberOfFiringThreads(const size_t numberOfFiringThreads);
+
 	void stop();
 
+	void thaw();
+
 private:
 	//! Synchronizes calls to m_ptnEngineImp
 	mutable std::shared_mutex m_mutex;
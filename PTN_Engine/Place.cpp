@@ -17,74 +17,279 @@
  */
 
 #include "PTN_Engine/Place.h"
-#include "PTN_Engine/Executor/IActionsExecutor.h"
+#include "PTN_Engine/IActionsExecutor.h"
 #include "PTN_Engine/PTN_EngineImp.h"
 #include "PTN_Engine/PTN_Exception.h"
 #include "PTN_Engine/Utilities/LockWeakPtr.h"
 #include <mutex>
 #include <string>
-#include <thread>
 
 
 namespace ptne
 {
 using namespace std;
 
+namespace
+{
+
+//!
+//! \brief Clears the pending flag of a coalesced action once the action starts, or once the executor discards
+//! the action without running it.
+//!
+class PendingAction final
+{
+public:
+	~PendingAction()
+	{
+		start();
+	}
+
+	explicit PendingAction(atomic<bool> &pending) noexcept
+	: m_pending(&pending)
+	{
+	}
+
+	PendingAction(PendingAction &&other) noexcept
+	: m_pending(exchange(other.m_pending, nullptr))
+	{
+	}
+
+	PendingAction(const PendingAction &) = delete;
+	PendingAction &operator=(const PendingAction &) = delete;
+	PendingAction &operator=(PendingAction &&) = delete;
+
+	//!
+	//! \brief Clear the pending flag, so that invocations requested from now on are queued again. Reads the
+	//! flag, so that the action sees the changes made before the invocations folded into it.
+	//!
+	void start() noexcept
+	{
+		if (m_pending != nullptr)
+		{
+			m_pending->exchange(false);
+			m_pending = nullptr;
+		}
+	}
+
+private:
+	//! The pending flag, null once cleared.
+	atomic<bool> *m_pending;
+};
+
+//! Action running in the current thread, identified by its function.
+thread_local const void *t_runningAction = nullptr;
+
+//!
+//! \brief Marks an action as running in the current thread while it runs, so that an action waiting for the
+//! actions in execution of its own place does not wait for itself.
+//!
+class RunningAction final
+{
+public:
+	~RunningAction()
+	{
+		t_runningAction = m_previous;
+	}
+
+	explicit RunningAction(const void *action) noexcept
+	: m_previous(exchange(t_runningAction, action))
+	{
+	}
+
+	RunningAction(const RunningAction &) = delete;
+	RunningAction(RunningAction &&) = delete;
+	RunningAction &operator=(const RunningAction &) = delete;
+	RunningAction &operator=(RunningAction &&) = delete;
+
+private:
+	//! Action running before, for actions run within other actions.
+	const void *const m_previous;
+};
+
+//!
+//! \brief Wait until no more than the given number of actions are accounted in a counter.
+//! \param actionsInExecution - the counter, notified by the executors once decremented.
+//! \param ownActions - actions of the current thread, which are not waited for.
+//!
+void waitForActions(const atomic<size_t> &actionsInExecution, const size_t ownActions)
+{
+	for (size_t actions = actionsInExecution; actions > ownActions; actions = actionsInExecution)
+	{
+		actionsInExecution.wait(actions);
+	}
+}
+
+} // namespace
+
 Place::~Place() = default;
 
-Place::Place(const PlaceProperties &placeProperties, const shared_ptr<IActionsExecutor> &executor)
+Place::Place(const PlaceProperties &placeProperties,
+			 const shared_ptr<IActionsExecutor> &executor,
+			 const shared_ptr<ActionsInExecution> &actionsInExecution)
 : m_name(placeProperties.name)
 , m_onEnterActionName(placeProperties.onEnterActionFunctionName)
 , m_onEnterAction(placeProperties.onEnterAction)
+, m_onEnterAsyncAction(placeProperties.onEnterAsyncAction)
+, m_onEnterBatchAction(placeProperties.onEnterBatchAction)
 , m_onExitActionName(placeProperties.onExitActionFunctionName)
 , m_onExitAction(placeProperties.onExitAction)
+, m_onExitAsyncAction(placeProperties.onExitAsyncAction)
+, m_onExitBatchAction(placeProperties.onExitBatchAction)
 , m_numberOfTokens(placeProperties.initialNumberOfTokens)
 , m_isInputPlace(placeProperties.input)
 , m_actionsExecutor(executor)
+, m_executorLane(placeProperties.executorLane)
+, m_coalesceActions(placeProperties.coalesceActions)
+, m_actionsInExecution(make_shared<ActionsInExecution::PlaceActions>(this))
+, m_actionCompletedNotifier(actionsInExecution ? actionsInExecution->createNotifier(m_actionsInExecution) : nullptr)
 {
-	if (!m_onEnterActionName.empty() && m_onEnterAction == nullptr)
+	if (!m_onEnterActionName.empty() && !hasOnEnterAction())
 	{
 		throw PTN_Exception("On enter action function must be specified.");
 	}
 
-	if (!m_onExitActionName.empty() && m_onExitAction == nullptr)
+	if (!m_onExitActionName.empty() && !hasOnExitAction())
 	{
 		throw PTN_Exception("On exit action function must be specified.");
 	}
+
+	const auto isAmbiguous = [](const auto &function, const auto &batchFunction, const auto &coroutine)
+	{ return (function != nullptr) + (batchFunction != nullptr) + (coroutine != nullptr) > 1; };
+	if (isAmbiguous(m_onEnterAction, m_onEnterBatchAction, m_onEnterAsyncAction) ||
+		isAmbiguous(m_onExitAction, m_onExitBatchAction, m_onExitAsyncAction))
+	{
+		throw PTN_Exception("A place action can only be one of a function, a batch function or a coroutine.");
+	}
 }
 
-string Place::getName() const
+const string &Place::getExecutorLane() const
+{
+	return m_executorLane;
+}
+
+size_t Place::getNumberOfCoalescedActions() const
+{
+	return m_coalescedActions;
+}
+
+const string &Place::getName() const
 {
 	return m_name;
 }
 
-void Place::enterPlace(const size_t tokens)
+void Place::enterPlace(const size_t tokens, const size_t multiplicity)
 {
 	unique_lock guard(m_mutex);
 	increaseNumberOfTokens(tokens);
-	if (m_onEnterAction == nullptr)
+	if (!hasOnEnterAction())
 	{
 		return;
 	}
-	while (m_blockStartingOnEnterActions)
-	{
-		// TO DO make this wait period configurable
-		// add a max wait time after which an exception
-		// is thrown.
-		this_thread::sleep_for(100ms);
-	}
-	lockWeakPtr(m_actionsExecutor)->executeAction(m_onEnterAction, m_onEnterActionsInExecution);
+	waitUntilOnEnterActionsUnblocked(guard);
+	dispatchAction(m_onEnterAction, m_onEnterBatchAction, m_onEnterAsyncAction, m_actionsInExecution->onEnter,
+				   m_onEnterActionPending, tokens, multiplicity);
 }
 
-void Place::exitPlace(const size_t tokens)
+void Place::exitPlace(const size_t tokens, const size_t multiplicity)
 {
 	unique_lock guard(m_mutex);
 	decreaseNumberOfTokens(tokens);
-	if (m_onExitAction == nullptr)
+	if (!hasOnExitAction())
+	{
+		return;
+	}
+	dispatchAction(m_onExitAction, m_onExitBatchAction, m_onExitAsyncAction, m_actionsInExecution->onExit,
+				   m_onExitActionPending, tokens, multiplicity);
+}
+
+void Place::executeOnEnterAction(const size_t tokens, const size_t multiplicity)
+{
+	shared_lock guard(m_mutex);
+	if (!hasOnEnterAction())
+	{
+		return;
+	}
+	dispatchAction(m_onEnterAction, m_onEnterBatchAction, m_onEnterAsyncAction, m_actionsInExecution->onEnter,
+				   m_onEnterActionPending, tokens, multiplicity);
+}
+
+void Place::executeOnExitAction(const size_t tokens, const size_t multiplicity)
+{
+	shared_lock guard(m_mutex);
+	if (!hasOnExitAction())
 	{
 		return;
 	}
-	lockWeakPtr(m_actionsExecutor)->executeAction(m_onExitAction, m_onExitActionsInExecution);
+	dispatchAction(m_onExitAction, m_onExitBatchAction, m_onExitAsyncAction, m_actionsInExecution->onExit,
+				   m_onExitActionPending, tokens, multiplicity);
+}
+
+bool Place::hasOnEnterAction() const
+{
+	return m_onEnterAction != nullptr || m_onEnterBatchAction != nullptr || m_onEnterAsyncAction != nullptr;
+}
+
+bool Place::hasOnExitAction() const
+{
+	return m_onExitAction != nullptr || m_onExitBatchAction != nullptr || m_onExitAsyncAction != nullptr;
+}
+
+void Place::dispatchAction(const ActionFunction &action,
+						   const BatchActionFunction &batchAction,
+						   const AsyncActionFunction &asyncAction,
+						   atomic<size_t> &actionsInExecution,
+						   atomic<bool> &actionPending,
+						   const size_t tokens,
+						   const size_t multiplicity) const
+{
+	const auto actionsExecutor = lockWeakPtr(m_actionsExecutor);
+	if (batchAction != nullptr)
+	{
+		// One dispatch for all the tokens, which the job carries along with the action.
+		auto job = [&batchAction, tokens]
+		{
+			const RunningAction running(&batchAction);
+			batchAction(tokens);
+		};
+		actionsExecutor->executeAction(move(job), actionsInExecution, m_actionCompletedNotifier);
+		return;
+	}
+
+	if (m_coalesceActions && asyncAction == nullptr && multiplicity > 0)
+	{
+		if (actionPending.exchange(true))
+		{
+			m_coalescedActions += multiplicity;
+			return;
+		}
+		m_coalescedActions += multiplicity - 1;
+		auto job = [&action, pendingAction = PendingAction(actionPending)]() mutable
+		{
+			pendingAction.start();
+			const RunningAction running(&action);
+			action();
+		};
+		static_assert(ActionJob::isStoredInPlace<decltype(job)>());
+		actionsExecutor->executeAction(move(job), actionsInExecution, m_actionCompletedNotifier);
+		return;
+	}
+
+	for (size_t i = 0; i < multiplicity; ++i)
+	{
+		if (asyncAction != nullptr)
+		{
+			actionsExecutor->executeAsyncAction(asyncAction, actionsInExecution, m_actionCompletedNotifier);
+		}
+		else
+		{
+			auto job = [&action]
+			{
+				const RunningAction running(&action);
+				action();
+			};
+			actionsExecutor->executeAction(move(job), actionsInExecution, m_actionCompletedNotifier);
+		}
+	}
 }
 
 void Place::increaseNumberOfTokens(const size_t tokens)
@@ -132,7 +337,7 @@ size_t Place::getNumberOfTokens() const
 
 bool Place::isInputPlace() const
 {
-	shared_lock guard(m_mutex);
+	// Constant, so reading it needs no lock, even while an action holds the place.
 	return m_isInputPlace;
 }
 
@@ -150,12 +355,45 @@ string Place::getOnExitActionName() const
 
 bool Place::isOnEnterActionInExecution() const
 {
-	return m_onEnterActionsInExecution > 0;
+	return m_actionsInExecution->onEnter > 0;
+}
+
+bool Place::hasActionsInExecution() const
+{
+	return m_actionsInExecution->onEnter > 0 || m_actionsInExecution->onExit > 0;
+}
+
+void Place::waitForActionsInExecution() const
+{
+	auto ownActions = [](const ActionFunction &action, const BatchActionFunction &batchAction) -> size_t
+	{ return t_runningAction == &action || t_runningAction == &batchAction ? 1 : 0; };
+	waitForActions(m_actionsInExecution->onEnter, ownActions(m_onEnterAction, m_onEnterBatchAction));
+	waitForActions(m_actionsInExecution->onExit, ownActions(m_onExitAction, m_onExitBatchAction));
 }
 
 void Place::blockStartingOnEnterActions(const bool value)
 {
-	m_blockStartingOnEnterActions = value;
+	if (value)
+	{
+		// Under the lock, so that an action is either started before the block or waits for it to be released.
+		unique_lock guard(m_mutex);
+		++m_onEnterActionsBlocks;
+		return;
+	}
+	if (m_onEnterActionsBlocks.fetch_sub(1) == 1)
+	{
+		m_onEnterActionsBlocks.notify_all();
+	}
+}
+
+void Place::waitUntilOnEnterActionsUnblocked(unique_lock<shared_mutex> &guard) const
+{
+	for (size_t blocks = m_onEnterActionsBlocks; blocks != 0; blocks = m_onEnterActionsBlocks)
+	{
+		guard.unlock();
+		m_onEnterActionsBlocks.wait(blocks);
+		guard.lock();
+	}
 }
 
 PlaceProperties Place::placeProperties() const
@@ -167,7 +405,13 @@ PlaceProperties Place::placeProperties() const
 	placeProperties.initialNumberOfTokens = m_numberOfTokens;
 	placeProperties.onEnterAction = m_onEnterAction;
 	placeProperties.onExitAction = m_onExitAction;
+	placeProperties.onEnterAsyncAction = m_onEnterAsyncAction;
+	placeProperties.onExitAsyncAction = m_onExitAsyncAction;
+	placeProperties.onEnterBatchAction = m_onEnterBatchAction;
+	placeProperties.onExitBatchAction = m_onExitBatchAction;
 	placeProperties.input = m_isInputPlace;
+	placeProperties.executorLane = m_executorLane;
+	placeProperties.coalesceActions = m_coalesceActions;
 	return placeProperties;
 }
 
@@ -18,16 +18,18 @@
 
 #pragma once
 
+#include "PTN_Engine/ActionsInExecution.h"
+#include "PTN_Engine/IActionsExecutor.h"
 #include "PTN_Engine/PTN_Engine.h"
 #include <atomic>
 #include <functional>
+#include <mutex>
 #include <shared_mutex>
 
 namespace ptne
 {
 
 class IPTN_EnginePlace;
-class IActionsExecutor;
 
 
 //!
@@ -39,35 +41,70 @@ public:
 	using ActionFunction = std::function<void(void)>;
 
 	~Place();
-	Place(const PlaceProperties &placeProperties, const std::shared_ptr<IActionsExecutor> &);
+	Place(const PlaceProperties &placeProperties,
+		  const std::shared_ptr<IActionsExecutor> &,
+		  const std::shared_ptr<ActionsInExecution> &actionsInExecution = nullptr);
 	Place(const Place &) = delete;
 	Place(Place &&) = delete;
 	Place &operator=(Place &) = delete;
 	Place &operator=(Place &&) = delete;
 
 	//!
-	//! \brief Whether an on enter action can be triggered or not.
-	//! \param value
+	//! \brief Block or unblock starting on enter actions. Blocks are counted, so each block must be released
+	//! by unblocking once, and actions start again when all blocks were released. Tokens still enter the
+	//! place while it is blocked, the on enter actions wait until it is unblocked.
+	//! \param value - true to block, false to release a block.
 	//!
 	void blockStartingOnEnterActions(const bool value);
 
 	//!
 	//! \brief Increase number of tokens and call on enter action.
-	//! \param tokens - number of tokens to increase.
+	//! \param tokens - number of tokens to increase, passed to a batch action.
+	//! \param multiplicity - number of times the on enter action is called, unless it is a batch action.
 	//!
-	void enterPlace(const size_t tokens = 1);
+	void enterPlace(const size_t tokens = 1, const size_t multiplicity = 1);
 
 	//!
 	//! \brief Decrease number of tokens and call on exit action.
-	//! \param tokens - number of tokens to decrease.
+	//! \param tokens - number of tokens to decrease, passed to a batch action.
+	//! \param multiplicity - number of times the on exit action is called, unless it is a batch action.
 	//!
-	void exitPlace(const size_t tokens = 1);
+	void exitPlace(const size_t tokens = 1, const size_t multiplicity = 1);
+
+	//!
+	//! \brief Dispatch the on enter action, without changing the number of tokens.
+	//! Used when the tokens are kept by a frozen net.
+	//! \param tokens - number of tokens that entered the place, passed to a batch action.
+	//! \param multiplicity - number of times the on enter action is called, unless it is a batch action.
+	//!
+	void executeOnEnterAction(const size_t tokens = 1, const size_t multiplicity = 1);
+
+	//!
+	//! \brief Dispatch the on exit action, without changing the number of tokens.
+	//! Used when the tokens are kept by a frozen net.
+	//! \param tokens - number of tokens that left the place, passed to a batch action.
+	//! \param multiplicity - number of times the on exit action is called, unless it is a batch action.
+	//!
+	void executeOnExitAction(const size_t tokens = 1, const size_t multiplicity = 1);
+
+	//!
+	//! \brief Name of the executor lane running the actions of the place.
+	//! \return The executor lane, empty if the actions run on the actions executor of the engine.
+	//!
+	const std::string &getExecutorLane() const;
+
+	//!
+	//! \brief Number of action invocations folded into an invocation that was still queued, if the place
+	//! coalesces its actions.
+	//! \return The number of coalesced invocations.
+	//!
+	size_t getNumberOfCoalescedActions() const;
 
 	//!
 	//! \brief getName
 	//! \return place name
 	//!
-	std::string getName() const;
+	const std::string &getName() const;
 
 	//!
 	//! Return the number of tokens.
@@ -99,6 +136,30 @@ public:
 	//!
 	bool isOnEnterActionInExecution() const;
 
+	//!
+	//! \brief Tells if any action, belonging to the place, is being executed or waiting to be executed.
+	//! \return true if an action is in execution.
+	//!
+	bool hasActionsInExecution() const;
+
+	//!
+	//! \brief Wait until the actions of the place in execution finished. An action of the place calling it from
+	//! its own thread does not wait for itself.
+	//!
+	void waitForActionsInExecution() const;
+
+	//!
+	//! \brief Tells if the place has an on enter action, either a function, a batch function or a coroutine.
+	//! \return True if the place has an on enter action.
+	//!
+	bool hasOnEnterAction() const;
+
+	//!
+	//! \brief Tells if the place has an on exit action, either a function, a batch function or a coroutine.
+	//! \return True if the place has an on exit action.
+	//!
+	bool hasOnExitAction() const;
+
 	//!
 	//! \brief placeProperties
 	//! \return
@@ -131,17 +192,42 @@ private:
 	//!
 	void increaseNumberOfTokens(const size_t tokens = 1);
 
-	//! Flag to block triggering on enter actions.
-	std::atomic<bool> m_blockStartingOnEnterActions = false;
+	//!
+	//! \brief Hand an action over to the actions executor. Must be called with m_mutex locked.
+	//! \param action - the action function, if the action is neither a batch function nor a coroutine.
+	//! \param batchAction - the batch action, if the action is a batch function.
+	//! \param asyncAction - the coroutine action, if the action is a coroutine.
+	//! \param actionsInExecution - counter of the actions in execution the action is accounted in.
+	//! \param actionPending - set while a coalesced invocation of the action is queued.
+	//! \param tokens - number of tokens passed to a batch action, which is executed once.
+	//! \param multiplicity - number of times the other actions are executed.
+	//!
+	void dispatchAction(const ActionFunction &action,
+						const BatchActionFunction &batchAction,
+						const AsyncActionFunction &asyncAction,
+						std::atomic<size_t> &actionsInExecution,
+						std::atomic<bool> &actionPending,
+						const size_t tokens,
+						const size_t multiplicity) const;
+
+	//!
+	//! \brief Wait until starting on enter actions is no longer blocked. The place is unlocked while waiting, so
+	//! the transitions blocking it can take its tokens.
+	//! \param guard - lock of m_mutex, held when returning.
+	//!
+	void waitUntilOnEnterActionsUnblocked(std::unique_lock<std::shared_mutex> &guard) const;
+
+	//! Number of blocks preventing on enter actions from starting.
+	std::atomic<size_t> m_onEnterActionsBlocks = 0;
 
 	//! Flag that determines if the place can be added tokens from outside the net.
-	bool m_isInputPlace = false;
+	const bool m_isInputPlace = false;
 
 	//! Shared mutex to synchronize calls, allowing simultaneous reads (readers-writer lock).
 	mutable std::shared_mutex m_mutex;
 
 	//! Name of the place used to identify it.
-	std::string m_name;
+	const std::string m_name;
 
 	//! Number of tokens in the place.
 	size_t m_numberOfTokens = 0;
@@ -149,23 +235,50 @@ private:
 	//! Function to be called when a token enters the place.
 	const ActionFunction m_onEnterAction = nullptr;
 
+	//! Coroutine started when a token enters the place, instead of m_onEnterAction.
+	const AsyncActionFunction m_onEnterAsyncAction = nullptr;
+
+	//! Called with the number of tokens entering the place, instead of m_onEnterAction.
+	const BatchActionFunction m_onEnterBatchAction = nullptr;
+
 	//! A label for the on enter action.
 	std::string m_onEnterActionName;
 
-	//! Counter of on enter functions being executed.
-	std::atomic<size_t> m_onEnterActionsInExecution = 0;
-
 	//! Function to be called when a token leaves the place.
 	const ActionFunction m_onExitAction = nullptr;
 
+	//! Coroutine started when a token leaves the place, instead of m_onExitAction.
+	const AsyncActionFunction m_onExitAsyncAction = nullptr;
+
+	//! Called with the number of tokens leaving the place, instead of m_onExitAction.
+	const BatchActionFunction m_onExitBatchAction = nullptr;
+
 	//! A label for the on exite action.
 	std::string m_onExitActionName;
 
-	//! Counter of on exit functions being executed.
-	std::atomic<size_t> m_onExitActionsInExecution = 0;
-
 	//! Actions executor.
 	std::weak_ptr<IActionsExecutor> m_actionsExecutor;
+
+	//! Executor lane of m_actionsExecutor, empty for the actions executor of the engine.
+	const std::string m_executorLane;
+
+	//! If invocations of an action are folded into the invocation still queued.
+	const bool m_coalesceActions = false;
+
+	//! Set while a coalesced invocation of the on enter action is queued.
+	mutable std::atomic<bool> m_onEnterActionPending = false;
+
+	//! Set while a coalesced invocation of the on exit action is queued.
+	mutable std::atomic<bool> m_onExitActionPending = false;
+
+	//! Number of invocations folded into a queued one.
+	mutable std::atomic<size_t> m_coalescedActions = 0;
+
+	//! Counters of the actions being executed, kept by the engine's ActionsInExecution.
+	const std::shared_ptr<ActionsInExecution::PlaceActions> m_actionsInExecution;
+
+	//! Publishes the completion of an action executed in another thread. Null without ActionsInExecution.
+	const std::shared_ptr<const ActionCompletedNotifier> m_actionCompletedNotifier;
 };
 
 } // namespace ptne
@@ -20,7 +20,9 @@
 #include "PTN_Engine/PTN_Exception.h"
 #include "PTN_Engine/Utilities/DetectRepeated.h"
 #include "PTN_Engine/Utilities/LockWeakPtr.h"
+#include <climits>
 #include <mutex>
+#include <unordered_map>
 
 namespace ptne
 {
@@ -35,7 +37,7 @@ bool PlacesManager::contains(const string &itemName) const
 	return ManagerBase<Place>::contains(itemName);
 }
 
-void PlacesManager::insert(const shared_ptr<Place> &spPlace)
+size_t PlacesManager::insert(const shared_ptr<Place> &spPlace)
 {
 	unique_lock itemsGuard(m_itemsMutex);
 	ManagerBase<Place>::insert(spPlace);
@@ -43,6 +45,10 @@ void PlacesManager::insert(const shared_ptr<Place> &spPlace)
 	{
 		m_inputPlaces.push_back(spPlace);
 	}
+	const size_t index = m_placesByIndex.size();
+	m_placesByIndex.push_back(spPlace);
+	m_placeIndices[spPlace->getName()] = index;
+	return index;
 }
 
 void PlacesManager::clear()
@@ -50,6 +56,14 @@ void PlacesManager::clear()
 	unique_lock itemsGuard(m_itemsMutex);
 	ManagerBase<Place>::clear();
 	m_inputPlaces.clear();
+	m_placesByIndex.clear();
+	m_placeIndices.clear();
+}
+
+vector<SharedPtrPlace> PlacesManager::getAllPlaces() const
+{
+	shared_lock itemsGuard(m_itemsMutex);
+	return m_placesByIndex;
 }
 
 shared_ptr<Place> PlacesManager::getPlace(const string &placeName) const
@@ -58,6 +72,27 @@ shared_ptr<Place> PlacesManager::getPlace(const string &placeName) const
 	return ManagerBase<Place>::getItem(placeName);
 }
 
+shared_ptr<Place> PlacesManager::getPlace(const size_t place) const
+{
+	shared_lock itemsGuard(m_itemsMutex);
+	if (place >= m_placesByIndex.size())
+	{
+		throw InvalidHandleException(place);
+	}
+	return m_placesByIndex[place];
+}
+
+size_t PlacesManager::getPlaceIndex(const string &placeName) const
+{
+	shared_lock itemsGuard(m_itemsMutex);
+	const auto it = m_placeIndices.find(placeName);
+	if (it == m_placeIndices.end())
+	{
+		throw InvalidNameException(placeName);
+	}
+	return it->second;
+}
+
 void PlacesManager::clearInputPlaces() const
 {
 	unique_lock placesGuard(m_itemsMutex);
@@ -84,7 +119,20 @@ void PlacesManager::setActionsExecutor(shared_ptr<IActionsExecutor> &actionsExec
 	unique_lock placesGuard(m_itemsMutex);
 	for (auto &place : m_items)
 	{
-		place.second->setActionsExecutor(actionsExecutor);
+		// Places on an executor lane keep the executor of their lane.
+		if (place.second->getExecutorLane().empty())
+		{
+			place.second->setActionsExecutor(actionsExecutor);
+		}
+	}
+}
+
+void PlacesManager::waitForActionsInExecution() const
+{
+	// Not locked while waiting, the actions may access the places.
+	for (const auto &place : getAllPlaces())
+	{
+		place->waitForActionsInExecution();
 	}
 }
 
@@ -98,18 +146,91 @@ size_t PlacesManager::getNumberOfTokens(const string &place) const
 	return m_items.at(place)->getNumberOfTokens();
 }
 
-void PlacesManager::incrementInputPlace(const string &place)
+size_t PlacesManager::getNumberOfTokens(const size_t place) const
 {
-	unique_lock placesGuard(m_itemsMutex);
-	if (!m_items.contains(place))
+	return getPlace(place)->getNumberOfTokens();
+}
+
+void PlacesManager::checkInputPlace(const size_t place) const
+{
+	const auto spPlace = getPlace(place);
+	if (!spPlace->isInputPlace())
+	{
+		throw NotInputPlaceException(spPlace->getName());
+	}
+}
+
+SharedPtrPlace PlacesManager::incrementInputPlace(const string &place, const size_t count)
+{
+	// The container is not changed and the place synchronizes its own tokens.
+	shared_lock placesGuard(m_itemsMutex);
+	const auto it = m_items.find(place);
+	if (it == m_items.end())
 	{
 		throw InvalidNameException(place);
 	}
-	if (!m_items.at(place)->isInputPlace())
+	if (!it->second->isInputPlace())
 	{
 		throw NotInputPlaceException(place);
 	}
-	m_items.at(place)->enterPlace(1);
+	it->second->enterPlace(count, count);
+	return it->second;
+}
+
+SharedPtrPlace PlacesManager::incrementInputPlace(const size_t place, const size_t count)
+{
+	auto spPlace = getPlace(place);
+	if (!spPlace->isInputPlace())
+	{
+		throw NotInputPlaceException(spPlace->getName());
+	}
+	spPlace->enterPlace(count, count);
+	return spPlace;
+}
+
+vector<SharedPtrPlace> PlacesManager::incrementInputPlaces(span<const pair<PlaceHandle, size_t>> increments)
+{
+	shared_lock placesGuard(m_itemsMutex);
+
+	// The increments are validated and merged per place before any place is changed.
+	vector<pair<SharedPtrPlace, size_t>> placeIncrements;
+	unordered_map<size_t, size_t> positions;
+	for (const auto &[handle, count] : increments)
+	{
+		if (handle.index >= m_placesByIndex.size())
+		{
+			throw InvalidHandleException(handle.index);
+		}
+		const auto &place = m_placesByIndex[handle.index];
+		if (!place->isInputPlace())
+		{
+			throw NotInputPlaceException(place->getName());
+		}
+		if (count == 0)
+		{
+			throw NullTokensException();
+		}
+		const auto [it, inserted] = positions.try_emplace(handle.index, placeIncrements.size());
+		if (inserted)
+		{
+			placeIncrements.emplace_back(place, 0);
+		}
+		size_t &total = placeIncrements[it->second].second;
+		if (count > ULLONG_MAX - total || total + count > ULLONG_MAX - place->getNumberOfTokens())
+		{
+			throw OverflowException(count);
+		}
+		total += count;
+	}
+
+	vector<SharedPtrPlace> places;
+	places.reserve(placeIncrements.size());
+	for (auto &[place, total] : placeIncrements)
+	{
+		place->enterPlace(total, total);
+		places.push_back(move(place));
+	}
+	return places;
 }
 
 vector<PlaceProperties> PlacesManager::getPlacesProperties() const
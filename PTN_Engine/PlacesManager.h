@@ -22,6 +22,7 @@
 #include "PTN_Engine/PTN_Engine.h"
 #include "PTN_Engine/Place.h"
 #include <shared_mutex>
+#include <span>
 
 namespace ptne
 {
@@ -47,6 +48,13 @@ public:
 	//!
 	void clear();
 
+	//!
+	//! \brief Checks that a place exists and is an input place.
+	//! \throws InvalidHandleException, NotInputPlaceException
+	//! \param place - index of the place.
+	//!
+	void checkInputPlace(const size_t place) const;
+
 	//!
 	//! \brief Sets the number of tokens in the input places to 0.
 	//!
@@ -54,6 +62,12 @@ public:
 
 	bool contains(const std::string &itemName) const;
 
+	//!
+	//! \brief Gets all places.
+	//! \return Shared pointers to all places, in the order they were inserted.
+	//!
+	std::vector<SharedPtrPlace> getAllPlaces() const;
+
 	//!
 	//! \brief Gets the number of tokens in a given place.
 	//! \param place - identifier of a place.
@@ -61,8 +75,31 @@ public:
 	//!
 	size_t getNumberOfTokens(const std::string &place) const;
 
+	//!
+	//! \brief Gets the number of tokens in a given place.
+	//! \param place - index of a place.
+	//! \return Number of tokens inside place.
+	//!
+	size_t getNumberOfTokens(const size_t place) const;
+
 	std::shared_ptr<Place> getPlace(const std::string &placeName) const;
 
+	//!
+	//! \brief Gets a place by its index.
+	//! \throws InvalidHandleException
+	//! \param place - index of the place.
+	//! \return The place.
+	//!
+	std::shared_ptr<Place> getPlace(const size_t place) const;
+
+	//!
+	//! \brief Gets the index of a place.
+	//! \throws InvalidNameException
+	//! \param placeName - name of the place.
+	//! \return The position of the place in the order the places were inserted.
+	//!
+	size_t getPlaceIndex(const std::string &placeName) const;
+
 	std::vector<WeakPtrPlace> getPlaces(const std::vector<std::string> &placesNames) const;
 
 	std::vector<PlaceProperties> getPlacesProperties() const;
@@ -70,10 +107,33 @@ public:
 	//!
 	//! \brief Increment the number of tokens in an input place.
 	//! \param place - Identifier of the input place to increment.
+	//! \param count - number of tokens to add.
+	//! \return The incremented place.
 	//!
-	void incrementInputPlace(const std::string &place);
+	SharedPtrPlace incrementInputPlace(const std::string &place, const size_t count = 1);
 
-	void insert(const std::shared_ptr<Place> &place);
+	//!
+	//! \brief Increment the number of tokens in an input place.
+	//! \param place - index of the input place to increment.
+	//! \param count - number of tokens to add.
+	//! \return The incremented place.
+	//!
+	SharedPtrPlace incrementInputPlace(const size_t place, const size_t count = 1);
+
+	//!
+	//! \brief Increment the number of tokens in several input places. All increments are validated before
+	//! any place is changed, and the increments of the same place are added at once.
+	//! \param increments - pairs of place handle and number of tokens to add.
+	//! \return The incremented places, each one once.
+	//!
+	std::vector<SharedPtrPlace> incrementInputPlaces(std::span<const std::pair<PlaceHandle, size_t>> increments);
+
+	//!
+	//! \brief Add a place.
+	//! \param place - the place to add.
+	//! \return The index of the place, its position in the order the places were inserted.
+	//!
+	size_t insert(const std::shared_ptr<Place> &place);
 
 	//!
 	//! Print the petri net places and number of tokens.
@@ -82,11 +142,17 @@ public:
 	void printState(std::ostream &o) const;
 
 	//!
-	//! \brief Set the action executor in each place.
+	//! \brief Set the action executor in each place that is not on an executor lane.
 	//! \param actionsExecutor - the new actions executor to be used.
 	//!
 	void setActionsExecutor(std::shared_ptr<IActionsExecutor> &actionsExecutor);
 
+	//!
+	//! \brief Wait until no action of any place is in execution or queued, so that the places can be
+	//! destroyed while the executor, possibly shared with other engines, keeps running.
+	//!
+	void waitForActionsInExecution() const;
+
 private:
 	//!
 	//! Shared mutex to synchronize the access to the items(readers-writer lock).
@@ -97,6 +163,16 @@ private:
 	//! \brief Vector with the input places.
 	//!
 	std::vector<WeakPtrPlace> m_inputPlaces;
+
+	//!
+	//! \brief Places in the order they were inserted. The position is the index of the place.
+	//!
+	std::vector<SharedPtrPlace> m_placesByIndex;
+
+	//!
+	//! \brief Index of each place, by name.
+	//!
+	std::unordered_map<std::string, size_t> m_placeIndices;
 };
 
 } // namespace ptne
@@ -25,6 +25,7 @@
 #include "PTN_Engine/Utilities/LockWeakPtr.h"
 #include <algorithm>
 #include <array>
+#include <climits>
 #include <mutex>
 #include <vector>
 
@@ -39,13 +40,15 @@ Transition::Transition(const string &name,
                        const vector<Arc> &destinationArcs,
                        const vector<Arc> &inhibitorArcs,
                        const vector<pair<string, ConditionFunction>> &additionalActivationConditions,
-                       const bool requireNoActionsInExecution)
+                       const bool requireNoActionsInExecution,
+                       const size_t priority)
 : m_name(name)
 , m_activationArcs(activationArcs)
 , m_destinationArcs(destinationArcs)
 , m_additionalActivationConditions(additionalActivationConditions)
 , m_inhibitorArcs(inhibitorArcs)
 , m_requireNoActionsInExecution(requireNoActionsInExecution)
+, m_priority(priority)
 {
 	auto getPlacesFromArcs = [](const vector<Arc> &arcs)
 	{
@@ -71,32 +74,74 @@ Transition::Transition(const string &name,
 	validateWeights(inhibitorArcs);
 }
 
-string Transition::getName() const
+const string &Transition::getName() const
 {
-	shared_lock guard(m_mutex);
+	// The name never changes, no need to lock.
 	return m_name;
 }
 
+size_t Transition::getPriority() const
+{
+	shared_lock guard(m_mutex);
+	return m_priority;
+}
+
 bool Transition::execute()
+{
+	return execute(1) > 0;
+}
+
+size_t Transition::execute(const size_t maxFirings)
 {
 	unique_lock guard(m_mutex);
-	bool result = false;
+	size_t firings = 0;
 
-	blockStartingOnEnterActions(true);
+	{
+		const OnEnterActionsBlock onEnterActionsBlock(*this);
+		if (maxFirings > 0 && isActive())
+		{
+			firings = min(maxFirings, enablingDegree());
+			checkDestinationOverflow(firings);
+			exitActivationPlaces(firings);
+		}
+	}
 
-	if (!isActive())
+	// Released before producing, so that tokens returning to the activation places can start their actions.
+	if (firings > 0)
 	{
-		result = false;
+		enterDestinationPlaces(firings);
 	}
-	else
+
+	return firings;
+}
+
+size_t Transition::consumeTokens(const size_t maxFirings, const bool markingChecked)
+{
+	unique_lock guard(m_mutex);
+	size_t firings = 0;
+
+	const OnEnterActionsBlock onEnterActionsBlock(*this);
+
+	const bool active = markingChecked ?
+						(!m_requireNoActionsInExecution || noActionsInExecution()) && checkAdditionalConditions() :
+						isActive();
+	if (maxFirings > 0 && active)
 	{
-		performTransit();
-		result = true;
+		firings = min(maxFirings, enablingDegree());
+		if (firings > 0)
+		{
+			checkDestinationOverflow(firings);
+			exitActivationPlaces(firings);
+		}
 	}
 
-	blockStartingOnEnterActions(false);
+	return firings;
+}
 
-	return result;
+void Transition::produceTokens(const size_t firings)
+{
+	shared_lock guard(m_mutex);
+	enterDestinationPlaces(firings);
 }
 
 bool Transition::isEnabled() const
@@ -105,6 +150,12 @@ bool Transition::isEnabled() const
 	return isEnabledInternal();
 }
 
+bool Transition::isEnabledAndNoActionsBlocking() const
+{
+	shared_lock guard(m_mutex);
+	return isEnabledInternal() && (!m_requireNoActionsInExecution || noActionsInExecution());
+}
+
 bool Transition::isEnabledInternal() const
 {
 	if (!checkInhibitorPlaces())
@@ -210,20 +261,27 @@ TransitionProperties Transition::getTransitionProperties() const
 	transitionProperties.inhibitorArcs = getProperties(getInhibitorArcs(), ArcProperties::Type::INHIBITOR);
 	transitionProperties.name = getName();
 	transitionProperties.requireNoActionsInExecution = m_requireNoActionsInExecution;
+	transitionProperties.priority = m_priority;
 
 	return transitionProperties;
 }
 
+bool Transition::requireNoActionsInExecution() const
+{
+	shared_lock guard(m_mutex);
+	return m_requireNoActionsInExecution;
+}
+
 void Transition::addArc(const shared_ptr<Place> &place, const ArcProperties::Type type, const size_t weight)
 {
 	unique_lock guard(m_mutex);
 
 	auto addArcTo = [&place, weight](auto &placesContainer)
 	{
-		auto sameNameAs = [&place](const auto &arc)
-		{ return lockWeakPtr(arc.place)->getName() == place->getName(); };
+		// Place names are unique in a net, so comparing the places is enough.
+		auto samePlaceAs = [&place](const auto &arc) { return lockWeakPtr(arc.place) == place; };
 
-		if (ranges::find_if(placesContainer, sameNameAs) != placesContainer.cend())
+		if (ranges::find_if(placesContainer, samePlaceAs) != placesContainer.cend())
 		{
 			throw PTN_Exception("Arc already exists");
 		}
@@ -267,10 +325,9 @@ void Transition::removeArc(const shared_ptr<Place> &place, const ArcProperties::
 
 	auto removePlaceFrom = [&place](auto &placesContainer)
 	{
-		auto sameNameAs = [&place](const auto &arc)
-		{ return lockWeakPtr(arc.place)->getName() == place->getName(); };
+		auto samePlaceAs = [&place](const auto &arc) { return lockWeakPtr(arc.place) == place; };
 
-		auto it = ranges::find_if(placesContainer, sameNameAs);
+		auto it = ranges::find_if(placesContainer, samePlaceAs);
 		if (it != placesContainer.cend())
 		{
 			placesContainer.erase(it);
@@ -363,13 +420,34 @@ bool Transition::noActionsInExecution() const
 	return true;
 }
 
-void Transition::performTransit() const
+size_t Transition::enablingDegree() const
 {
-	exitActivationPlaces();
-	enterDestinationPlaces();
+	if (m_activationArcs.empty())
+	{
+		// Nothing limits how many times it could fire, so it fires once per cycle.
+		return 1;
+	}
+
+	size_t degree = ULLONG_MAX;
+	for (const Arc &activationArc : m_activationArcs)
+	{
+		degree = min(degree, lockWeakPtr(activationArc.place)->getNumberOfTokens() / activationArc.weight);
+	}
+	return degree;
 }
 
-void Transition::exitActivationPlaces() const
+void Transition::checkDestinationOverflow(const size_t firings) const
+{
+	for (const Arc &destinationArc : m_destinationArcs)
+	{
+		if (destinationArc.weight > ULLONG_MAX / firings)
+		{
+			throw OverflowException(destinationArc.weight);
+		}
+	}
+}
+
+void Transition::exitActivationPlaces(const size_t firings) const
 {
 	for (const Arc &activationArc : m_activationArcs)
 	{
@@ -378,12 +456,12 @@ void Transition::exitActivationPlaces() const
 
 		if (SharedPtrPlace spPlace = lockWeakPtr(activationPlace))
 		{
-			spPlace->exitPlace(activationWeight);
+			spPlace->exitPlace(activationWeight * firings, firings);
 		}
 	}
 }
 
-void Transition::enterDestinationPlaces() const
+void Transition::enterDestinationPlaces(const size_t firings) const
 {
 	for (const Arc &destinationArc : m_destinationArcs)
 	{
@@ -392,7 +470,7 @@ void Transition::enterDestinationPlaces() const
 
 		if (SharedPtrPlace spPlace = lockWeakPtr(destinationPlace))
 		{
-			spPlace->enterPlace(destinationWeight);
+			spPlace->enterPlace(destinationWeight * firings, firings);
 		}
 	}
 }
@@ -406,11 +484,22 @@ void Transition::blockStartingOnEnterActions(const bool value) const
 
 	for (const Arc &activationArc : m_activationArcs)
 	{
-		const WeakPtrPlace &activationPlace = activationArc.place;
-		if (SharedPtrPlace spPlace = lockWeakPtr(activationPlace))
+		// Expired places cannot start actions, skipping them keeps blocks and releases balanced.
+		if (SharedPtrPlace spPlace = activationArc.place.lock())
 		{
 			spPlace->blockStartingOnEnterActions(value);
 		}
 	}
 }
+
+Transition::OnEnterActionsBlock::OnEnterActionsBlock(const Transition &transition)
+: m_transition(transition)
+{
+	m_transition.blockStartingOnEnterActions(true);
+}
+
+Transition::OnEnterActionsBlock::~OnEnterActionsBlock()
+{
+	m_transition.blockStartingOnEnterActions(false);
+}
 } // namespace ptne
@@ -56,13 +56,15 @@ public:
 	//! \param additionalActivationConditions - vector of additional conditions
 	//! \param requireNoActionsInExecution - flag if the transition requires no onEnter actions in execution in
 	//! order to fire.
+	//! \param priority - priority over the transitions competing for the same tokens.
 	//!
 	Transition(const std::string &name,
 			   const std::vector<Arc> &activationArcs,
 			   const std::vector<Arc> &destinationArcs,
 			   const std::vector<Arc> &inhibitorArcs,
 			   const std::vector<std::pair<std::string, ConditionFunction>> &additionalActivationConditions,
-			   const bool requireNoActionsInExecution);
+			   const bool requireNoActionsInExecution,
+			   const size_t priority = 1);
 
 	Transition(const Transition &) = delete;
 	Transition(Transition &&transition) = delete;
@@ -77,6 +79,31 @@ public:
 	//!
 	bool execute();
 
+	//!
+	//! Fire the transition as many times as the tokens in its activation places allow, in one step.
+	//! The additional conditions are evaluated once for all firings.
+	//! \param maxFirings - maximum number of times to fire.
+	//! \return The number of times the transition was fired.
+	//!
+	size_t execute(const size_t maxFirings);
+
+	//!
+	//! Fire the transition, only removing the tokens from the activation places. Used to fire several
+	//! transitions as one step, where produceTokens is called after all transitions consumed their tokens.
+	//! \param maxFirings - maximum number of times to fire.
+	//! \param markingChecked - true if the transition was found enabled by the marking it still has, because no
+	//! other transition consumes from its activation places, so that only the additional conditions and the
+	//! actions in execution are checked again.
+	//! \return The number of times the transition was fired.
+	//!
+	size_t consumeTokens(const size_t maxFirings, const bool markingChecked);
+
+	//!
+	//! Insert the tokens in the destination places, completing the firings started by consumeTokens.
+	//! \param firings - number of times the transition was fired.
+	//!
+	void produceTokens(const size_t firings);
+
 	std::vector<Arc> getActivationArcs() const;
 
 	//!
@@ -85,6 +112,13 @@ public:
 	//!
 	bool isEnabled() const;
 
+	//!
+	//! \brief Evaluates if the transition is enabled and, if it requires so, no on enter actions of its
+	//! activation places are in execution. The additional conditions are not evaluated.
+	//! \return true if the transition is only waiting for its additional conditions, if any.
+	//!
+	bool isEnabledAndNoActionsBlocking() const;
+
 	//!
 	//! \brief Get all additional activation conditions.
 	//! \return A vector of function name, ConditionFunction pairs.
@@ -95,7 +129,13 @@ public:
 
 	std::vector<Arc> getInhibitorArcs() const;
 
-	std::string getName() const;
+	const std::string &getName() const;
+
+	//!
+	//! \brief Priority over the transitions competing for the same tokens.
+	//! \return The priority of the transition.
+	//!
+	size_t getPriority() const;
 
 	//!
 	//! \brief Describe all the transition's internals in a TransitionProperties object.
@@ -103,6 +143,12 @@ public:
 	//!
 	TransitionProperties getTransitionProperties() const;
 
+	//!
+	//! \brief Whether the transition requires no on enter actions in execution in its activation places.
+	//! \return The requireNoActionsInExecution flag.
+	//!
+	bool requireNoActionsInExecution() const;
+
 	//!
 	//! \brief Remove the arc from the transition.
 	//! \param place - place pointing to or from the transition.
@@ -111,6 +157,25 @@ public:
 	void removeArc(const std::shared_ptr<Place> &place, const ArcProperties::Type type);
 
 private:
+	//!
+	//! \brief Blocks the activation places from starting on enter actions during its lifetime, if the
+	//! transition requires no actions in execution. Releases the blocks even if firing throws.
+	//!
+	class OnEnterActionsBlock final
+	{
+	public:
+		explicit OnEnterActionsBlock(const Transition &transition);
+		~OnEnterActionsBlock();
+		OnEnterActionsBlock(const OnEnterActionsBlock &) = delete;
+		OnEnterActionsBlock(OnEnterActionsBlock &&) = delete;
+		OnEnterActionsBlock &operator=(const OnEnterActionsBlock &) = delete;
+		OnEnterActionsBlock &operator=(OnEnterActionsBlock &&) = delete;
+
+	private:
+		//! The transition whose activation places are blocked.
+		const Transition &m_transition;
+	};
+
 	//! Block/unblock activation places from starting any on enter actions.
 	void blockStartingOnEnterActions(const bool value) const;
 
@@ -132,11 +197,30 @@ private:
 	//!
 	bool checkAdditionalConditions() const;
 
-	//! Inserts tokens in the destination places.
-	void enterDestinationPlaces() const;
+	//!
+	//! \brief Throws if the tokens produced by firing several times do not fit in a size_t.
+	//! \param firings - number of times the transition is fired.
+	//!
+	void checkDestinationOverflow(const size_t firings) const;
+
+	//!
+	//! \brief Number of times the transition can fire with the tokens in the activation places.
+	//! \return The minimum, over all activation arcs, of the tokens divided by the weight. 1 if there are no
+	//! activation arcs.
+	//!
+	size_t enablingDegree() const;
+
+	//!
+	//! \brief Inserts tokens in the destination places.
+	//! \param firings - number of times the transition is fired.
+	//!
+	void enterDestinationPlaces(const size_t firings) const;
 
-	//! Removes the tokens from the activation places.
-	void exitActivationPlaces() const;
+	//!
+	//! \brief Removes the tokens from the activation places.
+	//! \param firings - number of times the transition is fired.
+	//!
+	void exitActivationPlaces(const size_t firings) const;
 
 	//!
 	//! \brief Evaluates if the transition can be fired.
@@ -156,9 +240,6 @@ private:
 	//!
 	bool noActionsInExecution() const;
 
-	//! Moves the tokens from the inputs to the outputs.
-	void performTransit() const;
-
 	std::vector<Arc> m_activationArcs;
 
 	//! Pointers to the controller's functions that evaluate if the transition can be fired.
@@ -172,11 +253,14 @@ private:
 	mutable std::shared_mutex m_mutex;
 
 	//! \brief Name that identifies the transition.
-	std::string m_name;
+	const std::string m_name;
 
 	//! If on, the transition will only be activated if, besides all other conditions,
 	//! the activation places have no on enter actions in execution.
 	bool m_requireNoActionsInExecution = false;
+
+	//! Priority over the transitions competing for the same tokens.
+	size_t m_priority = 1;
 };
 
 } // namespace ptne
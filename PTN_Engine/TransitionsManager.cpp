@@ -19,17 +19,31 @@
  */
 
 #include "PTN_Engine/TransitionsManager.h"
+#include "PTN_Engine/ConflictResolution/ConflictResolverFactory.h"
 #include "PTN_Engine/Transition.h"
+#include "PTN_Engine/Utilities/LockWeakPtr.h"
 #include <algorithm>
 #include <mutex>
-#include <random>
 
 namespace ptne
 {
 using namespace std;
 
+namespace
+{
+constexpr size_t npos = static_cast<size_t>(-1);
+}
+
 TransitionsManager::~TransitionsManager() = default;
-TransitionsManager::TransitionsManager() = default;
+TransitionsManager::TransitionsManager()
+: TransitionsManager(ConflictResolverFactory::createConflictResolver())
+{
+}
+
+TransitionsManager::TransitionsManager(unique_ptr<IConflictResolver> conflictResolver)
+: m_conflictResolver(move(conflictResolver))
+{
+}
 
 bool TransitionsManager::contains(const string &itemName) const
 {
@@ -37,44 +51,196 @@ bool TransitionsManager::contains(const string &itemName) const
 	return ManagerBase<Transition>::contains(itemName);
 }
 
-void TransitionsManager::insert(shared_ptr<Transition> transition)
+size_t TransitionsManager::insert(shared_ptr<Transition> transition)
 {
 	unique_lock itemsGuard(m_itemsMutex);
 	ManagerBase<Transition>::insert(transition);
+
+	const size_t index = m_transitionsByIndex.size();
+	m_transitionIndices[transition.get()] = index;
+	m_transitionsByIndex.push_back(transition);
+	m_touchedPlaces.emplace_back();
+	m_enabledPositions.push_back(npos);
+	indexDependencies(index);
+	m_conflictGroupsOutdated = true;
+
+	lock_guard dirtyGuard(m_dirtyMutex);
+	m_isDirty.push_back(false);
+	markDirtyInternal(index);
+	return index;
 }
 
 void TransitionsManager::clear()
 {
 	unique_lock itemsGuard(m_itemsMutex);
 	ManagerBase<Transition>::clear();
+	m_transitionsByIndex.clear();
+	m_transitionIndices.clear();
+	m_placeDependents.clear();
+	m_touchedPlaces.clear();
+	m_enabledPositions.clear();
+	m_enabledTransitions.clear();
+	m_conflictGroupsOutdated = true;
+
+	lock_guard dirtyGuard(m_dirtyMutex);
+	m_isDirty.clear();
+	m_dirtyTransitions.clear();
 }
 
-vector<weak_ptr<Transition>> TransitionsManager::collectEnabledTransitionsRandomly() const
+void TransitionsManager::addArc(const string &transitionName,
+								const SharedPtrPlace &place,
+								const ArcProperties::Type type,
+								const size_t weight)
 {
-	shared_lock transitionsGuard(m_itemsMutex);
+	unique_lock itemsGuard(m_itemsMutex);
+	const auto transition = ManagerBase<Transition>::getItem(transitionName);
+	addArcInternal(m_transitionIndices.at(transition.get()), place, type, weight);
+}
 
-	vector<weak_ptr<Transition>> enabledTransitions;
-	for (const auto &[_, transition] : m_items)
+void TransitionsManager::addArc(const size_t transition,
+								const SharedPtrPlace &place,
+								const ArcProperties::Type type,
+								const size_t weight)
+{
+	unique_lock itemsGuard(m_itemsMutex);
+	checkIndex(transition);
+	addArcInternal(transition, place, type, weight);
+}
+
+void TransitionsManager::removeArc(const string &transitionName,
+								   const SharedPtrPlace &place,
+								   const ArcProperties::Type type)
+{
+	unique_lock itemsGuard(m_itemsMutex);
+	const auto transition = ManagerBase<Transition>::getItem(transitionName);
+	removeArcInternal(m_transitionIndices.at(transition.get()), place, type);
+}
+
+void TransitionsManager::removeArc(const size_t transition,
+								   const SharedPtrPlace &place,
+								   const ArcProperties::Type type)
+{
+	unique_lock itemsGuard(m_itemsMutex);
+	checkIndex(transition);
+	removeArcInternal(transition, place, type);
+}
+
+void TransitionsManager::markAllDirty()
+{
+	shared_lock itemsGuard(m_itemsMutex);
+	lock_guard dirtyGuard(m_dirtyMutex);
+	for (size_t index = 0; index < m_transitionsByIndex.size(); ++index)
+	{
+		markDirtyInternal(index);
+	}
+}
+
+void TransitionsManager::markDirty(const Place &place)
+{
+	shared_lock itemsGuard(m_itemsMutex);
+	const auto it = m_placeDependents.find(&place);
+	if (it == m_placeDependents.end())
 	{
-		if (transition->isEnabled())
+		return;
+	}
+	lock_guard dirtyGuard(m_dirtyMutex);
+	for (const size_t index : it->second)
+	{
+		markDirtyInternal(index);
+	}
+}
+
+void TransitionsManager::markDirty(const Transition &firedTransition)
+{
+	shared_lock itemsGuard(m_itemsMutex);
+	const auto itIndex = m_transitionIndices.find(&firedTransition);
+	if (itIndex == m_transitionIndices.end())
+	{
+		return;
+	}
+	lock_guard dirtyGuard(m_dirtyMutex);
+	for (const Place *place : m_touchedPlaces[itIndex->second])
+	{
+		if (const auto it = m_placeDependents.find(place); it != m_placeDependents.end())
 		{
-			enabledTransitions.push_back(transition);
+			for (const size_t index : it->second)
+			{
+				markDirtyInternal(index);
+			}
 		}
 	}
+}
 
-	// TO DO check performance
-	random_device randomDevice;
-	mt19937_64 seed(randomDevice());
-	ranges::shuffle(enabledTransitions, seed);
+vector<weak_ptr<Transition>> TransitionsManager::collectEnabledTransitionsRandomly()
+{
+	unique_lock transitionsGuard(m_itemsMutex);
+
+	{
+		lock_guard dirtyGuard(m_dirtyMutex);
+		swap(m_evaluationWorklist, m_dirtyTransitions);
+		for (const size_t index : m_evaluationWorklist)
+		{
+			m_isDirty[index] = false;
+		}
+	}
+
+	for (const size_t index : m_evaluationWorklist)
+	{
+		// Transitions blocked by actions in execution are re-evaluated once the actions complete.
+		updateEnabled(index, m_transitionsByIndex[index]->isEnabledAndNoActionsBlocking());
+	}
+	m_evaluationWorklist.clear();
+
+	if (m_conflictGroupsOutdated)
+	{
+		m_conflictGroups.build(m_transitionsByIndex);
+		m_conflictGroupsOutdated = false;
+	}
+	m_orderedEnabledTransitions.assign(m_enabledTransitions.begin(), m_enabledTransitions.end());
+	m_conflictGroups.resolve(m_orderedEnabledTransitions, *m_conflictResolver);
+
+	vector<weak_ptr<Transition>> enabledTransitions;
+	enabledTransitions.reserve(m_orderedEnabledTransitions.size());
+	for (const size_t index : m_orderedEnabledTransitions)
+	{
+		enabledTransitions.push_back(m_transitionsByIndex[index]);
+	}
 	return enabledTransitions;
 }
 
+bool TransitionsManager::enabledTransitionHasConflicts(const size_t position) const
+{
+	return m_conflictGroups.hasConflicts(m_orderedEnabledTransitions.at(position));
+}
+
+vector<SharedPtrTransition> TransitionsManager::getAllTransitions() const
+{
+	shared_lock itemsGuard(m_itemsMutex);
+	return m_transitionsByIndex;
+}
+
+IConflictResolver &TransitionsManager::getConflictResolver() const
+{
+	return *m_conflictResolver;
+}
+
 SharedPtrTransition TransitionsManager::getTransition(const string &transitionName) const
 {
 	shared_lock itemsGuard(m_itemsMutex);
 	return ManagerBase<Transition>::getItem(transitionName);
 }
 
+size_t TransitionsManager::getTransitionIndex(const string &transitionName) const
+{
+	shared_lock itemsGuard(m_itemsMutex);
+	const auto it = m_items.find(transitionName);
+	if (it == m_items.end())
+	{
+		throw InvalidNameException(transitionName);
+	}
+	return m_transitionIndices.at(it->second.get());
+}
+
 vector<TransitionProperties> TransitionsManager::getTransitionsProperties() const
 {
 	shared_lock itemsGuard(m_itemsMutex);
@@ -86,4 +252,130 @@ vector<TransitionProperties> TransitionsManager::getTransitionsProperties() cons
 	return transitionsProperties;
 }
 
+// Private
+
+void TransitionsManager::addArcInternal(const size_t index,
+										const SharedPtrPlace &place,
+										const ArcProperties::Type type,
+										const size_t weight)
+{
+	const auto &transition = m_transitionsByIndex[index];
+	unindexDependencies(index);
+	try
+	{
+		transition->addArc(place, type, weight);
+	}
+	catch (...)
+	{
+		indexDependencies(index);
+		throw;
+	}
+	indexDependencies(index);
+	m_conflictGroupsOutdated = true;
+
+	lock_guard dirtyGuard(m_dirtyMutex);
+	markDirtyInternal(index);
+}
+
+void TransitionsManager::removeArcInternal(const size_t index,
+										   const SharedPtrPlace &place,
+										   const ArcProperties::Type type)
+{
+	const auto &transition = m_transitionsByIndex[index];
+	unindexDependencies(index);
+	try
+	{
+		transition->removeArc(place, type);
+	}
+	catch (...)
+	{
+		indexDependencies(index);
+		throw;
+	}
+	indexDependencies(index);
+	m_conflictGroupsOutdated = true;
+
+	lock_guard dirtyGuard(m_dirtyMutex);
+	markDirtyInternal(index);
+}
+
+void TransitionsManager::indexDependencies(const size_t index)
+{
+	const auto &transition = m_transitionsByIndex[index];
+	for (const auto &arcs : { transition->getActivationArcs(), transition->getInhibitorArcs() })
+	{
+		for (const Arc &arc : arcs)
+		{
+			m_placeDependents[lockWeakPtr(arc.place).get()].push_back(index);
+		}
+	}
+
+	auto &touchedPlaces = m_touchedPlaces[index];
+	touchedPlaces.clear();
+	for (const auto &arcs : { transition->getActivationArcs(), transition->getDestinationArcs() })
+	{
+		for (const Arc &arc : arcs)
+		{
+			touchedPlaces.push_back(lockWeakPtr(arc.place).get());
+		}
+	}
+}
+
+void TransitionsManager::unindexDependencies(const size_t index)
+{
+	const auto &transition = m_transitionsByIndex[index];
+	for (const auto &arcs : { transition->getActivationArcs(), transition->getInhibitorArcs() })
+	{
+		for (const Arc &arc : arcs)
+		{
+			const auto it = m_placeDependents.find(lockWeakPtr(arc.place).get());
+			if (it == m_placeDependents.end())
+			{
+				continue;
+			}
+			erase(it->second, index);
+			if (it->second.empty())
+			{
+				m_placeDependents.erase(it);
+			}
+		}
+	}
+	m_touchedPlaces[index].clear();
+}
+
+void TransitionsManager::checkIndex(const size_t index) const
+{
+	if (index >= m_transitionsByIndex.size())
+	{
+		throw InvalidHandleException(index);
+	}
+}
+
+void TransitionsManager::markDirtyInternal(const size_t index)
+{
+	if (!m_isDirty[index])
+	{
+		m_isDirty[index] = true;
+		m_dirtyTransitions.push_back(index);
+	}
+}
+
+void TransitionsManager::updateEnabled(const size_t index, const bool isEnabled)
+{
+	const size_t position = m_enabledPositions[index];
+	if (isEnabled && position == npos)
+	{
+		m_enabledPositions[index] = m_enabledTransitions.size();
+		m_enabledTransitions.push_back(index);
+	}
+	else if (!isEnabled && position != npos)
+	{
+		const size_t lastIndex = m_enabledTransitions.back();
+		m_enabledTransitions[position] = lastIndex;
+		m_enabledPositions[lastIndex] = position;
+		m_enabledTransitions.pop_back();
+		m_enabledPositions[index] = npos;
+	}
+}
+
 } // namespace ptne
@@ -20,9 +20,14 @@
 
 #pragma once
 
+#include "PTN_Engine/ConflictResolution/ConflictGroups.h"
+#include "PTN_Engine/ConflictResolution/IConflictResolver.h"
 #include "PTN_Engine/ManagerBase.h"
 #include "PTN_Engine/Transition.h"
+#include <mutex>
 #include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace ptne
 {
@@ -38,6 +43,12 @@ class TransitionsManager : private ManagerBase<Transition>
 public:
 	~TransitionsManager();
 	TransitionsManager();
+
+	//!
+	//! \brief TransitionsManager constructor.
+	//! \param conflictResolver - decides the order of enabled transitions competing for the same tokens.
+	//!
+	explicit TransitionsManager(std::unique_ptr<IConflictResolver> conflictResolver);
 	TransitionsManager(const TransitionsManager &) = delete;
 	TransitionsManager(TransitionsManager &&) = delete;
 	TransitionsManager &operator=(const TransitionsManager &) = delete;
@@ -49,22 +60,209 @@ public:
 	void clear();
 
 	//!
-	//! \brief collectEnabledTransitionsRandomly
+	//! \brief Add an arc to a transition, keeping the place dependencies up to date.
+	//! \param transitionName - name of the transition.
+	//! \param place - place to link to the transition.
+	//! \param type - the type of arc.
+	//! \param weight - the weight of the arc.
+	//!
+	void addArc(const std::string &transitionName,
+				const SharedPtrPlace &place,
+				const ArcProperties::Type type,
+				const size_t weight);
+
+	//!
+	//! \brief Add an arc to a transition, keeping the place dependencies up to date.
+	//! \throws InvalidHandleException
+	//! \param transition - index of the transition.
+	//! \param place - place to link to the transition.
+	//! \param type - the type of arc.
+	//! \param weight - the weight of the arc.
+	//!
+	void addArc(const size_t transition,
+				const SharedPtrPlace &place,
+				const ArcProperties::Type type,
+				const size_t weight);
+
+	//!
+	//! \brief Re-evaluates the transitions flagged as dirty and collects all enabled transitions, leaving out
+	//! the ones waiting for actions in execution of their activation places.
+	//! Enabled transitions competing for the same tokens are ordered by the conflict resolver.
 	//! \return A vector of weak pointers to the enabled transitions.
 	//!
-	std::vector<WeakPtrTransition> collectEnabledTransitionsRandomly() const;
+	std::vector<WeakPtrTransition> collectEnabledTransitionsRandomly();
+
+	//!
+	//! \brief Whether an enabled transition shares its activation places with other transitions. Only called by
+	//! the thread executing the net, after collectEnabledTransitionsRandomly.
+	//! \param position - position of the transition in the last result of collectEnabledTransitionsRandomly.
+	//! \return False if no other transition can consume tokens from its activation places.
+	//!
+	bool enabledTransitionHasConflicts(const size_t position) const;
 
 	bool contains(const std::string &itemName) const;
 
+	//!
+	//! \brief Gets all transitions.
+	//! \return Shared pointers to all transitions, in the order they were inserted.
+	//!
+	std::vector<SharedPtrTransition> getAllTransitions() const;
+
+	//!
+	//! \brief Gets the conflict resolver, whose state is kept for as long as the manager exists.
+	//! \return The conflict resolver.
+	//!
+	IConflictResolver &getConflictResolver() const;
+
 	SharedPtrTransition getTransition(const std::string &transitionName) const;
 
+	//!
+	//! \brief Gets the index of a transition.
+	//! \throws InvalidNameException
+	//! \param transitionName - name of the transition.
+	//! \return The position of the transition in the order the transitions were inserted.
+	//!
+	size_t getTransitionIndex(const std::string &transitionName) const;
+
 	std::vector<TransitionProperties> getTransitionsProperties() const;
 
-	void insert(std::shared_ptr<Transition> transition);
+	//!
+	//! \brief Add a transition.
+	//! \param transition - the transition to add.
+	//! \return The index of the transition, its position in the order the transitions were inserted.
+	//!
+	size_t insert(std::shared_ptr<Transition> transition);
+
+	//!
+	//! \brief Flag all transitions to be re-evaluated in the next collection.
+	//!
+	void markAllDirty();
+
+	//!
+	//! \brief Flag the transitions with activation or inhibitor arcs from a place to be re-evaluated.
+	//! \param place - place whose number of tokens changed.
+	//!
+	void markDirty(const Place &place);
+
+	//!
+	//! \brief Flag the transitions affected by firing a transition to be re-evaluated.
+	//! \param firedTransition - transition that moved tokens.
+	//!
+	void markDirty(const Transition &firedTransition);
+
+	//!
+	//! \brief Remove an arc from a transition, keeping the place dependencies up to date.
+	//! \param transitionName - name of the transition.
+	//! \param place - place linked to the transition.
+	//! \param type - the type of arc.
+	//!
+	void removeArc(const std::string &transitionName, const SharedPtrPlace &place, const ArcProperties::Type type);
+
+	//!
+	//! \brief Remove an arc from a transition, keeping the place dependencies up to date.
+	//! \throws InvalidHandleException
+	//! \param transition - index of the transition.
+	//! \param place - place linked to the transition.
+	//! \param type - the type of arc.
+	//!
+	void removeArc(const size_t transition, const SharedPtrPlace &place, const ArcProperties::Type type);
 
 private:
+	//!
+	//! \brief Add an arc to a transition. m_itemsMutex must be held exclusively.
+	//! \param index - index of the transition.
+	//! \param place - place to link to the transition.
+	//! \param type - the type of arc.
+	//! \param weight - the weight of the arc.
+	//!
+	void addArcInternal(const size_t index,
+						const SharedPtrPlace &place,
+						const ArcProperties::Type type,
+						const size_t weight);
+
+	//!
+	//! \brief Remove an arc from a transition. m_itemsMutex must be held exclusively.
+	//! \param index - index of the transition.
+	//! \param place - place linked to the transition.
+	//! \param type - the type of arc.
+	//!
+	void removeArcInternal(const size_t index, const SharedPtrPlace &place, const ArcProperties::Type type);
+
+	//!
+	//! \brief Throws if an index does not identify a transition. m_itemsMutex must be held.
+	//! \param index - index of the transition.
+	//!
+	void checkIndex(const size_t index) const;
+
+	//!
+	//! \brief Add the transition to the dependents of its activation and inhibitor places.
+	//! \param index - index of the transition.
+	//!
+	void indexDependencies(const size_t index);
+
+	//!
+	//! \brief Flag a transition to be re-evaluated. m_dirtyMutex must be held.
+	//! \param index - index of the transition.
+	//!
+	void markDirtyInternal(const size_t index);
+
+	//!
+	//! \brief Remove the transition from the dependents of its activation and inhibitor places.
+	//! \param index - index of the transition.
+	//!
+	void unindexDependencies(const size_t index);
+
+	//!
+	//! \brief Update the enabled transitions list with the evaluation of a transition.
+	//! \param index - index of the transition.
+	//! \param isEnabled - result of the evaluation.
+	//!
+	void updateEnabled(const size_t index, const bool isEnabled);
+
 	//! Shared mutex to synchronize the access to the items(readers-writer lock).
 	mutable std::shared_mutex m_itemsMutex;
+
+	//! Transitions in the order they were inserted. The position is the index of the transition.
+	std::vector<SharedPtrTransition> m_transitionsByIndex;
+
+	//! Index of each transition in m_transitionsByIndex.
+	std::unordered_map<const Transition *, size_t> m_transitionIndices;
+
+	//! Indexes of the transitions with activation or inhibitor arcs from each place.
+	std::unordered_map<const Place *, std::vector<size_t>> m_placeDependents;
+
+	//! Activation and destination places of each transition, whose tokens change when it fires.
+	std::vector<std::vector<const Place *>> m_touchedPlaces;
+
+	//! Mutex protecting the dirty worklist, which can be written from any thread.
+	std::mutex m_dirtyMutex;
+
+	//! Whether a transition is already in the dirty worklist.
+	std::vector<bool> m_isDirty;
+
+	//! Transitions waiting to be re-evaluated.
+	std::vector<size_t> m_dirtyTransitions;
+
+	//! Worklist being evaluated, swapped with m_dirtyTransitions to reuse its storage.
+	std::vector<size_t> m_evaluationWorklist;
+
+	//! Position of each transition in m_enabledTransitions, or npos if disabled.
+	std::vector<size_t> m_enabledPositions;
+
+	//! Indexes of the transitions that were enabled on their last evaluation.
+	std::vector<size_t> m_enabledTransitions;
+
+	//! Decides the order of enabled transitions competing for the same tokens.
+	std::unique_ptr<IConflictResolver> m_conflictResolver;
+
+	//! Transitions that can compete for the same tokens.
+	ConflictGroups m_conflictGroups;
+
+	//! Whether the structure changed since the conflict groups were computed.
+	bool m_conflictGroupsOutdated = true;
+
+	//! Enabled transitions being ordered. Reused between collections.
+	std::vector<size_t> m_orderedEnabledTransitions;
 };
 
 } // namespace ptne
@@ -0,0 +1,136 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ptne::utility
+{
+
+//!
+//! \brief Double ended queue over a circular buffer that grows as needed and never shrinks.
+//!
+//! Unlike std::deque, which allocates and frees blocks as items flow through it, it keeps its storage, so
+//! that a queue in steady state does not allocate. Removed items are reset to a default constructed T,
+//! releasing what they hold.
+//!
+template <typename T>
+class RingDeque final
+{
+public:
+	//!
+	//! \brief Tells if there are no items.
+	//! \return True if empty.
+	//!
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	//!
+	//! \brief Number of items.
+	//! \return The number of items.
+	//!
+	size_t size() const
+	{
+		return m_size;
+	}
+
+	//!
+	//! \brief Add an item after the last one, growing the storage if it is full.
+	//! \param item - item to add.
+	//!
+	void push_back(T &&item)
+	{
+		if (m_size == m_items.size())
+		{
+			grow();
+		}
+		m_items[(m_first + m_size) % m_items.size()] = std::move(item);
+		++m_size;
+	}
+
+	//!
+	//! \brief First item. Must not be empty.
+	//! \return Reference to the first item.
+	//!
+	T &front()
+	{
+		return m_items[m_first];
+	}
+
+	//!
+	//! \brief Last item. Must not be empty.
+	//! \return Reference to the last item.
+	//!
+	T &back()
+	{
+		return m_items[(m_first + m_size - 1) % m_items.size()];
+	}
+
+	//!
+	//! \brief Remove the first item. Must not be empty.
+	//!
+	void pop_front()
+	{
+		front() = T();
+		m_first = (m_first + 1) % m_items.size();
+		--m_size;
+	}
+
+	//!
+	//! \brief Remove the last item. Must not be empty.
+	//!
+	void pop_back()
+	{
+		back() = T();
+		--m_size;
+	}
+
+private:
+	//!
+	//! \brief Double the storage, moving the items to its beginning.
+	//!
+	void grow()
+	{
+		std::vector<T> items(m_items.empty() ? initialCapacity : 2 * m_items.size());
+		for (size_t i = 0; i < m_size; ++i)
+		{
+			items[i] = std::move(m_items[(m_first + i) % m_items.size()]);
+		}
+		m_items = std::move(items);
+		m_first = 0;
+	}
+
+	//! Number of items the storage is created with.
+	static constexpr size_t initialCapacity = 16;
+
+	//! Storage of the items, from m_first, wrapping around.
+	std::vector<T> m_items;
+
+	//! Position of the first item.
+	size_t m_first = 0;
+
+	//! Number of items.
+	size_t m_size = 0;
+};
+
+} // namespace ptne::utility
@@ -0,0 +1,222 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace ptne::utility
+{
+
+//!
+//! \brief Bounded lock-free ring of items, written by any number of producers.
+//!
+//! Each cell of the ring carries a sequence number telling whether it is free for the producer claiming that
+//! position or holds an item ready for the consumer claiming that position, so that threads only contend on a
+//! compare and swap of the enqueue or dequeue position and never wait for each other. Items are taken either
+//! by any number of consumers with pop, or by a single consumer with popSingleConsumer, which needs no compare
+//! and swap.
+//!
+template <typename T>
+class SequenceRing final
+{
+public:
+	//!
+	//! \brief SequenceRing constructor.
+	//! \param capacity - maximum number of items, rounded up to a power of 2 of at least 2. At least 1.
+	//!
+	explicit SequenceRing(const size_t capacity)
+	: m_cells(std::make_unique<Cell[]>(ringSize(capacity)))
+	, m_mask(ringSize(capacity) - 1)
+	{
+		for (size_t i = 0; i <= m_mask; ++i)
+		{
+			m_cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	SequenceRing(const SequenceRing &) = delete;
+	SequenceRing(SequenceRing &&) = delete;
+	SequenceRing &operator=(const SequenceRing &) = delete;
+	SequenceRing &operator=(SequenceRing &&) = delete;
+
+	//!
+	//! \brief Maximum number of items.
+	//! \return The capacity of the ring.
+	//!
+	size_t capacity() const
+	{
+		return m_mask + 1;
+	}
+
+	//!
+	//! \brief Add an item to the ring. Can be called from any thread.
+	//! \param item - the item to add, moved from only if it was added.
+	//! \return False if the ring is full.
+	//!
+	template <typename U>
+	bool push(U &&item)
+	{
+		size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+		Cell *cell = nullptr;
+		while (true)
+		{
+			cell = &m_cells[position & m_mask];
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const auto difference = static_cast<ptrdiff_t>(sequence - position);
+			if (difference == 0)
+			{
+				if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (difference < 0)
+			{
+				// The cell still holds the item written one lap before.
+				return false;
+			}
+			else
+			{
+				position = m_enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+		cell->item = std::forward<U>(item);
+		cell->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	//!
+	//! \brief Take the oldest item from the ring. Can be called from any thread.
+	//! \param item - receives the item taken.
+	//! \return False if the ring is empty.
+	//!
+	bool pop(T &item)
+	{
+		size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+		Cell *cell = nullptr;
+		while (true)
+		{
+			cell = &m_cells[position & m_mask];
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const auto difference = static_cast<ptrdiff_t>(sequence - (position + 1));
+			if (difference == 0)
+			{
+				if (m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (difference < 0)
+			{
+				// The cell was not written yet.
+				return false;
+			}
+			else
+			{
+				position = m_dequeuePosition.load(std::memory_order_relaxed);
+			}
+		}
+		take(*cell, position, item);
+		return true;
+	}
+
+	//!
+	//! \brief Take the oldest item from the ring. Must only be called by the only consumer of the ring.
+	//! \param item - receives the item taken.
+	//! \return False if the ring is empty.
+	//!
+	bool popSingleConsumer(T &item)
+	{
+		const size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+		Cell &cell = m_cells[position & m_mask];
+		if (cell.sequence.load(std::memory_order_acquire) != position + 1)
+		{
+			return false;
+		}
+		m_dequeuePosition.store(position + 1, std::memory_order_relaxed);
+		take(cell, position, item);
+		return true;
+	}
+
+	//!
+	//! \brief Tells if there are no items ready to be taken.
+	//! \return True if the ring is empty.
+	//!
+	bool empty() const
+	{
+		const size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+		return m_cells[position & m_mask].sequence.load(std::memory_order_acquire) != position + 1;
+	}
+
+private:
+	//!
+	//! \brief Position of the ring holding one item.
+	//!
+	struct Cell
+	{
+		//! Equal to the enqueue position while free, to that position + 1 once the item was written.
+		std::atomic<size_t> sequence;
+
+		//! The item.
+		T item;
+	};
+
+	//!
+	//! \brief Number of cells holding a given capacity.
+	//! \param capacity - requested capacity.
+	//! \return The capacity rounded up to a power of 2 of at least 2.
+	//!
+	static size_t ringSize(const size_t capacity)
+	{
+		// With a single cell, a written cell would look free to the producer of the next lap.
+		return std::bit_ceil(std::max<size_t>(capacity, 2));
+	}
+
+	//!
+	//! \brief Move the item out of a claimed cell and free the cell for the producer of the next lap.
+	//! \param cell - the cell claimed by the consumer.
+	//! \param position - dequeue position of the cell.
+	//! \param item - receives the item.
+	//!
+	void take(Cell &cell, const size_t position, T &item)
+	{
+		item = std::move(cell.item);
+		// Releases what the item holds, instead of keeping it until the cell is written again.
+		cell.item = T();
+		cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+	}
+
+	//! Ring of cells.
+	const std::unique_ptr<Cell[]> m_cells;
+
+	//! Number of cells - 1, used to map positions to cells.
+	const size_t m_mask;
+
+	//! Next position to be claimed by a producer.
+	alignas(64) std::atomic<size_t> m_enqueuePosition = 0;
+
+	//! Next position to be claimed by a consumer.
+	alignas(64) std::atomic<size_t> m_dequeuePosition = 0;
+};
+
+} // namespace ptne::utility
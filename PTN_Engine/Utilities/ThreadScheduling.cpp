@@ -0,0 +1,95 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Utilities/ThreadScheduling.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <string>
+#include <system_error>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace ptne::utility
+{
+using namespace std;
+
+void checkThreadScheduling(const ThreadScheduling &scheduling)
+{
+#if defined(__linux__)
+	if (scheduling.cpu && *scheduling.cpu >= CPU_SETSIZE)
+	{
+		throw PTN_Exception("Invalid cpu: " + to_string(*scheduling.cpu) + ".");
+	}
+	if (scheduling.fifoPriority && (*scheduling.fifoPriority < sched_get_priority_min(SCHED_FIFO) ||
+									*scheduling.fifoPriority > sched_get_priority_max(SCHED_FIFO)))
+	{
+		throw PTN_Exception("Invalid SCHED_FIFO priority: " + to_string(*scheduling.fifoPriority) + ".");
+	}
+#else
+	if (scheduling.cpu || scheduling.fifoPriority)
+	{
+		throw PTN_Exception("Thread pinning and real time priorities are only supported on Linux.");
+	}
+#endif
+}
+
+void applyThreadScheduling(thread::native_handle_type thread, const ThreadScheduling &scheduling)
+{
+	checkThreadScheduling(scheduling);
+#if defined(__linux__)
+	if (scheduling.cpu)
+	{
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(*scheduling.cpu, &cpus);
+		if (const int error = pthread_setaffinity_np(thread, sizeof(cpus), &cpus); error != 0)
+		{
+			throw PTN_Exception("Could not pin thread to cpu " + to_string(*scheduling.cpu) + ": " +
+								system_category().message(error) + ".");
+		}
+	}
+	if (scheduling.fifoPriority)
+	{
+		const sched_param parameters{ .sched_priority = *scheduling.fifoPriority };
+		if (const int error = pthread_setschedparam(thread, SCHED_FIFO, &parameters); error != 0)
+		{
+			throw PTN_Exception("Could not set SCHED_FIFO priority " + to_string(*scheduling.fifoPriority) +
+								": " + system_category().message(error) + ".");
+		}
+	}
+#else
+	(void)thread;
+#endif
+}
+
+void cpuRelax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+	_mm_pause();
+#elif defined(__aarch64__)
+	asm volatile("yield");
+#endif
+}
+
+} // namespace ptne::utility
@@ -0,0 +1,46 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/PTN_Engine.h"
+#include <thread>
+
+namespace ptne::utility
+{
+
+//!
+//! \brief Throws if the scheduling is not supported on this platform or is out of range.
+//! \param scheduling - scheduling to check.
+//!
+void checkThreadScheduling(const ThreadScheduling &scheduling);
+
+//!
+//! \brief Pin a thread to a core and/or give it a real time priority.
+//! \throws PTN_Exception if the scheduling is invalid or the system refused to apply it.
+//! \param thread - native handle of the thread.
+//! \param scheduling - scheduling to apply.
+//!
+void applyThreadScheduling(std::thread::native_handle_type thread, const ThreadScheduling &scheduling);
+
+//!
+//! \brief Hint the processor that the calling thread is busy waiting.
+//!
+void cpuRelax() noexcept;
+
+} // namespace ptne::utility
@@ -0,0 +1,329 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "PTN_Engine/Utilities/Explicit.h"
+#include "PTN_Engine/Utilities/InPlaceFunction.h"
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <utility>
+
+namespace ptne
+{
+
+/*!
+ * \brief Resumes the suspended coroutine actions on the thread running them.
+ *
+ * Implemented by the executors that run coroutine actions. It must outlive the actions it runs.
+ */
+class DLL_PUBLIC IActionTaskScheduler
+{
+public:
+	virtual ~IActionTaskScheduler() = default;
+
+	/*!
+	 * \brief Resume a suspended coroutine as soon as possible. Can be called from any thread.
+	 * \param coroutine The coroutine to resume.
+	 */
+	virtual void resume(std::coroutine_handle<> coroutine) = 0;
+
+	/*!
+	 * \brief Resume a suspended coroutine once a time point is reached. Can be called from any thread.
+	 * \param timePoint When to resume the coroutine.
+	 * \param coroutine The coroutine to resume.
+	 */
+	virtual void resumeAt(std::chrono::steady_clock::time_point timePoint, std::coroutine_handle<> coroutine) = 0;
+};
+
+/*!
+ * \brief Called once a coroutine action completed, in the thread that resumed it last.
+ */
+using ActionTaskCompletion = utility::InPlaceFunction<void(), 32>;
+
+/*!
+ * \brief Return type of the coroutine actions, see PTN_Engine::registerAsyncAction.
+ *
+ * The coroutine does not run until it is started by an executor. From then on it owns itself: its frame is
+ * destroyed when it completes, and only then the action stops counting as in execution. Inside the action,
+ * co_await sleepFor, sleepUntil or awaitCallback to suspend it without blocking the thread running it.
+ * Exceptions escaping an action terminate the program, as with the other actions.
+ */
+class DLL_PUBLIC ActionTask final
+{
+public:
+	/*!
+	 * \brief Promise type of the coroutine actions.
+	 */
+	class promise_type final
+	{
+	public:
+		ActionTask get_return_object() noexcept
+		{
+			return ActionTask(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_always initial_suspend() const noexcept
+		{
+			return {};
+		}
+
+		auto final_suspend() const noexcept
+		{
+			struct FinalAwaiter
+			{
+				bool await_ready() const noexcept
+				{
+					return false;
+				}
+
+				void await_suspend(std::coroutine_handle<promise_type> coroutine) const noexcept
+				{
+					// The frame is no longer needed once suspended for the last time.
+					ActionTaskCompletion onCompleted = std::move(coroutine.promise().m_onCompleted);
+					coroutine.destroy();
+					if (onCompleted)
+					{
+						onCompleted();
+					}
+				}
+
+				void await_resume() const noexcept
+				{
+				}
+			};
+			return FinalAwaiter{};
+		}
+
+		void return_void() const noexcept
+		{
+		}
+
+		void unhandled_exception() const noexcept
+		{
+			std::terminate();
+		}
+
+		/*!
+		 * \brief Scheduler resuming the action.
+		 * \return The scheduler given when the action was started.
+		 */
+		IActionTaskScheduler &getScheduler() const noexcept
+		{
+			return *m_scheduler;
+		}
+
+	private:
+		friend class ActionTask;
+
+		//! Scheduler resuming the action.
+		IActionTaskScheduler *m_scheduler = nullptr;
+
+		//! Called once the action completed.
+		ActionTaskCompletion m_onCompleted;
+	};
+
+	~ActionTask()
+	{
+		if (m_coroutine)
+		{
+			m_coroutine.destroy();
+		}
+	}
+
+	ActionTask(const ActionTask &) = delete;
+	ActionTask &operator=(const ActionTask &) = delete;
+
+	ActionTask(ActionTask &&other) noexcept
+	: m_coroutine(std::exchange(other.m_coroutine, nullptr))
+	{
+	}
+
+	ActionTask &operator=(ActionTask &&other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_coroutine)
+			{
+				m_coroutine.destroy();
+			}
+			m_coroutine = std::exchange(other.m_coroutine, nullptr);
+		}
+		return *this;
+	}
+
+	/*!
+	 * \brief Run the action in the calling thread until it first suspends or completes, handing over its
+	 * ownership. Called by the executors, from the thread the scheduler resumes the coroutines in.
+	 * \param scheduler Resumes the action once suspended. Must outlive the action.
+	 * \param onCompleted Called once the action completed. May be empty.
+	 */
+	void start(IActionTaskScheduler &scheduler, ActionTaskCompletion onCompleted)
+	{
+		const auto coroutine = std::exchange(m_coroutine, nullptr);
+		if (!coroutine)
+		{
+			if (onCompleted)
+			{
+				onCompleted();
+			}
+			return;
+		}
+		coroutine.promise().m_scheduler = &scheduler;
+		coroutine.promise().m_onCompleted = std::move(onCompleted);
+		coroutine.resume();
+	}
+
+private:
+	explicit ActionTask(std::coroutine_handle<promise_type> coroutine) noexcept
+	: m_coroutine(coroutine)
+	{
+	}
+
+	//! The coroutine, until it is started.
+	std::coroutine_handle<promise_type> m_coroutine;
+};
+
+/*!
+ * \brief Function creating a coroutine action.
+ */
+using AsyncActionFunction = std::function<ActionTask(void)>;
+
+/*!
+ * \brief Awaitable suspending a coroutine action until a time point.
+ */
+class DLL_PUBLIC ActionTimer final
+{
+public:
+	explicit ActionTimer(const std::chrono::steady_clock::time_point timePoint) noexcept
+	: m_timePoint(timePoint)
+	{
+	}
+
+	bool await_ready() const noexcept
+	{
+		return false;
+	}
+
+	void await_suspend(std::coroutine_handle<ActionTask::promise_type> coroutine) const
+	{
+		coroutine.promise().getScheduler().resumeAt(m_timePoint, coroutine);
+	}
+
+	void await_resume() const noexcept
+	{
+	}
+
+private:
+	//! When to resume the action.
+	std::chrono::steady_clock::time_point m_timePoint;
+};
+
+/*!
+ * \brief Suspend a coroutine action until a time point, without blocking the thread running it.
+ * \param timePoint When to resume the action.
+ * \return Awaitable to co_await.
+ */
+inline ActionTimer sleepUntil(const std::chrono::steady_clock::time_point timePoint) noexcept
+{
+	return ActionTimer(timePoint);
+}
+
+/*!
+ * \brief Suspend a coroutine action for a duration, without blocking the thread running it.
+ * \param duration How long to suspend the action.
+ * \return Awaitable to co_await.
+ */
+template <typename Rep, typename Period>
+ActionTimer sleepFor(const std::chrono::duration<Rep, Period> duration) noexcept
+{
+	return ActionTimer(std::chrono::steady_clock::now() +
+					   std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration));
+}
+
+/*!
+ * \brief Resumes a coroutine action suspended by awaitCallback. Must be called exactly once, from any thread.
+ */
+class DLL_PUBLIC ActionResumer final
+{
+public:
+	ActionResumer(IActionTaskScheduler &scheduler, const std::coroutine_handle<> coroutine) noexcept
+	: m_scheduler(&scheduler)
+	, m_coroutine(coroutine)
+	{
+	}
+
+	void operator()() const
+	{
+		m_scheduler->resume(m_coroutine);
+	}
+
+private:
+	//! Scheduler resuming the action.
+	IActionTaskScheduler *m_scheduler;
+
+	//! The suspended action.
+	std::coroutine_handle<> m_coroutine;
+};
+
+/*!
+ * \brief Awaitable suspending a coroutine action until a callback resumes it.
+ */
+class DLL_PUBLIC ActionCallback final
+{
+public:
+	explicit ActionCallback(std::function<void(ActionResumer)> startOperation)
+	: m_startOperation(std::move(startOperation))
+	{
+	}
+
+	bool await_ready() const noexcept
+	{
+		return false;
+	}
+
+	void await_suspend(std::coroutine_handle<ActionTask::promise_type> coroutine)
+	{
+		// The action may be resumed before this returns, so the awaiter is not used after starting.
+		const auto startOperation = std::move(m_startOperation);
+		startOperation(ActionResumer(coroutine.promise().getScheduler(), coroutine));
+	}
+
+	void await_resume() const noexcept
+	{
+	}
+
+private:
+	//! Starts the asynchronous operation, which calls the resumer once done.
+	std::function<void(ActionResumer)> m_startOperation;
+};
+
+/*!
+ * \brief Suspend a coroutine action until an asynchronous operation, for instance I/O, completes.
+ * \param startOperation Starts the operation, passing it the resumer to call once done.
+ * \return Awaitable to co_await.
+ */
+inline ActionCallback awaitCallback(std::function<void(ActionResumer)> startOperation)
+{
+	return ActionCallback(std::move(startOperation));
+}
+
+} // namespace ptne
@@ -0,0 +1,87 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/Utilities/Explicit.h"
+#include <cstddef>
+#include <memory>
+
+namespace ptne
+{
+
+class EngineSchedulerImp;
+class EventLoop;
+
+/*!
+ * \brief Runs the nets of many engines on a fixed number of threads, instead of an event loop thread per
+ * engine.
+ *
+ * Engines using it, see PTN_Engine::setEngineScheduler, are registered by execute() and unregistered by
+ * stop(). Whenever a registered engine has new inputs, finished actions or changed conditions, or its
+ * watchdog timer period elapsed, one of the threads executes cycles of its net until no transition fires.
+ * Engines still firing after a number of cycles go back to the end of the queue, so that busy engines do not
+ * starve the others.
+ */
+class DLL_PUBLIC EngineScheduler final
+{
+public:
+	//! Default number of cycles executed for an engine before the next engine gets its turn.
+	static constexpr size_t defaultCycleBudget = 16;
+
+	~EngineScheduler();
+
+	/*!
+	 * \brief EngineScheduler constructor, launching the threads.
+	 * \param numberOfThreads Number of threads executing the nets. At least 1.
+	 * \param cycleBudget Number of cycles executed for an engine before the next engine gets its turn. At
+	 * least 1.
+	 */
+	explicit EngineScheduler(const size_t numberOfThreads, const size_t cycleBudget = defaultCycleBudget);
+
+	EngineScheduler(const EngineScheduler &) = delete;
+	EngineScheduler(EngineScheduler &&) = delete;
+	EngineScheduler &operator=(const EngineScheduler &) = delete;
+	EngineScheduler &operator=(EngineScheduler &&) = delete;
+
+	/*!
+	 * \brief Number of threads executing the nets.
+	 * \return The number of threads.
+	 */
+	size_t getNumberOfThreads() const;
+
+	/*!
+	 * \brief Number of cycles executed for an engine before the next engine gets its turn.
+	 * \return The cycle budget.
+	 */
+	size_t getCycleBudget() const;
+
+	/*!
+	 * \brief Number of engines registered, whose net is being executed.
+	 * \return The number of engines.
+	 */
+	size_t getNumberOfEngines() const;
+
+private:
+	friend class EventLoop;
+
+	//! Implementation, shared with the engines registered.
+	std::shared_ptr<EngineSchedulerImp> m_engineSchedulerImp;
+};
+
+} // namespace ptne
@@ -0,0 +1,145 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "PTN_Engine/ActionTask.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/Utilities/InPlaceFunction.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace ptne
+{
+
+/*!
+ * \brief Action handed over to an executor. Small enough to be wrapped by the executors in a job without
+ * allocating, so it only refers to the action function of its place.
+ */
+using ActionJob = utility::InPlaceFunction<void(), 16>;
+
+/*!
+ * \brief Wakes up the engine an action belongs to, once the action finished in another thread.
+ */
+using ActionCompletedNotifier = std::function<void()>;
+
+/*!
+ * \brief Runs the actions of the places of one or more engines.
+ *
+ * Engines create their own executor for the chosen actions thread option, unless one is given on
+ * construction. Implement it to run the actions on an existing runtime, or create one with
+ * createActionsExecutor to share it among several engines. executeAction is called concurrently by all
+ * engines using the executor.
+ */
+class DLL_PUBLIC IActionsExecutor
+{
+public:
+	virtual ~IActionsExecutor() = default;
+
+	/*!
+	 * \brief Execute an action, taking ownership of it.
+	 *
+	 * The counter is incremented before returning. Once the action ran, the counter is decremented, its
+	 * waiters are woken up with notify_all and then, if the action ran in another thread, the notifier is
+	 * called. Actions the executor discards instead are accounted for the same way. The action stays valid
+	 * until the counter is decremented and the counter as long as the notifier is held, so the notifier must
+	 * be copied to notify the counter and call the notifier after the decrement.
+	 * \param action The action to execute.
+	 * \param counter Number of actions in execution of the place the action belongs to.
+	 * \param notifier Wakes up the engine the action belongs to. May be null.
+	 */
+	virtual void executeAction(ActionJob action,
+							   std::atomic<size_t> &counter,
+							   const std::shared_ptr<const ActionCompletedNotifier> &notifier) = 0;
+
+	/*!
+	 * \brief Execute a coroutine action, see PTN_Engine::registerAsyncAction.
+	 *
+	 * Accounted for as executeAction, except that the action only stops counting as in execution once the
+	 * coroutine completed. By default the coroutine runs as an action of executeAction, which resumes it in
+	 * the same thread until it completed, so it holds that thread while suspended. The COROUTINE executor
+	 * instead keeps any number of suspended actions in flight on a single thread.
+	 * \param action Creates the coroutine. Stays valid until the counter is decremented.
+	 * \param counter Number of actions in execution of the place the action belongs to.
+	 * \param notifier Wakes up the engine the action belongs to. May be null.
+	 */
+	virtual void executeAsyncAction(const AsyncActionFunction &action,
+									std::atomic<size_t> &counter,
+									const std::shared_ptr<const ActionCompletedNotifier> &notifier);
+
+	/*!
+	 * \brief Set the core pinning and priority of the threads created to run actions. Executors without
+	 * dedicated threads ignore it.
+	 * \param threadScheduling Scheduling of the action threads.
+	 */
+	virtual void setThreadScheduling(const ThreadScheduling &threadScheduling)
+	{
+		(void)threadScheduling;
+	}
+
+	/*!
+	 * \brief Counters of the job queue dispatching the actions. Executors without job queue report none.
+	 * \return The metrics of the job queue.
+	 */
+	virtual JobQueueMetrics getJobQueueMetrics() const
+	{
+		return JobQueueMetrics();
+	}
+};
+
+/*!
+ * \brief Settings of the executors that only apply to some actions thread options.
+ */
+struct DLL_PUBLIC ActionsExecutorOptions final
+{
+	/*!
+	 * \brief Number of threads of the THREAD_POOL executor.
+	 */
+	size_t numberOfActionThreads = 1;
+
+	/*!
+	 * \brief Capacity of the job queue of the JOB_QUEUE and ADAPTIVE executors, 0 if unbounded.
+	 */
+	size_t jobQueueCapacity = 0;
+
+	/*!
+	 * \brief What happens to actions dispatched while the bounded job queue is full.
+	 */
+	PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY jobQueueOverflowPolicy = PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY::BLOCK;
+
+	/*!
+	 * \brief Average duration above which the ADAPTIVE executor runs an action in its job queue instead of
+	 * inline. The job queue is bounded as the one of the JOB_QUEUE executor.
+	 */
+	std::chrono::nanoseconds inlineActionThreshold = std::chrono::microseconds(10);
+};
+
+/*!
+ * \brief Create the executor of an actions thread option, for example a thread pool to be shared among
+ * several engines.
+ * \param actionsThreadOption Actions thread option of the executor. CUSTOM is not valid.
+ * \param options Settings of the executor.
+ * \return The executor.
+ */
+DLL_PUBLIC std::shared_ptr<IActionsExecutor>
+createActionsExecutor(const PTN_Engine::ACTIONS_THREAD_OPTION actionsThreadOption,
+					  const ActionsExecutorOptions &options = ActionsExecutorOptions());
+
+} // namespace ptne
@@ -18,12 +18,17 @@
 
 #pragma once
 
+#include "PTN_Engine/ActionTask.h"
 #include "PTN_Engine/Utilities/Explicit.h"
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ptne
@@ -31,6 +36,84 @@ namespace ptne
 using ConditionFunction = std::function<bool(void)>;
 using ActionFunction = std::function<void(void)>;
 
+//!
+//! \brief Action called once with the number of tokens that entered or left the place, instead of once per
+//! token or firing.
+//!
+using BatchActionFunction = std::function<void(size_t)>;
+
+//!
+//! \brief Identifies a place of a net without looking up its name.
+//! Returned when the place is created. Valid until the net is cleared.
+//!
+struct DLL_PUBLIC PlaceHandle final
+{
+	//!
+	//! \brief Position of the place in the order the places were created.
+	//!
+	size_t index = static_cast<size_t>(-1);
+
+	bool operator==(const PlaceHandle &) const = default;
+};
+
+//!
+//! \brief Identifies a transition of a net without looking up its name.
+//! Returned when the transition is created. Valid until the net is cleared.
+//!
+struct DLL_PUBLIC TransitionHandle final
+{
+	//!
+	//! \brief Position of the transition in the order the transitions were created.
+	//!
+	size_t index = static_cast<size_t>(-1);
+
+	bool operator==(const TransitionHandle &) const = default;
+};
+
+//!
+//! \brief Scheduling of a thread created by the engine. Only supported on Linux.
+//!
+struct DLL_PUBLIC ThreadScheduling final
+{
+	//!
+	//! \brief Index of the CPU core the thread is pinned to. Not pinned if empty.
+	//!
+	std::optional<size_t> cpu;
+
+	//!
+	//! \brief Real time priority of the thread, scheduled with SCHED_FIFO. Default scheduling if empty.
+	//! Usually requires the CAP_SYS_NICE capability.
+	//!
+	std::optional<int> fifoPriority;
+
+	bool operator==(const ThreadScheduling &) const = default;
+};
+
+//!
+//! \brief Counters of the jobs that went through the job queue running the actions. Rates are obtained by
+//! sampling the counters periodically.
+//!
+struct DLL_PUBLIC JobQueueMetrics final
+{
+	//! Number of jobs added to the queue.
+	size_t enqueuedJobs = 0;
+
+	//! Number of jobs taken from the queue to be executed.
+	size_t dequeuedJobs = 0;
+
+	//! Number of queued jobs dropped to make room for new ones, with the DROP_OLDEST overflow policy.
+	size_t droppedJobs = 0;
+
+	//! Number of jobs rejected because the queue was full, with the FAIL_FAST overflow policy.
+	size_t rejectedJobs = 0;
+
+	//! Number of jobs currently queued.
+	size_t depth = 0;
+
+	//! Highest number of jobs queued at the same time.
+	size_t highWaterMark = 0;
+};
+
 /*!
  * \brief The PlaceProperties class
  */
@@ -105,6 +188,12 @@ struct DLL_PUBLIC TransitionProperties final
 	//! \brief requireNoActionsInExecution
 	//!
 	bool requireNoActionsInExecution = false;
+
+	//!
+	//! \brief Priority of the transition over the transitions it competes with for tokens.
+	//! Used by the PRIORITY and WEIGHTED_RANDOM conflict resolution policies.
+	//!
+	size_t priority = 1;
 };
 
 /*!
@@ -146,8 +235,45 @@ struct DLL_PUBLIC PlaceProperties final
 	//! \brief A flag determining if this place can have tokens added manually.
 	//!
 	bool input = false;
+
+	//!
+	//! \brief Coroutine action started once a token enters the place, instead of onEnterAction.
+	//!
+	AsyncActionFunction onEnterAsyncAction = nullptr;
+
+	//!
+	//! \brief Coroutine action started once a token leaves the place, instead of onExitAction.
+	//!
+	AsyncActionFunction onExitAsyncAction = nullptr;
+
+	//!
+	//! \brief Name of the executor lane, registered with PTN_Engine::registerExecutorLane, running the actions of
+	//! the place. If empty, the actions run on the actions executor of the engine.
+	//!
+	std::string executorLane;
+
+	//!
+	//! \brief Coalesce the invocations of the actions of the place. While an invocation of an action is queued
+	//! and has not started yet, further invocations of the same action are folded into it instead of being
+	//! queued, so that the action runs once after the latest request. Meant for idempotent actions, such as
+	//! refreshing a view, fed by bursts of tokens. Coroutine and batch actions are not coalesced.
+	//!
+	bool coalesceActions = false;
+
+	//!
+	//! \brief Batch action called once tokens enter the place, with their number, instead of onEnterAction.
+	//!
+	BatchActionFunction onEnterBatchAction = nullptr;
+
+	//!
+	//! \brief Batch action called once tokens leave the place, with their number, instead of onExitAction.
+	//!
+	BatchActionFunction onExitBatchAction = nullptr;
 };
 
+class EngineScheduler;
+class IActionsExecutor;
+
 //! Base class that implements the Petri net logic.
 /*!
  * Base class that implements the Petri net logic.
@@ -162,11 +288,49 @@ public:
 		SINGLE_THREAD,
 		EVENT_LOOP,
 		DETACHED,
-		JOB_QUEUE
+		JOB_QUEUE,
+		THREAD_POOL,
+		//! Actions run by the executor given on construction.
+		CUSTOM,
+		//! Actions run by a single thread, where suspended coroutine actions do not hold the thread.
+		COROUTINE,
+		//! Cheap actions run inline in the thread firing the transitions, expensive ones in a job queue.
+		ADAPTIVE
+	};
+
+	//!
+	//! \brief How to decide which transition fires first, when enabled transitions compete for the tokens of a
+	//! place.
+	//!
+	enum class CONFLICT_RESOLUTION_POLICY
+	{
+		//! Uniformly random order.
+		RANDOM,
+		//! The transition fired first rotates each time the transitions are in conflict.
+		ROUND_ROBIN,
+		//! Highest priority first, ties in creation order.
+		PRIORITY,
+		//! Random order, the chance of firing first is proportional to the priority.
+		WEIGHTED_RANDOM
+	};
+
+	//!
+	//! \brief What happens to an action dispatched while the bounded job queue is full.
+	//!
+	enum class JOB_QUEUE_OVERFLOW_POLICY
+	{
+		//! The thread dispatching the action waits until the job queue has room for it.
+		BLOCK,
+		//! The action is not executed.
+		FAIL_FAST,
+		//! The oldest queued action is discarded to make room for the new one.
+		DROP_OLDEST
 	};
 
 	using EventLoopSleepDuration = std::chrono::duration<long, std::ratio<1, 1000>>;
 
+	using EventLoopSpinDuration = std::chrono::microseconds;
+
 	virtual ~PTN_Engine();
 
 	PTN_Engine(const PTN_Engine &) = delete;
@@ -177,14 +341,30 @@ public:
 	/*!
 	 * \brief createTransition
 	 * \param transitionProperties
+	 * \return Handle identifying the new transition.
 	 */
-	void createTransition(const TransitionProperties &transitionProperties);
+	TransitionHandle createTransition(const TransitionProperties &transitionProperties);
 
 	/*!
 	 * \brief createPlace
 	 * \param placeProperties
+	 * \return Handle identifying the new place.
 	 */
-	void createPlace(const PlaceProperties &placeProperties);
+	PlaceHandle createPlace(const PlaceProperties &placeProperties);
+
+	/*!
+	 * \brief Look up the handle of a place, so that the name is only looked up once.
+	 * \param place Name of the place.
+	 * \return Handle identifying the place.
+	 */
+	PlaceHandle getPlaceHandle(const std::string &place) const;
+
+	/*!
+	 * \brief Look up the handle of a transition, so that the name is only looked up once.
+	 * \param transition Name of the transition.
+	 * \return Handle identifying the transition.
+	 */
+	TransitionHandle getTransitionHandle(const std::string &transition) const;
 
 	/*!
 	 * Register an action to be called by the Petri net.
@@ -193,6 +373,28 @@ public:
 	 */
 	void registerAction(const std::string &name, const ActionFunction &action) const;
 
+	/*!
+	 * Register a batch action to be called by the Petri net, used by places as any other action.
+	 * Instead of being called once per firing or per token, the action is called once with the number of
+	 * tokens that entered or left the place: the weight of the arc times the number of firings, or the number
+	 * of tokens added to an input place. A weighted arc then hands a whole batch of items over to the action
+	 * at the cost of a single dispatch.
+	 * \param name The name of the action, unique among all actions.
+	 * \param action The function to be called with the number of tokens.
+	 */
+	void registerBatchAction(const std::string &name, const BatchActionFunction &action) const;
+
+	/*!
+	 * Register a coroutine action to be started by the Petri net, used by places as any other action.
+	 * The action counts as in execution until the coroutine completes, not when it first suspends. With
+	 * ACTIONS_THREAD_OPTION::COROUTINE, the suspended actions do not hold any thread, so that a single thread
+	 * keeps many actions waiting on timers or I/O in flight. With the other options, the coroutine holds the
+	 * thread running it until it completes.
+	 * \param name The name of the action, unique among all actions.
+	 * \param action The function creating the coroutine.
+	 */
+	void registerAsyncAction(const std::string &name, const AsyncActionFunction &action) const;
+
 	/*!
 	 * Register a condition
 	 * \param name The name of the condition
@@ -200,6 +402,19 @@ public:
 	 */
 	void registerCondition(const std::string &name, const ConditionFunction &condition) const;
 
+	/*!
+	 * Register an executor lane, on which places run their actions instead of the actions executor of the
+	 * engine. Each lane has its own executor, so a slow action only delays the actions of its lane. The lane
+	 * keeps the ordering of its executor: a JOB_QUEUE executor runs the actions of the lane one at a time in
+	 * dispatch order, a THREAD_POOL executor runs them concurrently, and an EVENT_LOOP executor runs them inline
+	 * in the thread firing the transitions. The executor may be shared among engines, and is kept when the
+	 * actions thread option changes.
+	 * \param name The name of the lane, referred to by PlaceProperties::executorLane.
+	 * \param executor Executor running the actions of the lane. Must not be null.
+	 * \sa createActionsExecutor
+	 */
+	void registerExecutorLane(const std::string &name, std::shared_ptr<IActionsExecutor> executor) const;
+
 	/*!
 	 * Start the petri net event loop.
 	 * \param returnWhenStopped run the net only until no transition is fireable.
@@ -215,12 +430,65 @@ public:
 	 */
 	size_t getNumberOfTokens(const std::string &place) const;
 
+	/*!
+	 * Return the number of tokens in a given place.
+	 * \param place Handle of the place to get the number of tokens from.
+	 * \return The number of tokens present in the place.
+	 */
+	size_t getNumberOfTokens(const PlaceHandle place) const;
+
+	/*!
+	 * Return how many invocations of the actions of a place were folded into an invocation still queued.
+	 * \param place The name of the place, which coalesces its actions.
+	 * \return The number of coalesced invocations.
+	 * \sa PlaceProperties::coalesceActions
+	 */
+	size_t getNumberOfCoalescedActions(const std::string &place) const;
+
 	/*!
 	 * Add a token to an input place.
 	 * \param place Name of the place to be incremented.
 	 */
 	void incrementInputPlace(const std::string &place);
 
+	/*!
+	 * Add a token to an input place.
+	 * \param place Handle of the place to be incremented.
+	 */
+	void incrementInputPlace(const PlaceHandle place);
+
+	/*!
+	 * Add tokens to an input place. The on enter action is called once per token, and the event loop is
+	 * notified once.
+	 * \param place Name of the place to be incremented.
+	 * \param count Number of tokens to add. Must be greater than 0.
+	 */
+	void incrementInputPlace(const std::string &place, const size_t count);
+
+	/*!
+	 * Add tokens to an input place. The on enter action is called once per token, and the event loop is
+	 * notified once.
+	 * \param place Handle of the place to be incremented.
+	 * \param count Number of tokens to add. Must be greater than 0.
+	 */
+	void incrementInputPlace(const PlaceHandle place, const size_t count);
+
+	/*!
+	 * Add tokens to several input places at once, with a single lock acquisition and a single notification
+	 * of the event loop. All increments are validated before any token is added, so if one of them is
+	 * invalid no place is changed. A place may appear more than once.
+	 * \param increments Pairs of place name and number of tokens to add.
+	 */
+	void incrementInputPlace(std::span<const std::pair<std::string, size_t>> increments);
+
+	/*!
+	 * Add tokens to several input places at once, with a single lock acquisition and a single notification
+	 * of the event loop. All increments are validated before any token is added, so if one of them is
+	 * invalid no place is changed. A place may appear more than once.
+	 * \param increments Pairs of place handle and number of tokens to add.
+	 */
+	void incrementInputPlace(std::span<const std::pair<PlaceHandle, size_t>> increments);
+
 	/*!
 	 * Print the petri net places and number of tokens.
 	 * \param o Output stream.
@@ -230,6 +498,32 @@ public:
 	//! Constructor
 	explicit PTN_Engine(ACTIONS_THREAD_OPTION actionsRuntimeThread = ACTIONS_THREAD_OPTION::JOB_QUEUE);
 
+	/*!
+	 * \brief Constructor selecting how conflicts between transitions are resolved.
+	 * \param actionsRuntimeThread Thread where the actions are run.
+	 * \param conflictResolutionPolicy Policy deciding the firing order of transitions competing for tokens.
+	 * \param seed Seed of the random policies, for reproducible runs. If not set, a random seed is used.
+	 */
+	PTN_Engine(ACTIONS_THREAD_OPTION actionsRuntimeThread,
+			   CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy,
+			   std::optional<uint64_t> seed = std::nullopt);
+
+	/*!
+	 * \brief Constructor running the actions on a given executor, which may be shared with other engines or
+	 * run them on an existing runtime. The actions thread option is CUSTOM. Destroying the engine waits for its
+	 * queued actions to finish.
+	 * \param actionsExecutor Executor running the actions. Must not be null.
+	 * \param conflictResolutionPolicy Policy deciding the firing order of transitions competing for tokens.
+	 * \param seed Seed of the random policies, for reproducible runs. If not set, a random seed is used.
+	 * \sa IActionsExecutor, createActionsExecutor
+	 */
+	explicit PTN_Engine(std::shared_ptr<IActionsExecutor> actionsExecutor,
+						CONFLICT_RESOLUTION_POLICY conflictResolutionPolicy = CONFLICT_RESOLUTION_POLICY::RANDOM,
+						std::optional<uint64_t> seed = std::nullopt);
+
+	//! Get the policy deciding the firing order of transitions competing for tokens.
+	CONFLICT_RESOLUTION_POLICY getConflictResolutionPolicy() const;
+
 	//! Specify the thread where the actions should be run.
 	void setActionsThreadOption(const ACTIONS_THREAD_OPTION actionsThreadOption);
 
@@ -259,18 +553,277 @@ public:
 	 */
 	EventLoopSleepDuration getEventLoopSleepDuration() const;
 
+	/*!
+	 * \brief Set the maximum time the event loop spins, waiting for an event, before parking its thread.
+	 * Spinning reacts to events within microseconds at the cost of CPU time. The time actually spent spinning
+	 * adapts between an eighth of this value and this value: it grows when spinning caught an event and shrinks
+	 * when the thread had to park anyway. Defaults to 0, parking immediately.
+	 * \param spinDuration Maximum spinning time, not negative.
+	 */
+	void setEventLoopSpinDuration(const EventLoopSpinDuration spinDuration);
+
+	/*!
+	 * \brief Get the maximum time the event loop spins before parking its thread.
+	 * \return The maximum spinning time.
+	 */
+	EventLoopSpinDuration getEventLoopSpinDuration() const;
+
+	/*!
+	 * \brief Enable or disable the watchdog of the event loop.
+	 * The parked event loop is woken up by new inputs, by actions finishing in other threads and by
+	 * notifyConditionsChanged. With the watchdog enabled it also wakes up once per sleep duration, which is
+	 * only needed if additional conditions change without calling notifyConditionsChanged. With the watchdog
+	 * disabled an idle engine uses no CPU. Enabled by default.
+	 * \param watchdogEnabled False to only wake up the event loop when notified.
+	 */
+	void setEventLoopWatchdogEnabled(const bool watchdogEnabled);
+
+	/*!
+	 * \brief Tells if the watchdog of the event loop is enabled.
+	 * \return True if the parked event loop also wakes up once per sleep duration.
+	 */
+	bool isEventLoopWatchdogEnabled() const;
+
+	/*!
+	 * \brief Enable or disable busy polling of the event loop.
+	 * A busy polling event loop never parks its thread: it spins until notified, reacting to new inputs and
+	 * finished actions with the lowest latency, at the cost of keeping one core fully busy. Pair it with
+	 * setEventLoopThreadScheduling to give the event loop a dedicated core. The watchdog still applies: if
+	 * enabled, the spinning event loop also executes the net once per sleep duration without being notified.
+	 * Disabled by default.
+	 * \param busyPolling True to busy poll.
+	 */
+	void setEventLoopBusyPolling(const bool busyPolling);
+
+	/*!
+	 * \brief Tells if the event loop busy polls.
+	 * \return True if the event loop never parks its thread.
+	 */
+	bool isEventLoopBusyPolling() const;
+
+	/*!
+	 * \brief Let a shared EngineScheduler drive this engine instead of a dedicated event loop thread.
+	 * The scheduler's threads run the execution cycles of all engines registered to it in round-robin,
+	 * allowing many engines to run on a fixed number of threads. The event loop sleep, spin, busy polling and
+	 * thread scheduling settings do not apply to a scheduled engine; the watchdog still does. Ignored with
+	 * ACTIONS_THREAD_OPTION::SINGLE_THREAD.
+	 * \param engineScheduler Scheduler driving the engine, or nullptr to use a dedicated event loop thread.
+	 * \throws PTN_Exception if the event loop is running.
+	 */
+	void setEngineScheduler(std::shared_ptr<EngineScheduler> engineScheduler);
+
+	/*!
+	 * \brief Get the scheduler driving this engine.
+	 * \return The engine scheduler, or nullptr if the engine uses a dedicated event loop thread.
+	 */
+	std::shared_ptr<EngineScheduler> getEngineScheduler() const;
+
+	/*!
+	 * \brief Pin the event loop thread to a core and/or run it with a SCHED_FIFO real time priority.
+	 * Applied whenever the event loop thread starts; execute throws if the system refuses it, for instance
+	 * because the process lacks the privileges for real time priorities. Only supported on Linux.
+	 * \param threadScheduling Scheduling of the event loop thread.
+	 * \throws PTN_Exception if the event loop is running or the scheduling is invalid.
+	 */
+	void setEventLoopThreadScheduling(const ThreadScheduling &threadScheduling);
+
+	/*!
+	 * \brief Get the scheduling of the event loop thread.
+	 * \return The core pinning and priority of the event loop thread.
+	 */
+	ThreadScheduling getEventLoopThreadScheduling() const;
+
+	/*!
+	 * \brief Pin the job queue worker threads to a core and/or run them with a SCHED_FIFO real time priority.
+	 * Used by the worker of ACTIONS_THREAD_OPTION::JOB_QUEUE and the threads of THREAD_POOL. Applied on a
+	 * best effort basis: the actions still run if the system refuses it. Only supported on Linux.
+	 * \param threadScheduling Scheduling of the job queue worker threads.
+	 * \throws PTN_Exception if the scheduling is invalid.
+	 */
+	void setJobQueueThreadScheduling(const ThreadScheduling &threadScheduling);
+
+	/*!
+	 * \brief Get the scheduling of the job queue worker threads.
+	 * \return The core pinning and priority of the job queue worker threads.
+	 */
+	ThreadScheduling getJobQueueThreadScheduling() const;
+
+	/*!
+	 * \brief Tell the engine that the results of additional conditions may have changed, so that the
+	 * transitions depending on them are checked again. Can be called from any thread, including actions.
+	 */
+	void notifyConditionsChanged();
+
+	/*!
+	 * \brief Enable or disable maximal step firing.
+	 * When enabled, each cycle fires a maximal set of the enabled transitions as one step: all of them consume
+	 * their tokens before any tokens are produced, so tokens produced in a step are only available in the next
+	 * one. Transitions competing for the same tokens are arbitrated by the conflict resolution policy.
+	 * Disabled by default.
+	 * \param maximalStepFiring True to fire the enabled transitions as one step.
+	 */
+	void setMaximalStepFiring(const bool maximalStepFiring);
+
+	/*!
+	 * \brief Whether the enabled transitions are fired as one step.
+	 * \return True if maximal step firing is enabled.
+	 */
+	bool isMaximalStepFiring() const;
+
+	/*!
+	 * \brief Enable or disable firing transitions by their enabling degree.
+	 * When enabled, a transition fires in one step as many times as the tokens in its activation places allow,
+	 * instead of once per cycle. The actions of the places are called once per firing and the additional
+	 * conditions are evaluated once per step. Disabled by default.
+	 * \param multiFiring True to fire transitions by their enabling degree.
+	 */
+	void setMultiFiring(const bool multiFiring);
+
+	/*!
+	 * \brief Whether transitions are fired by their enabling degree.
+	 * \return True if multi-firing is enabled.
+	 */
+	bool isMultiFiring() const;
+
+	/*!
+	 * \brief Set the number of threads firing the net while it is frozen.
+	 * With more than one thread, the transitions are partitioned into regions that share no activation places
+	 * (the connected components of the conflict graph), and the regions with enabled transitions are fired in
+	 * parallel on a work stealing pool. Tokens deposited in the places of other regions are added atomically.
+	 * The actions of the places are dispatched once all regions were fired, in the thread running the net. The
+	 * additional conditions are evaluated in the firing threads: they may read the number of tokens, but must
+	 * not change the net. Nets that are not frozen are always fired sequentially. Defaults to 1.
+	 * \param numberOfFiringThreads Number of threads, including the one running the net. At least 1.
+	 */
+	void setNumberOfFiringThreads(const size_t numberOfFiringThreads);
+
+	/*!
+	 * \brief Get the number of threads firing the net while it is frozen.
+	 * \return The number of threads, 1 if the net is fired sequentially.
+	 */
+	size_t getNumberOfFiringThreads() const;
+
+	/*!
+	 * \brief Set the number of threads running the actions with ACTIONS_THREAD_OPTION::THREAD_POOL.
+	 * The threads are created with the pool and kept for its lifetime, so changing the number of threads
+	 * replaces the pool. Defaults to the number of hardware threads.
+	 * \param numberOfActionThreads Number of threads, at least 1.
+	 * \throws PTN_Exception if the event loop is running.
+	 */
+	void setNumberOfActionThreads(const size_t numberOfActionThreads);
+
+	/*!
+	 * \brief Get the number of threads running the actions with ACTIONS_THREAD_OPTION::THREAD_POOL.
+	 * \return The number of threads.
+	 */
+	size_t getNumberOfActionThreads() const;
+
+	/*!
+	 * \brief Set the threshold of ACTIONS_THREAD_OPTION::ADAPTIVE. The duration of each action is measured and
+	 * averaged per place. Actions whose average exceeds the threshold run in the job queue, so that they do
+	 * not block the event loop. Actions whose average falls below half the threshold run inline, in the
+	 * thread firing the transitions, without the cost of dispatching them to another thread. Actions start in
+	 * the job queue until they are known to be cheap. The job queue is bounded as set by setJobQueueCapacity.
+	 * Defaults to 10 microseconds.
+	 * \param inlineActionThreshold Average duration above which the actions run in the job queue.
+	 * \throws PTN_Exception if the event loop is running.
+	 */
+	void setInlineActionThreshold(const std::chrono::nanoseconds inlineActionThreshold);
+
+	/*!
+	 * \brief Get the threshold of ACTIONS_THREAD_OPTION::ADAPTIVE.
+	 * \return Average duration above which the actions run in the job queue.
+	 */
+	std::chrono::nanoseconds getInlineActionThreshold() const;
+
+	/*!
+	 * \brief Queue the tokens added to single input places, instead of adding them directly.
+	 * With a capacity greater than 0, incrementInputPlace with one place and a count pushes the increment into
+	 * a bounded lock-free queue, which the thread executing the net drains at the start of each cycle. Producers
+	 * then never wait for the engine, even while transitions are being fired or actions executed, and the event
+	 * loop is only notified if it is waiting. The place and count are validated when queued, but the tokens are
+	 * only counted in getNumberOfTokens once drained. If the queue is full InputQueueFullException is thrown.
+	 * Batches of increments are still added directly. Queued increments are discarded by clearNet, including those
+	 * racing with it, while those queued before a change of capacity are added. Cannot be called while the event
+	 * loop is running. Defaults to 0.
+	 * \param capacity Maximum number of pending increments, rounded up to a power of 2 of at least 2.
+	 * 0 disables the queue.
+	 */
+	void setInputQueueCapacity(const size_t capacity);
+
+	/*!
+	 * \brief Get the capacity of the input queue.
+	 * \return The maximum number of pending increments, 0 if the queue is disabled.
+	 */
+	size_t getInputQueueCapacity() const;
+
+	/*!
+	 * \brief Bound the job queue dispatching the actions with ACTIONS_THREAD_OPTION::JOB_QUEUE or ADAPTIVE.
+	 * By default the job queue is unbounded, so actions slower than the net let it grow without limit. With a
+	 * capacity greater than 0 the actions are queued in a bounded lock-free ring and the overflow policy decides
+	 * what happens to actions dispatched while it is full. With BLOCK the thread executing the net waits for
+	 * room, so actions must not wait for the net to fire. Actions that are dropped or rejected are not executed
+	 * and do not count as in execution. Changing the capacity replaces the job queue and resets its metrics.
+	 * \param capacity Maximum number of queued actions, rounded up to a power of 2 of at least 2. 0 for an
+	 * unbounded queue.
+	 * \param overflowPolicy What to do with actions dispatched while the job queue is full.
+	 * \throws PTN_Exception if the event loop is running.
+	 */
+	void setJobQueueCapacity(const size_t capacity,
+							 const JOB_QUEUE_OVERFLOW_POLICY overflowPolicy = JOB_QUEUE_OVERFLOW_POLICY::BLOCK);
+
+	/*!
+	 * \brief Get the capacity of the job queue.
+	 * \return The maximum number of queued actions, 0 if the job queue is unbounded.
+	 */
+	size_t getJobQueueCapacity() const;
+
+	/*!
+	 * \brief Get what happens to actions dispatched while the bounded job queue is full.
+	 * \return The overflow policy.
+	 */
+	JOB_QUEUE_OVERFLOW_POLICY getJobQueueOverflowPolicy() const;
+
+	/*!
+	 * \brief Get the counters of the job queue dispatching the actions, to size its capacity.
+	 * \return The metrics of the job queue, all 0 unless ACTIONS_THREAD_OPTION::JOB_QUEUE is used.
+	 */
+	JobQueueMetrics getJobQueueMetrics() const;
+
 	/*!
 	 * \brief addArc
 	 * \param arcProperties
 	 */
 	void addArc(const ArcProperties &arcProperties);
 
+	/*!
+	 * \brief Add an arc between a place and a transition.
+	 * \param place Handle of the place.
+	 * \param transition Handle of the transition.
+	 * \param type The type of arc.
+	 * \param weight The weight of the arc.
+	 */
+	void addArc(const PlaceHandle place,
+				const TransitionHandle transition,
+				const ArcProperties::Type type = ArcProperties::Type::ACTIVATION,
+				const size_t weight = 1);
+
 	/*!
 	 * \brief addArc
 	 * \param arcProperties
 	 */
 	void removeArc(const ArcProperties &arcProperties);
 
+	/*!
+	 * \brief Remove an arc between a place and a transition.
+	 * \param place Handle of the place.
+	 * \param transition Handle of the transition.
+	 * \param type The type of arc.
+	 */
+	void removeArc(const PlaceHandle place,
+				   const TransitionHandle transition,
+				   const ArcProperties::Type type = ArcProperties::Type::ACTIVATION);
+
 	/*!
 	 * \brief clearNet
 	 */
@@ -288,6 +841,27 @@ public:
 	 */
 	std::vector<TransitionProperties> getTransitionsProperties() const;
 
+	/*!
+	 * \brief Compile the current structure of the net into flat arrays used for firing.
+	 * While frozen, places, transitions and arcs cannot be created, removed or changed. Tokens
+	 * are kept in the frozen net until thaw is called.
+	 * Cannot be called while the event loop is running.
+	 */
+	void freeze();
+
+	/*!
+	 * \brief Discard the frozen representation of the net, storing the current tokens back in the
+	 * places. The structure of the net can be changed again afterwards.
+	 * Cannot be called while the event loop is running.
+	 */
+	void thaw();
+
+	/*!
+	 * \brief Whether the net is frozen or not.
+	 * \return True if freeze was called and thaw was not called after it.
+	 */
+	bool isFrozen() const;
+
 private:
 	class PTN_EngineImpProxy;
 
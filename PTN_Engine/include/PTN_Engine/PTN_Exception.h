@@ -53,6 +53,18 @@ public:
 	}
 };
 
+/*!
+ * Exception to be thrown when using a handle that does not identify a place or transition of the net.
+ */
+class DLL_PUBLIC InvalidHandleException : public PTN_Exception
+{
+public:
+	explicit InvalidHandleException(const size_t index)
+	: PTN_Exception("Invalid handle: " + std::to_string(index) + ".")
+	{
+	}
+};
+
 /*!
  * Exception to be thrown if names of places to construct a transition are repeated.
  */
@@ -191,5 +203,17 @@ public:
 	}
 };
 
+/*!
+ * Exception to be thrown when an input cannot be queued because the input queue is full.
+ */
+class DLL_PUBLIC InputQueueFullException : public PTN_Exception
+{
+public:
+	InputQueueFullException()
+	: PTN_Exception("The input queue is full.")
+	{
+	}
+};
+
 
 } // namespace ptne
@@ -0,0 +1,237 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ptne::utility
+{
+
+template <typename Signature, size_t Capacity>
+class InPlaceFunction;
+
+//!
+//! \brief Move-only function wrapper storing callables of up to Capacity bytes inside itself.
+//!
+//! Unlike std::function, it does not need the callable to be copyable and does not allocate for callables
+//! that fit in place, so that moving jobs through queues and executors costs no allocations. Larger
+//! callables, ones aligned beyond a pointer or ones that may throw when moved are stored on the heap instead.
+//!
+template <typename Result, typename... Arguments, size_t Capacity>
+class InPlaceFunction<Result(Arguments...), Capacity> final
+{
+public:
+	~InPlaceFunction()
+	{
+		reset();
+	}
+
+	InPlaceFunction() noexcept = default;
+
+	InPlaceFunction(std::nullptr_t) noexcept
+	{
+	}
+
+	//!
+	//! \brief InPlaceFunction constructor.
+	//! \param function - callable to store. Empty std::function objects and null pointers leave it empty.
+	//!
+	template <typename Function>
+	requires(!std::is_same_v<std::remove_cvref_t<Function>, InPlaceFunction> &&
+			 std::is_invocable_r_v<Result, std::decay_t<Function> &, Arguments...>)
+	InPlaceFunction(Function &&function)
+	{
+		using Stored = std::decay_t<Function>;
+		if constexpr (std::is_pointer_v<Stored> || std::is_member_pointer_v<Stored> ||
+					  std::is_same_v<Stored, std::function<Result(Arguments...)>>)
+		{
+			if (!function)
+			{
+				return;
+			}
+		}
+		if constexpr (isStoredInPlace<Stored>())
+		{
+			::new (static_cast<void *>(m_storage)) Stored(std::forward<Function>(function));
+		}
+		else
+		{
+			::new (static_cast<void *>(m_storage)) Stored *(new Stored(std::forward<Function>(function)));
+		}
+		m_operations = &s_operations<Stored>;
+	}
+
+	InPlaceFunction(InPlaceFunction &&other) noexcept
+	{
+		takeFrom(other);
+	}
+
+	InPlaceFunction &operator=(InPlaceFunction &&other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			takeFrom(other);
+		}
+		return *this;
+	}
+
+	InPlaceFunction &operator=(std::nullptr_t) noexcept
+	{
+		reset();
+		return *this;
+	}
+
+	InPlaceFunction(const InPlaceFunction &) = delete;
+	InPlaceFunction &operator=(const InPlaceFunction &) = delete;
+
+	//!
+	//! \brief Call the stored callable. Must not be empty.
+	//!
+	Result operator()(Arguments... arguments)
+	{
+		return m_operations->invoke(m_storage, std::forward<Arguments>(arguments)...);
+	}
+
+	//!
+	//! \brief Tells if a callable is stored.
+	//! \return True if not empty.
+	//!
+	explicit operator bool() const noexcept
+	{
+		return m_operations != nullptr;
+	}
+
+	//!
+	//! \brief Tells if a callable of a given type is stored without allocating.
+	//! \return True if stored in place.
+	//!
+	template <typename Stored>
+	static constexpr bool isStoredInPlace()
+	{
+		return sizeof(Stored) <= Capacity && alignof(Stored) <= alignof(void *) &&
+			   std::is_nothrow_move_constructible_v<Stored>;
+	}
+
+private:
+	//!
+	//! \brief Operations on the stored callable, one instance per type of callable.
+	//!
+	struct Operations
+	{
+		//! Calls the callable.
+		Result (*invoke)(std::byte *storage, Arguments &&...arguments);
+
+		//! Moves the callable to another storage and destroys the moved from callable.
+		void (*relocate)(std::byte *from, std::byte *to) noexcept;
+
+		//! Destroys the callable.
+		void (*destroy)(std::byte *storage) noexcept;
+	};
+
+	template <typename Stored>
+	static Stored &get(std::byte *storage) noexcept
+	{
+		if constexpr (isStoredInPlace<Stored>())
+		{
+			return *std::launder(reinterpret_cast<Stored *>(storage));
+		}
+		else
+		{
+			return **std::launder(reinterpret_cast<Stored **>(storage));
+		}
+	}
+
+	template <typename Stored>
+	static constexpr Operations s_operations{
+		.invoke = [](std::byte *storage, Arguments &&...arguments) -> Result
+		{
+			if constexpr (std::is_void_v<Result>)
+			{
+				std::invoke(get<Stored>(storage), std::forward<Arguments>(arguments)...);
+			}
+			else
+			{
+				return std::invoke(get<Stored>(storage), std::forward<Arguments>(arguments)...);
+			}
+		},
+		.relocate =
+		[](std::byte *from, std::byte *to) noexcept
+		{
+			if constexpr (isStoredInPlace<Stored>())
+			{
+				Stored &stored = get<Stored>(from);
+				::new (static_cast<void *>(to)) Stored(std::move(stored));
+				stored.~Stored();
+			}
+			else
+			{
+				::new (static_cast<void *>(to)) Stored *(&get<Stored>(from));
+			}
+		},
+		.destroy =
+		[](std::byte *storage) noexcept
+		{
+			if constexpr (isStoredInPlace<Stored>())
+			{
+				get<Stored>(storage).~Stored();
+			}
+			else
+			{
+				delete &get<Stored>(storage);
+			}
+		}
+	};
+
+	//!
+	//! \brief Take the callable of another function, leaving it empty.
+	//! \param other - function to take the callable from.
+	//!
+	void takeFrom(InPlaceFunction &other) noexcept
+	{
+		if (other.m_operations != nullptr)
+		{
+			other.m_operations->relocate(other.m_storage, m_storage);
+			m_operations = std::exchange(other.m_operations, nullptr);
+		}
+	}
+
+	//!
+	//! \brief Destroy the stored callable, if any.
+	//!
+	void reset() noexcept
+	{
+		if (m_operations != nullptr)
+		{
+			std::exchange(m_operations, nullptr)->destroy(m_storage);
+		}
+	}
+
+	//! Storage of the callable, or of a pointer to it if it does not fit.
+	alignas(void *) std::byte m_storage[Capacity < sizeof(void *) ? sizeof(void *) : Capacity];
+
+	//! Operations on the stored callable, null if empty.
+	const Operations *m_operations = nullptr;
+};
+
+} // namespace ptne::utility
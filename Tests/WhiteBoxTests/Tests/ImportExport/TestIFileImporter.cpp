@@ -0,0 +1,112 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/IActionsExecutor.h"
+#include "PTN_Engine/ImportExport/IFileExporter.h"
+#include "PTN_Engine/ImportExport/IFileImporter.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include <gtest/gtest.h>
+
+using namespace ptne;
+using namespace std;
+
+namespace
+{
+
+//!
+//! \brief Keeps an exported net in memory, to import it again.
+//!
+class MemoryFile final : public IFileExporter, public IFileImporter
+{
+public:
+	void _export(const PTN_Engine &ptnEngine, const string &) override
+	{
+		_exportInt(ptnEngine);
+	}
+
+	void _import(const string &, PTN_Engine &ptnEngine) override
+	{
+		_importInt(ptnEngine);
+	}
+
+private:
+	void exportActionsThreadOption(const string &actionsThreadOption) override
+	{
+		m_actionsThreadOption = actionsThreadOption;
+	}
+
+	void exportPlace(const PlaceProperties &placeProperties) override
+	{
+		m_places.push_back(placeProperties);
+	}
+
+	void exportTransition(const TransitionProperties &transitionProperties) override
+	{
+		m_transitions.push_back(transitionProperties);
+	}
+
+	string importActionsThreadOption() const override
+	{
+		return m_actionsThreadOption;
+	}
+
+	vector<PlaceProperties> importPlaces() const override
+	{
+		return m_places;
+	}
+
+	vector<TransitionProperties> importTransitions() const override
+	{
+		return m_transitions;
+	}
+
+	vector<ArcProperties> importArcs() const override
+	{
+		// The arcs are part of the transitions.
+		return {};
+	}
+
+	string m_actionsThreadOption;
+	vector<PlaceProperties> m_places;
+	vector<TransitionProperties> m_transitions;
+};
+
+} // namespace
+
+TEST(IFileImporter, custom_nets_round_trip_keeping_the_executor_of_the_target)
+{
+	using enum PTN_Engine::ACTIONS_THREAD_OPTION;
+	PTN_Engine source(createActionsExecutor(JOB_QUEUE));
+	source.createPlace({ .name = "P1", .initialNumberOfTokens = 1 });
+	source.createPlace({ .name = "P2" });
+	source.createTransition({ .name = "T1", .activationArcs = { { .placeName = "P1" } },
+							  .destinationArcs = { { .placeName = "P2" } } });
+
+	MemoryFile file;
+	file._export(source, "");
+
+	PTN_Engine target(EVENT_LOOP);
+	EXPECT_NO_THROW(file._import("", target));
+	EXPECT_EQ(EVENT_LOOP, target.getActionsThreadOption());
+	EXPECT_EQ(1, target.getNumberOfTokens("P1"));
+
+	PTN_Engine customTarget(createActionsExecutor(THREAD_POOL));
+	EXPECT_NO_THROW(file._import("", customTarget));
+	EXPECT_EQ(CUSTOM, customTarget.getActionsThreadOption());
+	EXPECT_EQ(1, customTarget.getTransitionsProperties().size());
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/ActionsInExecution.h"
+#include "PTN_Engine/Executor/ActionsExecutorFactory.h"
+#include "PTN_Engine/Place.h"
+#include <gtest/gtest.h>
+
+using namespace ptne;
+using namespace std;
+
+class ActionsInExecution_Obj : public testing::Test
+{
+public:
+	size_t wakeUps = 0;
+	shared_ptr<IActionsExecutor> executor = ActionsExecutorFactory::createExecutor();
+	Place p1 = Place(PlaceProperties{ .name = "P1" }, executor);
+	Place p2 = Place(PlaceProperties{ .name = "P2" }, executor);
+	shared_ptr<ActionsInExecution> actionsInExecution = make_shared<ActionsInExecution>([this] { ++wakeUps; });
+};
+
+TEST_F(ActionsInExecution_Obj, notifier_queues_the_place_once_until_taken_and_always_wakes_up)
+{
+	auto placeActions1 = make_shared<ActionsInExecution::PlaceActions>(&p1);
+	auto placeActions2 = make_shared<ActionsInExecution::PlaceActions>(&p2);
+	auto notifier1 = actionsInExecution->createNotifier(placeActions1);
+	auto notifier2 = actionsInExecution->createNotifier(placeActions2);
+	EXPECT_TRUE(actionsInExecution->takeCompletedPlaces().empty());
+
+	(*notifier1)();
+	(*notifier1)();
+	(*notifier2)();
+	EXPECT_EQ(3, wakeUps);
+
+	auto completedPlaces = actionsInExecution->takeCompletedPlaces();
+	ASSERT_EQ(2, completedPlaces.size());
+	EXPECT_EQ(placeActions1->place, completedPlaces.at(0));
+	EXPECT_EQ(placeActions2->place, completedPlaces.at(1));
+	EXPECT_TRUE(actionsInExecution->takeCompletedPlaces().empty());
+
+	// Taking the places allows them to be queued again.
+	(*notifier1)();
+	completedPlaces = actionsInExecution->takeCompletedPlaces();
+	ASSERT_EQ(1, completedPlaces.size());
+	EXPECT_EQ(placeActions1->place, completedPlaces.at(0));
+}
+
+TEST_F(ActionsInExecution_Obj, clear_discards_the_queued_places)
+{
+	auto placeActions = make_shared<ActionsInExecution::PlaceActions>(&p1);
+	auto notifier = actionsInExecution->createNotifier(placeActions);
+	(*notifier)();
+	actionsInExecution->clear();
+	EXPECT_TRUE(actionsInExecution->takeCompletedPlaces().empty());
+
+	(*notifier)();
+	EXPECT_EQ(1, actionsInExecution->takeCompletedPlaces().size());
+}
+
+TEST_F(ActionsInExecution_Obj, notifier_outlives_the_place_counters_owner)
+{
+	auto placeActions = make_shared<ActionsInExecution::PlaceActions>(&p1);
+	auto notifier = actionsInExecution->createNotifier(placeActions);
+	placeActions.reset();
+	actionsInExecution.reset();
+
+	// Executors may still hold the notifier of an action when the net is cleared.
+	EXPECT_NO_THROW((*notifier)());
+	EXPECT_EQ(1, wakeUps);
+}
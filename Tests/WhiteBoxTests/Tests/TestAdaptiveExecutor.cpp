@@ -0,0 +1,146 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/Executor/AdaptiveExecutor.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace ptne;
+using namespace std;
+
+namespace
+{
+
+//!
+//! \brief Execute an action and wait until it finished.
+//! \return If the action ran in the calling thread.
+//!
+bool executeAndWait(AdaptiveExecutor &executor,
+					atomic<size_t> &counter,
+					const function<void()> &action,
+					const shared_ptr<const ActionCompletedNotifier> &notifier = nullptr)
+{
+	thread::id actionThread;
+	const function<void()> f = [&]
+	{
+		action();
+		actionThread = this_thread::get_id();
+	};
+	executor.executeAction([&f] { f(); }, counter, notifier);
+	while (counter > 0)
+	{
+		this_thread::yield();
+	}
+	return actionThread == this_thread::get_id();
+}
+
+} // namespace
+
+TEST(AdaptiveExecutor_, actions_start_offloaded_and_run_inline_once_known_to_be_cheap)
+{
+	AdaptiveExecutor executor(1ms);
+	atomic<size_t> counter = 0;
+	EXPECT_TRUE(executor.isOffloaded(counter));
+	EXPECT_FALSE(executeAndWait(executor, counter, [] {}));
+
+	size_t offloaded = 1;
+	while (executeAndWait(executor, counter, [] {}) == false)
+	{
+		++offloaded;
+		ASSERT_LT(offloaded, 20);
+	}
+	EXPECT_FALSE(executor.isOffloaded(counter));
+	EXPECT_TRUE(executeAndWait(executor, counter, [] {}));
+	EXPECT_EQ(offloaded, executor.getJobQueueMetrics().dequeuedJobs);
+}
+
+TEST(AdaptiveExecutor_, expensive_actions_are_offloaded_after_running_inline_once)
+{
+	AdaptiveExecutor executor(1ms);
+	atomic<size_t> counter = 0;
+	atomic<size_t> otherCounter = 0;
+	while (!executeAndWait(executor, counter, [] {}))
+	{
+	}
+
+	EXPECT_TRUE(executeAndWait(executor, counter, [] { this_thread::sleep_for(20ms); }));
+	EXPECT_TRUE(executor.isOffloaded(counter));
+	EXPECT_FALSE(executeAndWait(executor, counter, [] {}));
+
+	// The actions of each counter are classified separately.
+	EXPECT_TRUE(executor.isOffloaded(otherCounter));
+	EXPECT_FALSE(executeAndWait(executor, otherCounter, [] {}));
+}
+
+TEST(AdaptiveExecutor_, actions_between_half_the_threshold_and_the_threshold_keep_their_classification)
+{
+	AdaptiveExecutor executor(10ms);
+	atomic<size_t> inlineCounter = 0;
+	atomic<size_t> offloadedCounter = 0;
+	while (!executeAndWait(executor, inlineCounter, [] {}))
+	{
+	}
+
+	for (size_t i = 0; i < 10; ++i)
+	{
+		EXPECT_TRUE(executeAndWait(executor, inlineCounter, [] { this_thread::sleep_for(6ms); }));
+		EXPECT_FALSE(executeAndWait(executor, offloadedCounter, [] { this_thread::sleep_for(6ms); }));
+	}
+}
+
+TEST(AdaptiveExecutor_, actions_dropped_by_the_bounded_job_queue_no_longer_count_as_in_execution)
+{
+	AdaptiveExecutor executor(1ms, 1, PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY::FAIL_FAST);
+	atomic<bool> finishAction = false;
+	atomic<size_t> counter = 0;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		executor.executeAction([&finishAction] { finishAction.wait(false); }, counter, nullptr);
+	}
+	EXPECT_GT(executor.getJobQueueMetrics().rejectedJobs, 0);
+	finishAction = true;
+	finishAction.notify_all();
+	while (counter > 0)
+	{
+		this_thread::yield();
+	}
+}
+
+TEST(AdaptiveExecutor_, statistics_expire_with_the_notifier_of_their_place)
+{
+	AdaptiveExecutor executor(1ms);
+	atomic<size_t> counter = 0;
+	auto notifier = make_shared<const ActionCompletedNotifier>();
+	while (!executeAndWait(executor, counter, [] {}, notifier))
+	{
+	}
+	EXPECT_FALSE(executor.isOffloaded(counter));
+
+	// A new place reusing the counter does not inherit the classification.
+	notifier = make_shared<const ActionCompletedNotifier>();
+	EXPECT_FALSE(executeAndWait(executor, counter, [] {}, notifier));
+
+	// Places created and destroyed over time do not grow the statistics.
+	vector<atomic<size_t>> counters(1000);
+	for (auto &placeCounter : counters)
+	{
+		executeAndWait(executor, placeCounter, [] {}, make_shared<const ActionCompletedNotifier>());
+	}
+	EXPECT_LT(executor.getNumberOfStatistics(), 130);
+}
@@ -0,0 +1,153 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/ConflictResolution/ConflictGroups.h"
+#include "PTN_Engine/ConflictResolution/ConflictResolverFactory.h"
+#include "PTN_Engine/ConflictResolution/PriorityConflictResolver.h"
+#include "PTN_Engine/ConflictResolution/RandomConflictResolver.h"
+#include "PTN_Engine/ConflictResolution/RoundRobinConflictResolver.h"
+#include "PTN_Engine/ConflictResolution/WeightedRandomConflictResolver.h"
+#include "PTN_Engine/Executor/ActionsExecutorFactory.h"
+#include "PTN_Engine/Place.h"
+#include "PTN_Engine/Transition.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace ptne;
+using namespace std;
+
+namespace
+{
+
+class CountingConflictResolver : public IConflictResolver
+{
+public:
+	void order(const size_t group, span<size_t> transitions, const vector<size_t> &) override
+	{
+		calls.emplace_back(group, vector<size_t>(transitions.begin(), transitions.end()));
+		ranges::reverse(transitions);
+	}
+
+	vector<pair<size_t, vector<size_t>>> calls;
+};
+
+} // namespace
+
+TEST(ConflictGroups_, resolve_only_orders_transitions_sharing_activation_places)
+{
+	shared_ptr<IActionsExecutor> executor = ActionsExecutorFactory::createExecutor();
+	auto p1 = make_shared<Place>(PlaceProperties{ .name = "P1" }, executor);
+	auto p2 = make_shared<Place>(PlaceProperties{ .name = "P2" }, executor);
+	auto p3 = make_shared<Place>(PlaceProperties{ .name = "P3" }, executor);
+	const vector<pair<string, ConditionFunction>> noConditions;
+	vector<shared_ptr<Transition>> transitions{
+		make_shared<Transition>("T0", vector<Arc>{ { p2, 1 } }, vector<Arc>{}, vector<Arc>{}, noConditions, false),
+		make_shared<Transition>("T1", vector<Arc>{ { p1, 1 } }, vector<Arc>{}, vector<Arc>{}, noConditions, false),
+		make_shared<Transition>("T2", vector<Arc>{ { p3, 1 } }, vector<Arc>{ { p1, 1 } }, vector<Arc>{},
+								noConditions, false),
+		make_shared<Transition>("T3", vector<Arc>{ { p2, 1 }, { p3, 1 } }, vector<Arc>{}, vector<Arc>{},
+								noConditions, false),
+		make_shared<Transition>("T4", vector<Arc>{ { p1, 1 } }, vector<Arc>{}, vector<Arc>{}, noConditions, false),
+	};
+
+	ConflictGroups conflictGroups;
+	conflictGroups.build(transitions);
+	CountingConflictResolver conflictResolver;
+
+	// T0, T2 and T3 share P2 and P3, T1 and T4 share P1.
+	vector<size_t> enabledTransitions{ 4, 3, 1, 0 };
+	conflictGroups.resolve(enabledTransitions, conflictResolver);
+	ASSERT_EQ(2, conflictResolver.calls.size());
+	EXPECT_EQ(0, conflictResolver.calls[0].first);
+	EXPECT_EQ((vector<size_t>{ 0, 3 }), conflictResolver.calls[0].second);
+	EXPECT_EQ(1, conflictResolver.calls[1].first);
+	EXPECT_EQ((vector<size_t>{ 1, 4 }), conflictResolver.calls[1].second);
+	EXPECT_EQ((vector<size_t>{ 3, 0, 4, 1 }), enabledTransitions);
+
+	// No conflicts, no calls.
+	conflictResolver.calls.clear();
+	enabledTransitions = { 4, 2 };
+	conflictGroups.resolve(enabledTransitions, conflictResolver);
+	EXPECT_TRUE(conflictResolver.calls.empty());
+	EXPECT_EQ((vector<size_t>{ 2, 4 }), enabledTransitions);
+}
+
+TEST(ConflictResolvers_, random_resolver_is_reproducible_with_a_seed)
+{
+	auto first = ConflictResolverFactory::createConflictResolver(PTN_Engine::CONFLICT_RESOLUTION_POLICY::RANDOM, 7);
+	auto second = ConflictResolverFactory::createConflictResolver(PTN_Engine::CONFLICT_RESOLUTION_POLICY::RANDOM, 7);
+	const vector<size_t> priorities(10, 1);
+	for (int i = 0; i < 10; ++i)
+	{
+		vector<size_t> a{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		vector<size_t> b = a;
+		first->order(0, a, priorities);
+		second->order(0, b, priorities);
+		EXPECT_EQ(a, b);
+	}
+}
+
+TEST(ConflictResolvers_, round_robin_resolver_rotates_the_first_transition_per_group)
+{
+	RoundRobinConflictResolver conflictResolver;
+	const vector<size_t> priorities(5, 1);
+
+	vector<size_t> transitions{ 0, 2, 4 };
+	conflictResolver.order(0, transitions, priorities);
+	EXPECT_EQ((vector<size_t>{ 0, 2, 4 }), transitions);
+
+	transitions = { 1, 3 };
+	conflictResolver.order(1, transitions, priorities);
+	EXPECT_EQ((vector<size_t>{ 1, 3 }), transitions);
+
+	transitions = { 0, 2, 4 };
+	conflictResolver.order(0, transitions, priorities);
+	EXPECT_EQ((vector<size_t>{ 2, 4, 0 }), transitions);
+
+	transitions = { 0, 2, 4 };
+	conflictResolver.order(0, transitions, priorities);
+	EXPECT_EQ((vector<size_t>{ 4, 0, 2 }), transitions);
+}
+
+TEST(ConflictResolvers_, priority_resolver_orders_by_descending_priority)
+{
+	PriorityConflictResolver conflictResolver;
+	const vector<size_t> priorities{ 1, 5, 3, 5 };
+	vector<size_t> transitions{ 0, 1, 2, 3 };
+	conflictResolver.order(0, transitions, priorities);
+	EXPECT_EQ((vector<size_t>{ 1, 3, 2, 0 }), transitions);
+}
+
+TEST(ConflictResolvers_, weighted_random_resolver_fires_first_proportionally_to_the_priority)
+{
+	WeightedRandomConflictResolver conflictResolver(42);
+	const vector<size_t> priorities{ 3, 1, 0 };
+	int firstIsZero = 0;
+	for (int i = 0; i < 4000; ++i)
+	{
+		vector<size_t> transitions{ 0, 1, 2 };
+		conflictResolver.order(0, transitions, priorities);
+		EXPECT_EQ(2, transitions.back());
+		if (transitions.front() == 0)
+		{
+			++firstIsZero;
+		}
+	}
+	EXPECT_GT(firstIsZero, 2850);
+	EXPECT_LT(firstIsZero, 3150);
+}
@@ -0,0 +1,185 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/ActionTask.h"
+#include "PTN_Engine/Executor/CoroutineExecutor.h"
+#include "PTN_Engine/Executor/SingleThreadExecutor.h"
+#include "PTN_Engine/JobQueue/CoroutineRunner.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ptne;
+using namespace std;
+
+namespace
+{
+
+ActionTask sleepingAction(vector<int> &log, const int id, const chrono::milliseconds duration)
+{
+	log.push_back(id);
+	co_await sleepFor(duration);
+	log.push_back(-id);
+}
+
+} // namespace
+
+TEST(CoroutineRunner_, runUntilIdle_resumes_the_actions_in_the_order_of_their_timers)
+{
+	vector<int> log;
+	size_t completed = 0;
+	CoroutineRunner coroutineRunner;
+	auto notifier = make_shared<const ActionCompletedNotifier>([&completed] { ++completed; });
+	coroutineRunner.start(sleepingAction(log, 1, 30ms), nullptr, notifier);
+	coroutineRunner.start(sleepingAction(log, 2, 10ms), nullptr, notifier);
+	coroutineRunner.start(sleepingAction(log, 3, 20ms), nullptr, notifier);
+	// Started until the first suspension.
+	EXPECT_EQ((vector<int>{ 1, 2, 3 }), log);
+	EXPECT_EQ(0, completed);
+
+	coroutineRunner.runUntilIdle();
+	EXPECT_EQ((vector<int>{ 1, 2, 3, -2, -3, -1 }), log);
+	EXPECT_EQ(3, completed);
+}
+
+TEST(CoroutineRunner_, action_is_accounted_for_until_it_completes)
+{
+	atomic<size_t> actionsInExecution = 1;
+	const auto action = []() -> ActionTask
+	{
+		co_await sleepFor(1ms);
+		co_await sleepFor(1ms);
+	};
+	CoroutineRunner coroutineRunner;
+	coroutineRunner.start(action(), &actionsInExecution, nullptr);
+	EXPECT_EQ(1, actionsInExecution);
+	coroutineRunner.runUntilIdle();
+	EXPECT_EQ(0, actionsInExecution);
+}
+
+TEST(CoroutineRunner_, awaitCallback_resumes_the_action_from_another_thread)
+{
+	jthread ioThread;
+	thread::id resumedIn;
+	// The lambda outlives the coroutine, which refers to its captures.
+	const auto action = [&]() -> ActionTask
+	{
+		co_await awaitCallback(
+		[&ioThread](ActionResumer resume)
+		{
+			ioThread = jthread(
+			[resume]
+			{
+				this_thread::sleep_for(5ms);
+				resume();
+			});
+		});
+		resumedIn = this_thread::get_id();
+	};
+	CoroutineRunner coroutineRunner;
+	coroutineRunner.start(action(), nullptr, nullptr);
+	coroutineRunner.runUntilIdle();
+	EXPECT_EQ(this_thread::get_id(), resumedIn);
+}
+
+TEST(CoroutineRunner_, run_executes_posted_jobs_until_stopped)
+{
+	atomic<size_t> executed = 0;
+	CoroutineRunner coroutineRunner;
+	{
+		jthread runner([&coroutineRunner](stop_token stopToken) { coroutineRunner.run(move(stopToken)); });
+		for (size_t i = 0; i < 100; ++i)
+		{
+			coroutineRunner.post([&executed] { ++executed; });
+		}
+	}
+	EXPECT_EQ(100, executed);
+}
+
+TEST(CoroutineExecutor_, one_thread_keeps_many_suspended_actions_in_flight)
+{
+	constexpr size_t numberOfActions = 1000;
+	atomic<size_t> actionsInExecution = 0;
+	atomic<size_t> completed = 0;
+	mutex threadsMutex;
+	vector<thread::id> threads;
+	const AsyncActionFunction action = [&]() -> ActionTask
+	{
+		{
+			lock_guard guard(threadsMutex);
+			threads.push_back(this_thread::get_id());
+		}
+		co_await sleepFor(50ms);
+		++completed;
+	};
+	const auto start = chrono::steady_clock::now();
+	{
+		CoroutineExecutor coroutineExecutor;
+		for (size_t i = 0; i < numberOfActions; ++i)
+		{
+			coroutineExecutor.executeAsyncAction(action, actionsInExecution, nullptr);
+		}
+		EXPECT_LT(0, actionsInExecution);
+	}
+	// The actions slept at the same time, instead of one after the other.
+	EXPECT_LT(chrono::steady_clock::now() - start, 5s);
+	EXPECT_EQ(numberOfActions, completed);
+	EXPECT_EQ(0, actionsInExecution);
+	ASSERT_EQ(numberOfActions, threads.size());
+	EXPECT_EQ(numberOfActions, static_cast<size_t>(ranges::count(threads, threads.front())));
+}
+
+TEST(CoroutineExecutor_, notifier_is_called_once_the_action_completed)
+{
+	atomic<size_t> actionsInExecution = 0;
+	atomic<size_t> notified = 0;
+	atomic<size_t> actionsInExecutionWhenNotified = 1;
+	auto notifier = make_shared<const ActionCompletedNotifier>(
+	[&]
+	{
+		actionsInExecutionWhenNotified = actionsInExecution.load();
+		++notified;
+	});
+	const AsyncActionFunction action = []() -> ActionTask { co_await sleepFor(5ms); };
+	{
+		CoroutineExecutor coroutineExecutor;
+		coroutineExecutor.executeAsyncAction(action, actionsInExecution, notifier);
+		coroutineExecutor.executeAction([] {}, actionsInExecution, notifier);
+	}
+	EXPECT_EQ(2, notified);
+	EXPECT_EQ(0, actionsInExecutionWhenNotified);
+}
+
+TEST(CoroutineExecutor_, other_executors_run_the_coroutine_actions_to_completion)
+{
+	atomic<size_t> actionsInExecution = 0;
+	bool completed = false;
+	const AsyncActionFunction action = [&completed]() -> ActionTask
+	{
+		co_await sleepFor(1ms);
+		completed = true;
+	};
+	SingleThreadExecutor singleThreadExecutor;
+	singleThreadExecutor.executeAsyncAction(action, actionsInExecution, nullptr);
+	EXPECT_TRUE(completed);
+	EXPECT_EQ(0, actionsInExecution);
+}
@@ -0,0 +1,143 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/EnablingKernel.h"
+#include "PTN_Engine/FrozenNet.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace ptne;
+using namespace std;
+
+namespace
+{
+
+void addTransition(IncidenceMatrix &matrix, const vector<pair<size_t, size_t>> &arcs)
+{
+	if (matrix.offsets.empty())
+	{
+		matrix.offsets.push_back(0);
+	}
+	for (const auto &[place, weight] : arcs)
+	{
+		matrix.places.push_back(place);
+		matrix.weights.push_back(weight);
+	}
+	matrix.offsets.push_back(matrix.places.size());
+}
+
+bool isSet(const vector<uint64_t> &mask, const size_t transition)
+{
+	return (mask.at(transition / 64) >> (transition % 64)) & 1;
+}
+
+} // namespace
+
+TEST(EnablingKernel_, computeEnabled_checks_weights_and_inhibitors)
+{
+	// Places 0 to 2, place 3 is the sentinel.
+	IncidenceMatrix activationArcs;
+	IncidenceMatrix inhibitorArcs;
+	addTransition(activationArcs, { { 0, 1 } });
+	addTransition(inhibitorArcs, {});
+	addTransition(activationArcs, { { 0, 1 }, { 1, 3 } });
+	addTransition(inhibitorArcs, {});
+	addTransition(activationArcs, { { 0, 1 } });
+	addTransition(inhibitorArcs, { { 2, 1 } });
+	addTransition(activationArcs, {});
+	addTransition(inhibitorArcs, {});
+	addTransition(activationArcs, { { 1, 2 } });
+	addTransition(inhibitorArcs, {});
+
+	for (const bool allowSimd : { false, true })
+	{
+		EnablingKernel kernel(activationArcs, inhibitorArcs, 3, allowSimd);
+		vector<uint64_t> enabledMask;
+
+		kernel.computeEnabled({ 1, 2, 1, 0 }, enabledMask);
+		ASSERT_EQ(1, enabledMask.size());
+		EXPECT_EQ(0b11001, enabledMask[0]);
+
+		kernel.computeEnabled({ 1, 3, 0, 0 }, enabledMask);
+		EXPECT_EQ(0b11111, enabledMask[0]);
+
+		kernel.computeEnabled({ 0, 0, 0, 0 }, enabledMask);
+		EXPECT_EQ(0b01000, enabledMask[0]);
+	}
+}
+
+TEST(EnablingKernel_, simd_and_scalar_implementations_agree)
+{
+	mt19937_64 randomGenerator(42);
+	const size_t numberOfPlaces = 37;
+	const size_t numberOfTransitions = 131;
+
+	IncidenceMatrix activationArcs;
+	IncidenceMatrix inhibitorArcs;
+	for (size_t transition = 0; transition < numberOfTransitions; ++transition)
+	{
+		vector<pair<size_t, size_t>> activation;
+		for (size_t arc = randomGenerator() % 6; arc > 0; --arc)
+		{
+			activation.emplace_back(randomGenerator() % numberOfPlaces, randomGenerator() % 4);
+		}
+		addTransition(activationArcs, activation);
+
+		vector<pair<size_t, size_t>> inhibitor;
+		if (randomGenerator() % 4 == 0)
+		{
+			inhibitor.emplace_back(randomGenerator() % numberOfPlaces, 1);
+		}
+		addTransition(inhibitorArcs, inhibitor);
+	}
+
+	EnablingKernel scalarKernel(activationArcs, inhibitorArcs, numberOfPlaces, false);
+	EnablingKernel kernel(activationArcs, inhibitorArcs, numberOfPlaces);
+	EXPECT_FALSE(scalarKernel.isSimd());
+	EXPECT_EQ(EnablingKernel::isSimdSupported(), kernel.isSimd());
+
+	vector<size_t> tokens(numberOfPlaces + 1, 0);
+	vector<uint64_t> scalarMask;
+	vector<uint64_t> mask;
+	for (size_t i = 0; i < 100; ++i)
+	{
+		for (size_t place = 0; place < numberOfPlaces; ++place)
+		{
+			tokens[place] = randomGenerator() % 4;
+		}
+		tokens[1] = ~size_t(0);
+
+		scalarKernel.computeEnabled(tokens, scalarMask);
+		kernel.computeEnabled(tokens, mask);
+		ASSERT_EQ(scalarMask, mask);
+
+		for (size_t transition = 0; transition < numberOfTransitions; ++transition)
+		{
+			bool enabled = true;
+			for (size_t arc = activationArcs.offsets[transition]; arc < activationArcs.offsets[transition + 1]; ++arc)
+			{
+				enabled = enabled && tokens[activationArcs.places[arc]] >= activationArcs.weights[arc];
+			}
+			for (size_t arc = inhibitorArcs.offsets[transition]; arc < inhibitorArcs.offsets[transition + 1]; ++arc)
+			{
+				enabled = enabled && tokens[inhibitorArcs.places[arc]] == 0;
+			}
+			EXPECT_EQ(enabled, isSet(mask, transition));
+		}
+	}
+}
@@ -0,0 +1,193 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PTN_Engine/EngineScheduler.h"
+#include "PTN_Engine/PTN_Engine.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace ptne;
+using namespace std;
+
+namespace
+{
+
+//! Creates a net moving tokens from the input place P1 to P2 and then to P3.
+void createNet(PTN_Engine &ptnEngine)
+{
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P3" } } });
+}
+
+//! Waits until the place has the number of tokens, or a timeout.
+bool waitForTokens(const PTN_Engine &ptnEngine, const string &place, const size_t tokens)
+{
+	const auto deadline = chrono::steady_clock::now() + 5s;
+	while (ptnEngine.getNumberOfTokens(place) != tokens)
+	{
+		if (chrono::steady_clock::now() > deadline)
+		{
+			return false;
+		}
+		this_thread::sleep_for(100us);
+	}
+	return true;
+}
+
+} // namespace
+
+TEST(EngineScheduler_, constructor_throws_with_no_threads_or_no_cycle_budget)
+{
+	EXPECT_THROW(EngineScheduler(0), PTN_Exception);
+	EXPECT_THROW(EngineScheduler(1, 0), PTN_Exception);
+
+	EngineScheduler engineScheduler(2, 4);
+	EXPECT_EQ(2, engineScheduler.getNumberOfThreads());
+	EXPECT_EQ(4, engineScheduler.getCycleBudget());
+	EXPECT_EQ(0, engineScheduler.getNumberOfEngines());
+}
+
+TEST(EngineScheduler_, execute_registers_and_stop_unregisters_the_engine)
+{
+	auto engineScheduler = make_shared<EngineScheduler>(1);
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	EXPECT_EQ(nullptr, ptnEngine.getEngineScheduler());
+	ptnEngine.setEngineScheduler(engineScheduler);
+	EXPECT_EQ(engineScheduler, ptnEngine.getEngineScheduler());
+	createNet(ptnEngine);
+
+	ptnEngine.execute();
+	EXPECT_TRUE(ptnEngine.isEventLoopRunning());
+	EXPECT_EQ(1, engineScheduler->getNumberOfEngines());
+	EXPECT_THROW(ptnEngine.setEngineScheduler(nullptr), PTN_Exception);
+
+	ptnEngine.stop();
+	EXPECT_FALSE(ptnEngine.isEventLoopRunning());
+	EXPECT_EQ(0, engineScheduler->getNumberOfEngines());
+	ptnEngine.setEngineScheduler(nullptr);
+	EXPECT_EQ(nullptr, ptnEngine.getEngineScheduler());
+}
+
+TEST(EngineScheduler_, many_engines_run_on_few_threads)
+{
+	constexpr size_t numberOfEngines = 50;
+	constexpr size_t numberOfTokens = 20;
+	auto engineScheduler = make_shared<EngineScheduler>(2, 1);
+	vector<unique_ptr<PTN_Engine>> ptnEngines;
+	for (size_t i = 0; i < numberOfEngines; ++i)
+	{
+		auto &ptnEngine =
+		ptnEngines.emplace_back(make_unique<PTN_Engine>(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP));
+		ptnEngine->setEngineScheduler(engineScheduler);
+		createNet(*ptnEngine);
+		ptnEngine->execute();
+	}
+	EXPECT_EQ(numberOfEngines, engineScheduler->getNumberOfEngines());
+
+	for (size_t i = 0; i < numberOfTokens; ++i)
+	{
+		for (auto &ptnEngine : ptnEngines)
+		{
+			ptnEngine->incrementInputPlace("P1");
+		}
+	}
+	for (auto &ptnEngine : ptnEngines)
+	{
+		EXPECT_TRUE(waitForTokens(*ptnEngine, "P3", numberOfTokens));
+		EXPECT_EQ(0, ptnEngine->getNumberOfTokens("P1"));
+		EXPECT_EQ(0, ptnEngine->getNumberOfTokens("P2"));
+	}
+
+	for (auto &ptnEngine : ptnEngines)
+	{
+		ptnEngine->stop();
+	}
+	EXPECT_EQ(0, engineScheduler->getNumberOfEngines());
+}
+
+TEST(EngineScheduler_, actions_completed_wake_up_the_engine)
+{
+	auto engineScheduler = make_shared<EngineScheduler>(1);
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE);
+	ptnEngine.setEngineScheduler(engineScheduler);
+	atomic<size_t> actions = 0;
+	ptnEngine.registerAction("Count", [&actions] { ++actions; });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .onEnterActionFunctionName = "Count", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .requireNoActionsInExecution = true });
+	ptnEngine.setEventLoopWatchdogEnabled(false);
+	ptnEngine.execute();
+
+	for (size_t i = 0; i < 10; ++i)
+	{
+		ptnEngine.incrementInputPlace("P1");
+	}
+	EXPECT_TRUE(waitForTokens(ptnEngine, "P2", 10));
+	EXPECT_EQ(10, actions);
+	ptnEngine.stop();
+}
+
+TEST(EngineScheduler_, watchdog_executes_the_idle_engine_when_conditions_change_unnotified)
+{
+	auto engineScheduler = make_shared<EngineScheduler>(1);
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	ptnEngine.setEngineScheduler(engineScheduler);
+	atomic<bool> open = false;
+	ptnEngine.registerCondition("Open", [&open] { return open.load(); });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .additionalConditionsNames = { "Open" } });
+	ptnEngine.setEventLoopSleepDuration(PTN_Engine::EventLoopSleepDuration(20));
+	ptnEngine.execute();
+
+	this_thread::sleep_for(50ms);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P2"));
+	open = true;
+	EXPECT_TRUE(waitForTokens(ptnEngine, "P2", 1));
+	ptnEngine.stop();
+}
+
+TEST(EngineScheduler_, single_thread_engine_ignores_the_scheduler)
+{
+	auto engineScheduler = make_shared<EngineScheduler>(1);
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.setEngineScheduler(engineScheduler);
+	createNet(ptnEngine);
+	ptnEngine.incrementInputPlace("P1");
+	ptnEngine.execute();
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P3"));
+	EXPECT_EQ(0, engineScheduler->getNumberOfEngines());
+}
@@ -19,6 +19,11 @@
 #include "PTN_Engine/EventLoop.h"
 #include "PTN_Engine/PTN_EngineImp.h"
 #include <gtest/gtest.h>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 using namespace ptne;
 using namespace std;
@@ -67,13 +72,187 @@ TEST_F(EventLoop_PTNEnginImpObj, start_again_throws)
 	eventLoop.stop();
 }
 
-// void notifyNewEvent();
-TEST_F(EventLoop_PTNEnginImpObj, notifyNewEvent)
+namespace
+{
+
+//! Counts the cycles executed by the event loop, none of which fires a transition.
+class IdleEngine : public IPTN_EngineEL
 {
-	ASSERT_FALSE(eventLoop.isRunning());
-	// TO DO
-	// fake the ptn_engine
+public:
+	bool executeInt(const bool, ostream &) override
+	{
+		++cycles;
+		cycles.notify_all();
+		return false;
+	}
+
+	PTN_Engine::ACTIONS_THREAD_OPTION getActionsThreadOption() const override
+	{
+		return PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP;
+	}
+
+	atomic<size_t> cycles = 0;
+};
+
+//! Wait until the event loop executed a given number of cycles, for at most one second.
+bool waitForCycles(const IdleEngine &engine, const size_t cycles)
+{
+	const auto deadline = chrono::steady_clock::now() + 1s;
+	while (engine.cycles < cycles && chrono::steady_clock::now() < deadline)
+	{
+		this_thread::sleep_for(100us);
+	}
+	return engine.cycles >= cycles;
+}
+
+} // namespace
+
+TEST(EventLoop_, notifyNewEvent_wakes_up_the_parked_event_loop)
+{
+	IdleEngine engine;
+	EventLoop eventLoop(engine);
+	eventLoop.setWatchdogEnabled(false);
+	eventLoop.start(false, std::cout);
+	ASSERT_TRUE(waitForCycles(engine, 1));
+
+	// Without watchdog an idle loop does not execute the net again until notified.
+	this_thread::sleep_for(50ms);
+	EXPECT_EQ(1, engine.cycles);
+
+	eventLoop.notifyNewEvent();
+	EXPECT_TRUE(waitForCycles(engine, 2));
+
+	// Notifying functions outlive the loop.
+	const auto eventNotifier = eventLoop.getEventNotifier();
+	eventNotifier();
+	EXPECT_TRUE(waitForCycles(engine, 3));
+
+	// Stopping does not wait for a watchdog period.
+	const auto stopStart = chrono::steady_clock::now();
+	eventLoop.stop();
+	EXPECT_LT(chrono::steady_clock::now() - stopStart, 1s);
+	EXPECT_FALSE(eventLoop.isRunning());
+}
+
+TEST(EventLoop_, watchdog_wakes_up_the_parked_event_loop_periodically)
+{
+	IdleEngine engine;
+	EventLoop eventLoop(engine);
+	EXPECT_TRUE(eventLoop.isWatchdogEnabled());
+	eventLoop.setSleepDuration(1ms);
+	eventLoop.start(false, std::cout);
+	EXPECT_TRUE(waitForCycles(engine, 5));
+	eventLoop.stop();
+}
+
+TEST(EventLoop_, spinning_catches_events_before_parking)
+{
+	IdleEngine engine;
+	EventLoop eventLoop(engine);
+	EXPECT_EQ(EventLoop::SpinDuration::zero(), eventLoop.getSpinDuration());
+	EXPECT_THROW(eventLoop.setSpinDuration(-1us), PTN_Exception);
+	eventLoop.setSpinDuration(2s);
+	EXPECT_EQ(2s, eventLoop.getSpinDuration());
+	eventLoop.setWatchdogEnabled(false);
+	eventLoop.start(false, std::cout);
+	ASSERT_TRUE(waitForCycles(engine, 1));
+	for (size_t i = 2; i < 10; ++i)
+	{
+		eventLoop.notifyNewEvent();
+		ASSERT_TRUE(waitForCycles(engine, i));
+	}
+	eventLoop.stop();
+}
+
+TEST(EventLoop_, event_notifier_does_nothing_once_the_event_loop_was_destroyed)
+{
+	function<void()> eventNotifier;
+	{
+		IdleEngine engine;
+		EventLoop eventLoop(engine);
+		eventNotifier = eventLoop.getEventNotifier();
+	}
+	EXPECT_NO_THROW(eventNotifier());
+}
+
+TEST(EventLoop_, busy_polling_reacts_to_events_without_parking)
+{
+	IdleEngine engine;
+	EventLoop eventLoop(engine);
+	EXPECT_FALSE(eventLoop.isBusyPolling());
+	eventLoop.setBusyPolling(true);
+	EXPECT_TRUE(eventLoop.isBusyPolling());
+	eventLoop.setWatchdogEnabled(false);
+	eventLoop.start(false, std::cout);
+	ASSERT_TRUE(waitForCycles(engine, 1));
+	for (size_t i = 2; i < 5; ++i)
+	{
+		eventLoop.notifyNewEvent();
+		ASSERT_TRUE(waitForCycles(engine, i));
+	}
+	eventLoop.stop();
+	EXPECT_FALSE(eventLoop.isRunning());
+}
+
+TEST(EventLoop_, watchdog_wakes_up_the_busy_polling_event_loop_periodically)
+{
+	IdleEngine engine;
+	EventLoop eventLoop(engine);
+	eventLoop.setBusyPolling(true);
+	EXPECT_TRUE(eventLoop.isWatchdogEnabled());
+	eventLoop.setSleepDuration(1ms);
+	eventLoop.start(false, std::cout);
+	// No notifications, only the watchdog executes the idle net again.
+	EXPECT_TRUE(waitForCycles(engine, 5));
+	eventLoop.stop();
+	EXPECT_FALSE(eventLoop.isRunning());
+}
+
+TEST(EventLoop_, setThreadScheduling_validates_the_scheduling)
+{
+	IdleEngine engine;
+	EventLoop eventLoop(engine);
+	EXPECT_EQ(ThreadScheduling{}, eventLoop.getThreadScheduling());
+#if defined(__linux__)
+	EXPECT_THROW(eventLoop.setThreadScheduling(ThreadScheduling{ .cpu = CPU_SETSIZE }), PTN_Exception);
+	EXPECT_THROW(eventLoop.setThreadScheduling(ThreadScheduling{ .fifoPriority = -1 }), PTN_Exception);
+	eventLoop.setThreadScheduling(ThreadScheduling{ .cpu = 0 });
+	EXPECT_EQ(ThreadScheduling{ .cpu = 0 }, eventLoop.getThreadScheduling());
+#else
+	EXPECT_THROW(eventLoop.setThreadScheduling(ThreadScheduling{ .cpu = 0 }), PTN_Exception);
+#endif
+	eventLoop.start(false, std::cout);
+	EXPECT_THROW(eventLoop.setThreadScheduling(ThreadScheduling{}), PTN_Exception);
+	eventLoop.stop();
+}
+
+#if defined(__linux__)
+TEST(EventLoop_, thread_scheduling_pins_the_event_loop_thread)
+{
+	//! Records the core the event loop thread runs on.
+	class CoreRecordingEngine : public IdleEngine
+	{
+	public:
+		bool executeInt(const bool log, ostream &o) override
+		{
+			core = sched_getcpu();
+			return IdleEngine::executeInt(log, o);
+		}
+
+		atomic<int> core = -1;
+	};
+
+	CoreRecordingEngine engine;
+	EventLoop eventLoop(engine);
+	eventLoop.setSleepDuration(1ms);
+	eventLoop.setThreadScheduling(ThreadScheduling{ .cpu = 0 });
+	eventLoop.start(false, std::cout);
+	// The first cycle may run before the thread was pinned.
+	ASSERT_TRUE(waitForCycles(engine, 3));
+	eventLoop.stop();
+	EXPECT_EQ(0, engine.core);
 }
+#endif
 
 TEST_F(EventLoop_PTNEnginImpObj, setSleepDuration)
 {
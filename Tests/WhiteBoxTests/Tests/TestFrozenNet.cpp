@@ -0,0 +1,251 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/ConflictResolution/PriorityConflictResolver.h"
+#include "PTN_Engine/ConflictResolution/RandomConflictResolver.h"
+#include "PTN_Engine/Executor/ActionsExecutorFactory.h"
+#include "PTN_Engine/FrozenNet.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include "PTN_Engine/Place.h"
+#include "PTN_Engine/Transition.h"
+#include <climits>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace ptne;
+using namespace std;
+
+class FrozenNet_Obj : public testing::Test
+{
+public:
+	shared_ptr<IActionsExecutor> executor = ActionsExecutorFactory::createExecutor();
+	RandomConflictResolver conflictResolver = RandomConflictResolver(0);
+	shared_ptr<Place> p1 = make_shared<Place>(PlaceProperties{ .name = "P1", .input = true }, executor);
+	shared_ptr<Place> p2 = make_shared<Place>(PlaceProperties{ .name = "P2", .initialNumberOfTokens = 1 }, executor);
+	shared_ptr<Place> p3 = make_shared<Place>(PlaceProperties{ .name = "P3" }, executor);
+};
+
+TEST_F(FrozenNet_Obj, execute_fires_each_enabled_transition_once)
+{
+	bool condition = false;
+	auto t1 = make_shared<Transition>("T1", vector<Arc>{ { p1, 1 } }, vector<Arc>{ { p3, 2 } }, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, false);
+	auto t2 = make_shared<Transition>("T2", vector<Arc>{ { p2, 1 } }, vector<Arc>{ { p3, 1 } }, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{ { "C1", [&condition] { return condition; } } },
+									  false);
+	FrozenNet frozenNet({ p1, p2, p3 }, { t1, t2 }, conflictResolver);
+
+	EXPECT_FALSE(frozenNet.execute());
+
+	frozenNet.incrementInputPlace("P1");
+	frozenNet.incrementInputPlace("P1");
+	EXPECT_TRUE(frozenNet.execute());
+	EXPECT_EQ(1, frozenNet.getNumberOfTokens("P1"));
+	EXPECT_EQ(1, frozenNet.getNumberOfTokens("P2"));
+	EXPECT_EQ(2, frozenNet.getNumberOfTokens("P3"));
+
+	condition = true;
+	EXPECT_TRUE(frozenNet.execute());
+	EXPECT_EQ(0, frozenNet.getNumberOfTokens("P1"));
+	EXPECT_EQ(0, frozenNet.getNumberOfTokens("P2"));
+	EXPECT_EQ(5, frozenNet.getNumberOfTokens("P3"));
+
+	// The places are only updated once thawed.
+	EXPECT_EQ(0, p3->getNumberOfTokens());
+	frozenNet.thaw();
+	EXPECT_EQ(0, p1->getNumberOfTokens());
+	EXPECT_EQ(0, p2->getNumberOfTokens());
+	EXPECT_EQ(5, p3->getNumberOfTokens());
+}
+
+TEST_F(FrozenNet_Obj, inhibitor_arcs_disable_transitions)
+{
+	auto t1 = make_shared<Transition>("T1", vector<Arc>{ { p2, 1 } }, vector<Arc>{}, vector<Arc>{ { p1, 1 } },
+									  vector<pair<string, ConditionFunction>>{}, false);
+	FrozenNet frozenNet({ p1, p2, p3 }, { t1 }, conflictResolver);
+
+	frozenNet.incrementInputPlace("P1");
+	EXPECT_FALSE(frozenNet.execute());
+	frozenNet.clearInputPlaces();
+	EXPECT_TRUE(frozenNet.execute());
+	EXPECT_EQ(0, frozenNet.getNumberOfTokens("P2"));
+}
+
+TEST_F(FrozenNet_Obj, incrementInputPlace_throws_for_invalid_places)
+{
+	FrozenNet frozenNet({ p1, p2, p3 }, {}, conflictResolver);
+	EXPECT_THROW(frozenNet.incrementInputPlace("P2"), NotInputPlaceException);
+	EXPECT_THROW(frozenNet.incrementInputPlace("P4"), InvalidNameException);
+}
+
+TEST_F(FrozenNet_Obj, incrementInputPlace_adds_count_tokens)
+{
+	FrozenNet frozenNet({ p1, p2, p3 }, {}, conflictResolver);
+	frozenNet.incrementInputPlace("P1", 4);
+	frozenNet.incrementInputPlace(0, 2);
+	EXPECT_EQ(6, frozenNet.getNumberOfTokens("P1"));
+	EXPECT_THROW(frozenNet.incrementInputPlace("P1", 0), NullTokensException);
+}
+
+TEST_F(FrozenNet_Obj, incrementInputPlaces_adds_no_tokens_if_an_increment_is_invalid)
+{
+	auto p4 = make_shared<Place>(PlaceProperties{ .name = "P4", .input = true }, executor);
+	FrozenNet frozenNet({ p1, p2, p3, p4 }, {}, conflictResolver);
+
+	vector<pair<PlaceHandle, size_t>> increments{ { { 0 }, 2 }, { { 3 }, 1 }, { { 0 }, 1 } };
+	frozenNet.incrementInputPlaces(increments);
+	EXPECT_EQ(3, frozenNet.getNumberOfTokens("P1"));
+	EXPECT_EQ(1, frozenNet.getNumberOfTokens("P4"));
+
+	increments = { { { 0 }, 2 }, { { 1 }, 1 } };
+	EXPECT_THROW(frozenNet.incrementInputPlaces(increments), NotInputPlaceException);
+	increments = { { { 0 }, 2 }, { { 4 }, 1 } };
+	EXPECT_THROW(frozenNet.incrementInputPlaces(increments), InvalidHandleException);
+	increments = { { { 0 }, 2 }, { { 3 }, 0 } };
+	EXPECT_THROW(frozenNet.incrementInputPlaces(increments), NullTokensException);
+	increments = { { { 3 }, 2 }, { { 0 }, ULLONG_MAX } };
+	EXPECT_THROW(frozenNet.incrementInputPlaces(increments), OverflowException);
+	EXPECT_EQ(3, frozenNet.getNumberOfTokens("P1"));
+	EXPECT_EQ(1, frozenNet.getNumberOfTokens("P4"));
+}
+
+TEST_F(FrozenNet_Obj, execute_with_multi_firing_drains_the_backlog_in_one_cycle)
+{
+	auto t1 = make_shared<Transition>("T1", vector<Arc>{ { p1, 2 } }, vector<Arc>{ { p3, 1 } }, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, false);
+	FrozenNet frozenNet({ p1, p2, p3 }, { t1 }, conflictResolver);
+
+	for (int i = 0; i < 9; ++i)
+	{
+		frozenNet.incrementInputPlace("P1");
+	}
+	EXPECT_TRUE(frozenNet.execute(true));
+	EXPECT_EQ(1, frozenNet.getNumberOfTokens("P1"));
+	EXPECT_EQ(4, frozenNet.getNumberOfTokens("P3"));
+	EXPECT_FALSE(frozenNet.execute(true));
+}
+
+TEST_F(FrozenNet_Obj, execute_maximal_step_produces_tokens_after_all_transitions_consumed)
+{
+	// P1 -> T1 -> P2 -> T2 -> P3, with T3 competing with T2 for the tokens in P2.
+	auto t1 = make_shared<Transition>("T1", vector<Arc>{ { p1, 1 } }, vector<Arc>{ { p2, 1 } }, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, false);
+	auto t2 = make_shared<Transition>("T2", vector<Arc>{ { p2, 1 } }, vector<Arc>{ { p3, 1 } }, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, false, 2);
+	auto t3 = make_shared<Transition>("T3", vector<Arc>{ { p2, 1 } }, vector<Arc>{}, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, false, 1);
+	PriorityConflictResolver priorityConflictResolver;
+	FrozenNet frozenNet({ p1, p2, p3 }, { t1, t2, t3 }, priorityConflictResolver);
+
+	frozenNet.incrementInputPlace("P1");
+	frozenNet.incrementInputPlace("P1");
+	EXPECT_TRUE(frozenNet.execute(true, true));
+	// T2 wins the conflict and takes the token that was in P2. The tokens produced by T1 are only available in
+	// the next step.
+	EXPECT_EQ(0, frozenNet.getNumberOfTokens("P1"));
+	EXPECT_EQ(2, frozenNet.getNumberOfTokens("P2"));
+	EXPECT_EQ(1, frozenNet.getNumberOfTokens("P3"));
+
+	EXPECT_TRUE(frozenNet.execute(true, true));
+	EXPECT_EQ(0, frozenNet.getNumberOfTokens("P2"));
+	EXPECT_EQ(3, frozenNet.getNumberOfTokens("P3"));
+}
+
+TEST_F(FrozenNet_Obj, execute_fires_independent_regions_in_parallel)
+{
+	// 40 independent lines, all depositing tokens in the same sink place.
+	const size_t numberOfLines = 40;
+	const size_t tokensPerLine = 50;
+	size_t sinkActions = 0;
+	bool actionsInCallingThread = true;
+	const auto callingThread = this_thread::get_id();
+	auto sink = make_shared<Place>(PlaceProperties{ .name = "Sink",
+													.onEnterAction =
+													[&]
+													{
+														++sinkActions;
+														actionsInCallingThread =
+														actionsInCallingThread && this_thread::get_id() == callingThread;
+													} },
+								   executor);
+
+	vector<shared_ptr<Place>> places{ sink };
+	vector<shared_ptr<Transition>> transitions;
+	for (size_t line = 0; line < numberOfLines; ++line)
+	{
+		const string id = to_string(line);
+		auto input = make_shared<Place>(
+		PlaceProperties{ .name = "I" + id, .initialNumberOfTokens = tokensPerLine, .input = true }, executor);
+		auto output = make_shared<Place>(PlaceProperties{ .name = "O" + id }, executor);
+		places.push_back(input);
+		places.push_back(output);
+		transitions.push_back(make_shared<Transition>("T" + id, vector<Arc>{ { input, 1 } },
+													  vector<Arc>{ { output, 1 }, { sink, 1 } }, vector<Arc>{},
+													  vector<pair<string, ConditionFunction>>{}, false));
+	}
+	FrozenNet frozenNet(places, transitions, conflictResolver);
+	EXPECT_EQ(1, frozenNet.getNumberOfFiringThreads());
+	EXPECT_THROW(frozenNet.setNumberOfFiringThreads(0), PTN_Exception);
+	frozenNet.setNumberOfFiringThreads(4);
+	EXPECT_EQ(4, frozenNet.getNumberOfFiringThreads());
+
+	size_t cycles = 0;
+	while (frozenNet.execute())
+	{
+		++cycles;
+	}
+	EXPECT_EQ(tokensPerLine, cycles);
+	EXPECT_EQ(numberOfLines * tokensPerLine, frozenNet.getNumberOfTokens("Sink"));
+	EXPECT_EQ(numberOfLines * tokensPerLine, sinkActions);
+	EXPECT_TRUE(actionsInCallingThread);
+	for (size_t line = 0; line < numberOfLines; ++line)
+	{
+		EXPECT_EQ(0, frozenNet.getNumberOfTokens("I" + to_string(line)));
+		EXPECT_EQ(tokensPerLine, frozenNet.getNumberOfTokens("O" + to_string(line)));
+	}
+}
+
+TEST_F(FrozenNet_Obj, execute_maximal_step_with_parallel_regions)
+{
+	// Same net as the sequential maximal step test, plus an independent region P4 -> T4 -> P3.
+	auto p4 = make_shared<Place>(PlaceProperties{ .name = "P4", .initialNumberOfTokens = 3 }, executor);
+	auto t1 = make_shared<Transition>("T1", vector<Arc>{ { p1, 1 } }, vector<Arc>{ { p2, 1 } }, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, false);
+	auto t2 = make_shared<Transition>("T2", vector<Arc>{ { p2, 1 } }, vector<Arc>{ { p3, 1 } }, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, false, 2);
+	auto t3 = make_shared<Transition>("T3", vector<Arc>{ { p2, 1 } }, vector<Arc>{}, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, false, 1);
+	auto t4 = make_shared<Transition>("T4", vector<Arc>{ { p4, 1 } }, vector<Arc>{ { p3, 1 } }, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, false);
+	PriorityConflictResolver priorityConflictResolver;
+	FrozenNet frozenNet({ p1, p2, p3, p4 }, { t1, t2, t3, t4 }, priorityConflictResolver);
+	frozenNet.setNumberOfFiringThreads(2);
+
+	frozenNet.incrementInputPlace("P1");
+	frozenNet.incrementInputPlace("P1");
+	EXPECT_TRUE(frozenNet.execute(true, true));
+	EXPECT_EQ(0, frozenNet.getNumberOfTokens("P1"));
+	EXPECT_EQ(2, frozenNet.getNumberOfTokens("P2"));
+	EXPECT_EQ(4, frozenNet.getNumberOfTokens("P3"));
+	EXPECT_EQ(0, frozenNet.getNumberOfTokens("P4"));
+
+	EXPECT_TRUE(frozenNet.execute(true, true));
+	EXPECT_EQ(0, frozenNet.getNumberOfTokens("P2"));
+	EXPECT_EQ(6, frozenNet.getNumberOfTokens("P3"));
+	EXPECT_FALSE(frozenNet.execute(true, true));
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Utilities/InPlaceFunction.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <functional>
+#include <memory>
+
+using namespace ptne::utility;
+using namespace std;
+
+using SmallFunction = InPlaceFunction<void(), 16>;
+
+TEST(InPlaceFunction_, stores_small_callables_in_place)
+{
+	int calls = 0;
+	auto small = [&calls] { ++calls; };
+	auto large = [&calls, padding = array<char, 64>()] { calls += 1 + padding[0]; };
+	static_assert(SmallFunction::isStoredInPlace<decltype(small)>());
+	static_assert(!SmallFunction::isStoredInPlace<decltype(large)>());
+
+	SmallFunction smallFunction(small);
+	SmallFunction largeFunction(large);
+	smallFunction();
+	largeFunction();
+	EXPECT_EQ(2, calls);
+}
+
+TEST(InPlaceFunction_, holds_move_only_callables)
+{
+	auto value = make_unique<int>(3);
+	InPlaceFunction<int(int), 16> function([value = move(value)](const int factor) { return *value * factor; });
+	EXPECT_EQ(6, function(2));
+}
+
+TEST(InPlaceFunction_, moving_transfers_the_callable)
+{
+	auto counter = make_shared<int>(0);
+	auto large = [counter, padding = array<char, 64>()] { ++*counter; };
+	SmallFunction inPlace([counter] { ++*counter; });
+	SmallFunction onHeap(move(large));
+	EXPECT_EQ(3, counter.use_count());
+
+	SmallFunction movedInPlace(move(inPlace));
+	SmallFunction movedOnHeap;
+	movedOnHeap = move(onHeap);
+	EXPECT_FALSE(inPlace);
+	EXPECT_FALSE(onHeap);
+	movedInPlace();
+	movedOnHeap();
+	EXPECT_EQ(2, *counter);
+	EXPECT_EQ(3, counter.use_count());
+
+	movedInPlace = nullptr;
+	movedOnHeap = nullptr;
+	EXPECT_EQ(1, counter.use_count());
+}
+
+TEST(InPlaceFunction_, empty_functions_and_null_pointers_are_empty)
+{
+	EXPECT_FALSE(SmallFunction());
+	EXPECT_FALSE(SmallFunction(nullptr));
+	EXPECT_FALSE(SmallFunction(function<void()>()));
+	void (*null)() = nullptr;
+	EXPECT_FALSE(SmallFunction(null));
+	EXPECT_TRUE(SmallFunction([] {}));
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/InputQueue.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace ptne;
+using namespace std;
+
+TEST(InputQueue_, capacity_is_rounded_up_to_a_power_of_two)
+{
+	EXPECT_THROW(InputQueue(0), PTN_Exception);
+	EXPECT_EQ(2, InputQueue(1).getCapacity());
+	EXPECT_EQ(8, InputQueue(5).getCapacity());
+	EXPECT_EQ(8, InputQueue(8).getCapacity());
+}
+
+TEST(InputQueue_, pop_returns_the_inputs_in_the_order_they_were_pushed)
+{
+	InputQueue inputQueue(4);
+	InputQueue::Input input;
+	EXPECT_TRUE(inputQueue.empty());
+	EXPECT_FALSE(inputQueue.pop(input));
+
+	// Going around the ring several times.
+	for (size_t lap = 0; lap < 3; ++lap)
+	{
+		for (size_t i = 0; i < 4; ++i)
+		{
+			ASSERT_TRUE(inputQueue.push({ .place = i, .count = lap + 1 }));
+		}
+		EXPECT_FALSE(inputQueue.push({ .place = 4, .count = 1 }));
+		EXPECT_FALSE(inputQueue.empty());
+		for (size_t i = 0; i < 4; ++i)
+		{
+			ASSERT_TRUE(inputQueue.pop(input));
+			EXPECT_EQ(i, input.place);
+			EXPECT_EQ(lap + 1, input.count);
+		}
+		EXPECT_TRUE(inputQueue.empty());
+	}
+}
+
+TEST(InputQueue_, push_from_several_threads_loses_no_input)
+{
+	const size_t numberOfProducers = 4;
+	const size_t inputsPerProducer = 10000;
+	InputQueue inputQueue(64);
+
+	vector<jthread> producers;
+	for (size_t producer = 0; producer < numberOfProducers; ++producer)
+	{
+		producers.emplace_back(
+		[&inputQueue, producer]
+		{
+			for (size_t i = 0; i < inputsPerProducer; ++i)
+			{
+				while (!inputQueue.push({ .place = producer, .count = i }))
+				{
+					this_thread::yield();
+				}
+			}
+		});
+	}
+
+	// Inputs of each producer are taken in the order they were pushed.
+	vector<size_t> nextCount(numberOfProducers, 0);
+	size_t received = 0;
+	InputQueue::Input input;
+	while (received < numberOfProducers * inputsPerProducer)
+	{
+		if (!inputQueue.pop(input))
+		{
+			this_thread::yield();
+			continue;
+		}
+		ASSERT_LT(input.place, numberOfProducers);
+		ASSERT_EQ(nextCount[input.place], input.count);
+		++nextCount[input.place];
+		++received;
+	}
+	EXPECT_TRUE(inputQueue.empty());
+}
@@ -18,6 +18,9 @@
 
 #include "PTN_Engine/JobQueue/JobQueue.h"
 #include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 using namespace ptne;
 using namespace std;
@@ -63,3 +66,126 @@ TEST_F(JobQueue_Obj, run_add_job_runs_job_immediately_if_active)
 	this_thread::sleep_for(20ms);
 	EXPECT_TRUE(executed);
 }
+
+TEST_F(JobQueue_Obj, jobs_of_different_bursts_run_in_the_same_worker_thread)
+{
+	atomic<size_t> executed = 0;
+	thread::id firstWorker;
+	thread::id secondWorker;
+
+	jobQueue.addJob([&] { firstWorker = this_thread::get_id(); ++executed; executed.notify_all(); });
+	executed.wait(0);
+	// The worker parks instead of exiting once the queue is empty.
+	this_thread::sleep_for(10ms);
+	jobQueue.addJob([&] { secondWorker = this_thread::get_id(); ++executed; executed.notify_all(); });
+	executed.wait(1);
+
+	EXPECT_NE(this_thread::get_id(), firstWorker);
+	EXPECT_EQ(firstWorker, secondWorker);
+}
+
+TEST_F(JobQueue_Obj, deactivate_executes_the_queued_jobs)
+{
+	atomic<bool> release = false;
+	vector<size_t> order;
+	jobQueue.addJob([&release] { release.wait(false); });
+	for (size_t i = 0; i < 10; ++i)
+	{
+		jobQueue.addJob([&order, i] { order.push_back(i); });
+	}
+	thread releaser(
+	[&release]
+	{
+		this_thread::sleep_for(10ms);
+		release = true;
+		release.notify_all();
+	});
+	jobQueue.deactivate();
+	releaser.join();
+
+	ASSERT_EQ(10, order.size());
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		EXPECT_EQ(i, order[i]);
+	}
+}
+
+TEST(JobQueue_, bounded_fail_fast_rejects_jobs_while_full)
+{
+	JobQueue jobQueue(2, PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY::FAIL_FAST);
+	EXPECT_EQ(2, jobQueue.getCapacity());
+	jobQueue.deactivate();
+
+	atomic<size_t> executed = 0;
+	size_t dropped = 0;
+	auto job = [&executed] { ++executed; };
+	auto onDropped = [&dropped] { ++dropped; };
+	EXPECT_TRUE(jobQueue.addJob(job, onDropped));
+	EXPECT_TRUE(jobQueue.addJob(job, onDropped));
+	EXPECT_FALSE(jobQueue.addJob(job, onDropped));
+	EXPECT_EQ(1, dropped);
+
+	JobQueueMetrics metrics = jobQueue.getMetrics();
+	EXPECT_EQ(2, metrics.enqueuedJobs);
+	EXPECT_EQ(1, metrics.rejectedJobs);
+	EXPECT_EQ(2, metrics.depth);
+	EXPECT_EQ(2, metrics.highWaterMark);
+
+	jobQueue.activate();
+	jobQueue.deactivate();
+	EXPECT_EQ(2, executed);
+	metrics = jobQueue.getMetrics();
+	EXPECT_EQ(2, metrics.dequeuedJobs);
+	EXPECT_EQ(0, metrics.depth);
+	EXPECT_EQ(2, metrics.highWaterMark);
+}
+
+TEST(JobQueue_, bounded_drop_oldest_replaces_the_oldest_job)
+{
+	JobQueue jobQueue(2, PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY::DROP_OLDEST);
+	jobQueue.deactivate();
+
+	vector<size_t> executed;
+	vector<size_t> dropped;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		EXPECT_TRUE(jobQueue.addJob([&executed, i] { executed.push_back(i); }, [&dropped, i] { dropped.push_back(i); }));
+	}
+	jobQueue.activate();
+	jobQueue.deactivate();
+
+	EXPECT_EQ(vector<size_t>({ 1, 2 }), executed);
+	EXPECT_EQ(vector<size_t>({ 0 }), dropped);
+	const JobQueueMetrics metrics = jobQueue.getMetrics();
+	EXPECT_EQ(3, metrics.enqueuedJobs);
+	EXPECT_EQ(1, metrics.droppedJobs);
+	EXPECT_EQ(2, metrics.dequeuedJobs);
+}
+
+TEST(JobQueue_, bounded_block_waits_for_room)
+{
+	JobQueue jobQueue(2, PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY::BLOCK);
+	atomic<bool> release = false;
+	atomic<size_t> executed = 0;
+	jobQueue.addJob([&release] { release.wait(false); });
+
+	atomic<bool> producerDone = false;
+	thread producer(
+	[&]
+	{
+		// The first jobs wait in the ring while the worker is busy, the last one until there is room.
+		for (size_t i = 0; i < 3; ++i)
+		{
+			jobQueue.addJob([&executed] { ++executed; });
+		}
+		producerDone = true;
+	});
+	this_thread::sleep_for(20ms);
+	EXPECT_FALSE(producerDone);
+	release = true;
+	release.notify_all();
+	producer.join();
+	jobQueue.deactivate();
+	EXPECT_EQ(3, executed);
+	EXPECT_EQ(2, jobQueue.getMetrics().highWaterMark);
+}
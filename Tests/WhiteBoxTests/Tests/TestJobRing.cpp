@@ -0,0 +1,110 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/JobQueue/JobRing.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace ptne;
+using namespace std;
+
+TEST(JobRing_, capacity_is_rounded_up_to_a_power_of_two)
+{
+	EXPECT_THROW(JobRing(0), PTN_Exception);
+	EXPECT_EQ(2, JobRing(1).getCapacity());
+	EXPECT_EQ(8, JobRing(5).getCapacity());
+}
+
+TEST(JobRing_, pop_returns_the_jobs_in_the_order_they_were_pushed)
+{
+	JobRing jobRing(4);
+	size_t executed = 0;
+	QueuedJob job;
+	EXPECT_TRUE(jobRing.empty());
+	EXPECT_FALSE(jobRing.pop(job));
+
+	// Going around the ring several times.
+	for (size_t lap = 0; lap < 3; ++lap)
+	{
+		for (size_t i = 0; i < 4; ++i)
+		{
+			job.function = [&executed, i] { executed = i; };
+			ASSERT_TRUE(jobRing.push(job));
+			EXPECT_FALSE(job.function);
+		}
+		job.function = [] {};
+		EXPECT_FALSE(jobRing.push(job));
+		// A rejected job is not moved from.
+		EXPECT_TRUE(job.function);
+		for (size_t i = 0; i < 4; ++i)
+		{
+			ASSERT_TRUE(jobRing.pop(job));
+			job.function();
+			EXPECT_EQ(i, executed);
+		}
+		EXPECT_TRUE(jobRing.empty());
+	}
+}
+
+TEST(JobRing_, concurrent_producers_and_consumers_lose_no_job)
+{
+	constexpr size_t numberOfThreads = 2;
+	constexpr size_t jobsPerProducer = 10000;
+	JobRing jobRing(16);
+	atomic<size_t> executed = 0;
+	{
+		vector<jthread> threads;
+		for (size_t i = 0; i < numberOfThreads; ++i)
+		{
+			threads.emplace_back(
+			[&jobRing, &executed]
+			{
+				for (size_t j = 0; j < jobsPerProducer; ++j)
+				{
+					QueuedJob job{ .function = [&executed] { ++executed; } };
+					while (!jobRing.push(job))
+					{
+						this_thread::yield();
+					}
+				}
+			});
+			threads.emplace_back(
+			[&jobRing, &executed]
+			{
+				QueuedJob job;
+				for (size_t j = 0; j < jobsPerProducer;)
+				{
+					if (jobRing.pop(job))
+					{
+						job.function();
+						++j;
+					}
+					else
+					{
+						this_thread::yield();
+					}
+				}
+			});
+		}
+	}
+	EXPECT_EQ(numberOfThreads * jobsPerProducer, executed);
+	EXPECT_TRUE(jobRing.empty());
+}
@@ -16,9 +16,12 @@
  * limitations under the License.
  */
 
+#include "PTN_Engine/IActionsExecutor.h"
 #include "PTN_Engine/PTN_Engine.h"
 #include "PTN_Engine/PTN_Exception.h"
 #include "PTN_Engine/Transition.h"
+#include <algorithm>
+#include <future>
 #include <gtest/gtest.h>
 
 using namespace std;
@@ -42,6 +45,7 @@ TEST(PTN_Engine_, constructors_do_not_throw)
 	ASSERT_NO_THROW(PTN_Engine{ PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE });
 	ASSERT_NO_THROW(PTN_Engine{ PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD });
 	ASSERT_NO_THROW(PTN_Engine{ PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP });
+	ASSERT_NO_THROW(PTN_Engine{ PTN_Engine::ACTIONS_THREAD_OPTION::THREAD_POOL });
 }
 
 TEST(PTN_Engine_, getActionsThreadOption_returns_the_actions_thread_option)
@@ -54,6 +58,8 @@ TEST(PTN_Engine_, getActionsThreadOption_returns_the_actions_thread_option)
 	EXPECT_EQ(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD, ptnEngineSingleThread.getActionsThreadOption());
 	PTN_Engine ptnEngineEventLoop(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
 	EXPECT_EQ(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP, ptnEngineEventLoop.getActionsThreadOption());
+	PTN_Engine ptnEngineThreadPool(PTN_Engine::ACTIONS_THREAD_OPTION::THREAD_POOL);
+	EXPECT_EQ(PTN_Engine::ACTIONS_THREAD_OPTION::THREAD_POOL, ptnEngineThreadPool.getActionsThreadOption());
 
 	// TO DO test invoking while in execution
 }
@@ -408,6 +414,7 @@ TEST_F(PTN_Engine_JobQueue, setActionsThreadOption_sets_the_runtime_mode_in_the_
 {
 	ASSERT_NO_THROW(ptnEngine.setActionsThreadOption(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD));
 	ASSERT_NO_THROW(ptnEngine.setActionsThreadOption(PTN_Engine::ACTIONS_THREAD_OPTION::DETACHED));
+	ASSERT_NO_THROW(ptnEngine.setActionsThreadOption(PTN_Engine::ACTIONS_THREAD_OPTION::THREAD_POOL));
 	ASSERT_NO_THROW(ptnEngine.setActionsThreadOption(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP));
 	ptnEngine.execute();
 	ASSERT_THROW(ptnEngine.setActionsThreadOption(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD),
@@ -425,3 +432,1011 @@ TEST_F(PTN_Engine_JobQueue, stops_the_petri_net_execution_and_never_throws)
 	ASSERT_NO_THROW(ptnEngine.stop());
 	ASSERT_NO_THROW(ptnEngine.stop());
 }
+
+TEST(PTN_Engine_, freeze_prevents_structural_changes_until_thaw)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1" });
+
+	EXPECT_FALSE(ptnEngine.isFrozen());
+	ptnEngine.freeze();
+	EXPECT_TRUE(ptnEngine.isFrozen());
+
+	EXPECT_THROW(ptnEngine.createPlace(PlaceProperties{ .name = "P2" }), PTN_Exception);
+	EXPECT_THROW(ptnEngine.createTransition(TransitionProperties{ .name = "T2" }), PTN_Exception);
+	EXPECT_THROW(ptnEngine.addArc(ArcProperties{ .placeName = "P1", .transitionName = "T1" }), PTN_Exception);
+	EXPECT_THROW(ptnEngine.removeArc(ArcProperties{ .placeName = "P1", .transitionName = "T1" }), PTN_Exception);
+	EXPECT_THROW(ptnEngine.clearNet(), PTN_Exception);
+
+	ptnEngine.thaw();
+	EXPECT_FALSE(ptnEngine.isFrozen());
+	EXPECT_NO_THROW(ptnEngine.addArc(ArcProperties{ .placeName = "P1", .transitionName = "T1" }));
+}
+
+TEST(PTN_Engine_, batch_actions_are_called_once_with_the_number_of_tokens)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.setMultiFiring(true);
+
+	vector<size_t> entered;
+	vector<size_t> left;
+	ptnEngine.registerBatchAction("Process", [&entered](const size_t tokens) { entered.push_back(tokens); });
+	EXPECT_THROW(ptnEngine.registerAction("Process", [] {}), RepeatedFunctionException);
+	EXPECT_THROW(ptnEngine.registerBatchAction("Process", [](size_t) {}), RepeatedFunctionException);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2",
+										   .onEnterActionFunctionName = "Process",
+										   .onExitBatchAction = [&left](const size_t tokens)
+										   { left.push_back(tokens); } });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(
+	TransitionProperties{ .name = "T1",
+						  .activationArcs = { ArcProperties{ .placeName = "P1" } },
+						  .destinationArcs = { ArcProperties{ .weight = 3, .placeName = "P2" } } });
+	ptnEngine.createTransition(
+	TransitionProperties{ .name = "T2",
+						  .activationArcs = { ArcProperties{ .weight = 10, .placeName = "P2" } },
+						  .destinationArcs = { ArcProperties{ .placeName = "P3" } },
+						  .inhibitorArcs = { ArcProperties{ .placeName = "P1" } } });
+
+	// T1 fires 10 times at once, then T2 3 times at once.
+	ptnEngine.incrementInputPlace("P1", 10);
+	ptnEngine.execute();
+	EXPECT_EQ(3, ptnEngine.getNumberOfTokens("P3"));
+	EXPECT_EQ((vector<size_t>{ 30 }), entered);
+	EXPECT_EQ((vector<size_t>{ 30 }), left);
+
+	// Frozen nets pass the number of tokens along with the deferred actions.
+	ptnEngine.freeze();
+	ptnEngine.incrementInputPlace("P1", 4);
+	ptnEngine.execute();
+	EXPECT_EQ(4, ptnEngine.getNumberOfTokens("P3"));
+	EXPECT_EQ((vector<size_t>{ 30, 12 }), entered);
+	EXPECT_EQ((vector<size_t>{ 30, 10 }), left);
+	ptnEngine.thaw();
+}
+
+TEST(PTN_Engine_, execute_fires_transitions_while_frozen)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	size_t onEnterCounter = 0;
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2", .onEnterAction = [&onEnterCounter] { ++onEnterCounter; } });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .weight = 2, .placeName = "P2" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P3" } },
+													 .inhibitorArcs = { ArcProperties{ .placeName = "P1" } } });
+
+	ptnEngine.freeze();
+	ptnEngine.incrementInputPlace("P1");
+	ptnEngine.incrementInputPlace("P1");
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens("P1"));
+	EXPECT_THROW(ptnEngine.incrementInputPlace("P2"), NotInputPlaceException);
+	EXPECT_THROW(ptnEngine.getNumberOfTokens("P4"), InvalidNameException);
+
+	ptnEngine.execute();
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P1"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P2"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P3"));
+	EXPECT_EQ(2, onEnterCounter);
+
+	ptnEngine.thaw();
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("P3"));
+	for (const auto &placeProperties : ptnEngine.getPlacesProperties())
+	{
+		EXPECT_EQ(placeProperties.name == "P3" ? 1 : 0, placeProperties.initialNumberOfTokens);
+	}
+}
+
+TEST(PTN_Engine_, priority_policy_fires_the_transition_with_highest_priority)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD,
+						 PTN_Engine::CONFLICT_RESOLUTION_POLICY::PRIORITY);
+	EXPECT_EQ(PTN_Engine::CONFLICT_RESOLUTION_POLICY::PRIORITY, ptnEngine.getConflictResolutionPolicy());
+
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .priority = 1 });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P3" } },
+													 .priority = 2 });
+	EXPECT_EQ(2, ptnEngine.getTransitionsProperties().size());
+
+	for (int i = 0; i < 10; ++i)
+	{
+		ptnEngine.incrementInputPlace("P1");
+		ptnEngine.execute();
+	}
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P2"));
+	EXPECT_EQ(10, ptnEngine.getNumberOfTokens("P3"));
+}
+
+TEST(PTN_Engine_, round_robin_policy_alternates_conflicting_transitions)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD,
+						 PTN_Engine::CONFLICT_RESOLUTION_POLICY::ROUND_ROBIN);
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P3" } } });
+	ptnEngine.freeze();
+	for (int i = 0; i < 10; ++i)
+	{
+		ptnEngine.incrementInputPlace("P1");
+		ptnEngine.execute();
+	}
+	EXPECT_EQ(5, ptnEngine.getNumberOfTokens("P2"));
+	EXPECT_EQ(5, ptnEngine.getNumberOfTokens("P3"));
+}
+
+TEST(PTN_Engine_, multi_firing_fires_transitions_by_their_enabling_degree)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	EXPECT_FALSE(ptnEngine.isMultiFiring());
+	ptnEngine.setMultiFiring(true);
+	EXPECT_TRUE(ptnEngine.isMultiFiring());
+
+	size_t onEnterCounter = 0;
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2", .onEnterAction = [&onEnterCounter] { ++onEnterCounter; } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+	for (int i = 0; i < 100; ++i)
+	{
+		ptnEngine.incrementInputPlace("P1");
+	}
+	ptnEngine.execute();
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P1"));
+	EXPECT_EQ(100, ptnEngine.getNumberOfTokens("P2"));
+	EXPECT_EQ(100, onEnterCounter);
+}
+
+TEST(PTN_Engine_, maximal_step_firing_makes_produced_tokens_available_in_the_next_step)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	EXPECT_FALSE(ptnEngine.isMaximalStepFiring());
+	ptnEngine.setMaximalStepFiring(true);
+	ptnEngine.setMultiFiring(true);
+	EXPECT_TRUE(ptnEngine.isMaximalStepFiring());
+
+	size_t t2Steps = 0;
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P2", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P3" } },
+													 .additionalConditions = { [&t2Steps]
+																			   {
+																				   ++t2Steps;
+																				   return true;
+																			   } } });
+	ptnEngine.incrementInputPlace("P1");
+	ptnEngine.incrementInputPlace("P1");
+	ptnEngine.execute();
+
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P1"));
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P2"));
+	EXPECT_EQ(3, ptnEngine.getNumberOfTokens("P3"));
+	// T2 fired the initial token in the first step, and the 2 tokens from T1 in the second.
+	EXPECT_EQ(2, t2Steps);
+}
+
+TEST(PTN_Engine_, maximal_step_firing_checks_the_marking_of_conflicting_transitions_again)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.setMaximalStepFiring(true);
+	ptnEngine.createPlace(PlaceProperties{ .name = "Shared", .initialNumberOfTokens = 1 });
+	ptnEngine.createPlace(PlaceProperties{ .name = "Own", .initialNumberOfTokens = 1 });
+	for (const string name : { "A", "B", "C" })
+	{
+		ptnEngine.createPlace(PlaceProperties{ .name = "Out" + name });
+	}
+	// A and B compete for the token of Shared, C is the only consumer of Own.
+	for (const auto &[transition, place] : { pair{ "A", "Shared" }, pair{ "B", "Shared" }, pair{ "C", "Own" } })
+	{
+		ptnEngine.createTransition(
+		TransitionProperties{ .name = string("T") + transition,
+							  .activationArcs = { ArcProperties{ .placeName = place } },
+							  .destinationArcs = { ArcProperties{ .placeName = string("Out") + transition } } });
+	}
+	ptnEngine.execute();
+
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("Shared"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("OutA") + ptnEngine.getNumberOfTokens("OutB"));
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens("OutC"));
+}
+
+TEST(PTN_Engine_, frozen_net_fires_independent_regions_on_several_threads)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	EXPECT_EQ(1, ptnEngine.getNumberOfFiringThreads());
+	EXPECT_THROW(ptnEngine.setNumberOfFiringThreads(0), PTN_Exception);
+	ptnEngine.setNumberOfFiringThreads(3);
+	EXPECT_EQ(3, ptnEngine.getNumberOfFiringThreads());
+
+	ptnEngine.createPlace(PlaceProperties{ .name = "Sink" });
+	for (const string line : { "A", "B", "C", "D" })
+	{
+		ptnEngine.createPlace(PlaceProperties{ .name = "In" + line, .input = true });
+		ptnEngine.createPlace(PlaceProperties{ .name = "Out" + line });
+		ptnEngine.createTransition(
+		TransitionProperties{ .name = "T" + line,
+							  .activationArcs = { ArcProperties{ .placeName = "In" + line } },
+							  .destinationArcs = { ArcProperties{ .placeName = "Out" + line },
+												   ArcProperties{ .placeName = "Sink" } } });
+		for (int i = 0; i < 10; ++i)
+		{
+			ptnEngine.incrementInputPlace("In" + line);
+		}
+	}
+
+	ptnEngine.freeze();
+	ptnEngine.execute();
+	EXPECT_EQ(40, ptnEngine.getNumberOfTokens("Sink"));
+	EXPECT_EQ(10, ptnEngine.getNumberOfTokens("OutA"));
+	EXPECT_EQ(10, ptnEngine.getNumberOfTokens("OutD"));
+
+	ptnEngine.setNumberOfFiringThreads(1);
+	ptnEngine.incrementInputPlace("InB");
+	ptnEngine.execute();
+	EXPECT_EQ(41, ptnEngine.getNumberOfTokens("Sink"));
+	ptnEngine.thaw();
+	EXPECT_EQ(41, ptnEngine.getNumberOfTokens("Sink"));
+}
+
+TEST(PTN_Engine_, handles_identify_places_and_transitions)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	const PlaceHandle p1 = ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	const PlaceHandle p2 = ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	const TransitionHandle t1 = ptnEngine.createTransition(TransitionProperties{ .name = "T1" });
+	EXPECT_EQ(p2, ptnEngine.getPlaceHandle("P2"));
+	EXPECT_EQ(t1, ptnEngine.getTransitionHandle("T1"));
+	EXPECT_THROW(ptnEngine.getPlaceHandle("P3"), InvalidNameException);
+	EXPECT_THROW(ptnEngine.getTransitionHandle("T2"), InvalidNameException);
+
+	ptnEngine.addArc(p1, t1);
+	ptnEngine.addArc(p2, t1, ArcProperties::Type::DESTINATION, 2);
+	EXPECT_THROW(ptnEngine.addArc(p1, t1), PTN_Exception);
+	EXPECT_THROW(ptnEngine.addArc(PlaceHandle{ .index = 5 }, t1), InvalidHandleException);
+	EXPECT_THROW(ptnEngine.addArc(p1, TransitionHandle{ .index = 5 }), InvalidHandleException);
+
+	ptnEngine.incrementInputPlace(p1);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens(p1));
+	EXPECT_THROW(ptnEngine.incrementInputPlace(p2), NotInputPlaceException);
+	ptnEngine.execute();
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens(p1));
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens(p2));
+
+	// The handles are the same while frozen.
+	ptnEngine.freeze();
+	ptnEngine.incrementInputPlace(p1);
+	ptnEngine.execute();
+	EXPECT_EQ(4, ptnEngine.getNumberOfTokens(p2));
+	EXPECT_THROW(ptnEngine.getNumberOfTokens(PlaceHandle{}), InvalidHandleException);
+	ptnEngine.thaw();
+
+	ptnEngine.removeArc(p2, t1, ArcProperties::Type::DESTINATION);
+	ptnEngine.incrementInputPlace(p1);
+	ptnEngine.execute();
+	EXPECT_EQ(4, ptnEngine.getNumberOfTokens(p2));
+}
+
+TEST(PTN_Engine_, incrementInputPlace_adds_tokens_in_batches)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	size_t onEnterCalls = 0;
+	ptnEngine.registerAction("OnEnter", [&onEnterCalls] { ++onEnterCalls; });
+	const PlaceHandle p1 =
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .onEnterActionFunctionName = "OnEnter", .input = true });
+	const PlaceHandle p2 = ptnEngine.createPlace(PlaceProperties{ .name = "P2", .input = true });
+	const PlaceHandle p3 = ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+
+	ptnEngine.incrementInputPlace("P1", 3);
+	ptnEngine.incrementInputPlace(p2, 2);
+	EXPECT_EQ(3, ptnEngine.getNumberOfTokens(p1));
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens(p2));
+	EXPECT_EQ(3, onEnterCalls);
+
+	const vector<pair<string, size_t>> namedIncrements{ { "P1", 1 }, { "P2", 4 }, { "P1", 2 } };
+	ptnEngine.incrementInputPlace(namedIncrements);
+	EXPECT_EQ(6, ptnEngine.getNumberOfTokens(p1));
+	EXPECT_EQ(6, ptnEngine.getNumberOfTokens(p2));
+	EXPECT_EQ(6, onEnterCalls);
+
+	// Nothing is added if any of the increments is invalid.
+	vector<pair<PlaceHandle, size_t>> increments{ { p1, 1 }, { p3, 1 } };
+	EXPECT_THROW(ptnEngine.incrementInputPlace(increments), NotInputPlaceException);
+	EXPECT_THROW(ptnEngine.incrementInputPlace(vector<pair<string, size_t>>{ { "P1", 1 }, { "P4", 1 } }),
+				 InvalidNameException);
+	EXPECT_EQ(6, ptnEngine.getNumberOfTokens(p1));
+	EXPECT_EQ(6, onEnterCalls);
+
+	ptnEngine.freeze();
+	increments = { { p2, 1 }, { p1, 2 } };
+	ptnEngine.incrementInputPlace(increments);
+	ptnEngine.incrementInputPlace(p1, 2);
+	EXPECT_EQ(10, ptnEngine.getNumberOfTokens(p1));
+	EXPECT_EQ(7, ptnEngine.getNumberOfTokens(p2));
+	EXPECT_EQ(10, onEnterCalls);
+	increments = { { p1, 1 }, { p3, 1 } };
+	EXPECT_THROW(ptnEngine.incrementInputPlace(increments), NotInputPlaceException);
+	EXPECT_EQ(10, ptnEngine.getNumberOfTokens(p1));
+}
+
+TEST(PTN_Engine_, input_queue_adds_the_tokens_when_the_net_is_executed)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	const PlaceHandle p1 = ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	const PlaceHandle p2 = ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	EXPECT_EQ(0, ptnEngine.getInputQueueCapacity());
+	ptnEngine.setInputQueueCapacity(3);
+	EXPECT_EQ(4, ptnEngine.getInputQueueCapacity());
+
+	ptnEngine.incrementInputPlace(p1);
+	ptnEngine.incrementInputPlace("P1", 2);
+	EXPECT_THROW(ptnEngine.incrementInputPlace(p2), NotInputPlaceException);
+	EXPECT_THROW(ptnEngine.incrementInputPlace("P3"), InvalidNameException);
+	EXPECT_THROW(ptnEngine.incrementInputPlace(p1, 0), NullTokensException);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens(p1));
+
+	ptnEngine.execute();
+	EXPECT_EQ(3, ptnEngine.getNumberOfTokens(p1));
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		ptnEngine.incrementInputPlace(p1);
+	}
+	EXPECT_THROW(ptnEngine.incrementInputPlace(p1), InputQueueFullException);
+
+	// Disabling the queue adds the pending tokens.
+	ptnEngine.setInputQueueCapacity(0);
+	EXPECT_EQ(7, ptnEngine.getNumberOfTokens(p1));
+	ptnEngine.incrementInputPlace(p1);
+	EXPECT_EQ(8, ptnEngine.getNumberOfTokens(p1));
+}
+
+TEST(PTN_Engine_, input_queue_wakes_up_the_event_loop)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP);
+	ptnEngine.setEventLoopSleepDuration(2000ms);
+	ptnEngine.setInputQueueCapacity(16);
+	const PlaceHandle p1 = ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	const PlaceHandle p2 = ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	const TransitionHandle t1 = ptnEngine.createTransition(TransitionProperties{ .name = "T1" });
+	ptnEngine.addArc(p1, t1);
+	ptnEngine.addArc(p2, t1, ArcProperties::Type::DESTINATION);
+	ptnEngine.execute();
+	EXPECT_THROW(ptnEngine.setInputQueueCapacity(0), PTN_Exception);
+
+	// The loop is waiting with a long watchdog period, so only the notification can make it fire in time.
+	this_thread::sleep_for(50ms);
+	const auto start = chrono::steady_clock::now();
+	ptnEngine.incrementInputPlace(p1, 2);
+	while (ptnEngine.getNumberOfTokens(p2) < 2 && chrono::steady_clock::now() - start < 5s)
+	{
+		this_thread::sleep_for(1ms);
+	}
+	EXPECT_LT(chrono::steady_clock::now() - start, 1s);
+	ptnEngine.stop();
+	EXPECT_EQ(2, ptnEngine.getNumberOfTokens(p2));
+}
+
+TEST(PTN_Engine_, input_queue_capacity_changes_do_not_lose_increments)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	const PlaceHandle p1 = ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	ptnEngine.setInputQueueCapacity(16);
+
+	atomic<bool> stop = false;
+	atomic<size_t> increments = 0;
+	vector<thread> producers;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		producers.emplace_back(
+		[&]
+		{
+			while (!stop)
+			{
+				try
+				{
+					ptnEngine.incrementInputPlace(p1);
+					++increments;
+				}
+				catch (const InputQueueFullException &)
+				{
+					this_thread::yield();
+				}
+			}
+		});
+	}
+	for (size_t i = 0; i < 300; ++i)
+	{
+		ptnEngine.setInputQueueCapacity(i % 3 == 0 ? 0 : 4 << (i % 3));
+		ptnEngine.execute();
+	}
+	stop = true;
+	for (auto &producer : producers)
+	{
+		producer.join();
+	}
+
+	ptnEngine.setInputQueueCapacity(0);
+	EXPECT_EQ(increments.load(), ptnEngine.getNumberOfTokens(p1));
+}
+
+TEST(PTN_Engine_, clear_net_discards_the_increments_racing_with_it)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	ptnEngine.setInputQueueCapacity(64);
+
+	atomic<bool> stop = false;
+	thread producer(
+	[&]
+	{
+		while (!stop)
+		{
+			try
+			{
+				ptnEngine.incrementInputPlace("P1");
+			}
+			catch (const PTN_Exception &)
+			{
+				this_thread::yield();
+			}
+		}
+	});
+	for (size_t i = 0; i < 300; ++i)
+	{
+		ptnEngine.clearNet();
+		// P1 swaps index with P0 in every net, so a stale increment of the previous net would reach P0.
+		PlaceHandle p0;
+		if (i % 2 == 0)
+		{
+			ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+			p0 = ptnEngine.createPlace(PlaceProperties{ .name = "P0", .input = true });
+		}
+		else
+		{
+			p0 = ptnEngine.createPlace(PlaceProperties{ .name = "P0", .input = true });
+			ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+		}
+		ptnEngine.execute();
+		EXPECT_EQ(0, ptnEngine.getNumberOfTokens(p0));
+	}
+	stop = true;
+	producer.join();
+}
+
+TEST(PTN_Engine_, finished_actions_and_changed_conditions_wake_up_the_event_loop)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE);
+	ptnEngine.setEventLoopWatchdogEnabled(false);
+	EXPECT_FALSE(ptnEngine.isEventLoopWatchdogEnabled());
+	ptnEngine.setEventLoopSpinDuration(50us);
+	EXPECT_EQ(50us, ptnEngine.getEventLoopSpinDuration());
+
+	atomic<bool> finishAction = false;
+	atomic<bool> condition = false;
+	ptnEngine.registerAction("Wait", [&finishAction] { finishAction.wait(false); });
+	ptnEngine.registerCondition("Condition", [&condition] { return condition.load(); });
+	const PlaceHandle p1 =
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .onEnterActionFunctionName = "Wait", .input = true });
+	const PlaceHandle p2 = ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	const PlaceHandle p3 = ptnEngine.createPlace(PlaceProperties{ .name = "P3" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .requireNoActionsInExecution = true });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T2",
+													 .activationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P3" } },
+													 .additionalConditionsNames = { "Condition" } });
+	ptnEngine.execute();
+
+	auto waitForToken = [&ptnEngine](const PlaceHandle place)
+	{
+		const auto deadline = chrono::steady_clock::now() + 2s;
+		while (ptnEngine.getNumberOfTokens(place) == 0 && chrono::steady_clock::now() < deadline)
+		{
+			this_thread::sleep_for(100us);
+		}
+		return ptnEngine.getNumberOfTokens(place) == 1;
+	};
+
+	// T1 waits for the action of P1 to finish, without watchdog only its completion wakes up the loop.
+	ptnEngine.incrementInputPlace(p1);
+	this_thread::sleep_for(20ms);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens(p1));
+	finishAction = true;
+	finishAction.notify_all();
+	EXPECT_TRUE(waitForToken(p2));
+
+	this_thread::sleep_for(20ms);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens(p3));
+	condition = true;
+	ptnEngine.notifyConditionsChanged();
+	EXPECT_TRUE(waitForToken(p3));
+	ptnEngine.stop();
+}
+
+TEST(PTN_Engine_, busy_polling_event_loop_and_pinned_threads_run_the_net)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE);
+	EXPECT_FALSE(ptnEngine.isEventLoopBusyPolling());
+	ptnEngine.setEventLoopBusyPolling(true);
+	EXPECT_TRUE(ptnEngine.isEventLoopBusyPolling());
+#if defined(__linux__)
+	const ThreadScheduling threadScheduling{ .cpu = 0 };
+	ptnEngine.setEventLoopThreadScheduling(threadScheduling);
+	ptnEngine.setJobQueueThreadScheduling(threadScheduling);
+	EXPECT_EQ(threadScheduling, ptnEngine.getEventLoopThreadScheduling());
+	EXPECT_EQ(threadScheduling, ptnEngine.getJobQueueThreadScheduling());
+	EXPECT_THROW(ptnEngine.setJobQueueThreadScheduling(ThreadScheduling{ .fifoPriority = 1000 }), PTN_Exception);
+	EXPECT_EQ(threadScheduling, ptnEngine.getJobQueueThreadScheduling());
+#endif
+
+	atomic<size_t> actions = 0;
+	ptnEngine.registerAction("Count", [&actions] { ++actions; });
+	const PlaceHandle p1 = ptnEngine.createPlace(PlaceProperties{ .name = "P1", .input = true });
+	const PlaceHandle p2 = ptnEngine.createPlace(PlaceProperties{ .name = "P2", .onEnterActionFunctionName = "Count" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } } });
+	ptnEngine.execute();
+	ptnEngine.incrementInputPlace(p1, 3);
+	const auto deadline = chrono::steady_clock::now() + 2s;
+	while (actions < 3 && chrono::steady_clock::now() < deadline)
+	{
+		this_thread::sleep_for(100us);
+	}
+	ptnEngine.stop();
+	EXPECT_EQ(3, actions);
+	EXPECT_EQ(3, ptnEngine.getNumberOfTokens(p2));
+}
+
+TEST(PTN_Engine_, thread_pool_runs_the_actions_and_keeps_track_of_them)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::THREAD_POOL);
+	EXPECT_LE(1, ptnEngine.getNumberOfActionThreads());
+	EXPECT_THROW(ptnEngine.setNumberOfActionThreads(0), PTN_Exception);
+	ptnEngine.setNumberOfActionThreads(3);
+	EXPECT_EQ(3, ptnEngine.getNumberOfActionThreads());
+
+	constexpr size_t tokens = 100;
+	atomic<size_t> actions = 0;
+	ptnEngine.registerAction("Count", [&actions] { ++actions; });
+	const PlaceHandle p1 =
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .onEnterActionFunctionName = "Count", .input = true });
+	const PlaceHandle p2 = ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	// Only fires once the actions of P1 finished.
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .weight = tokens, .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .requireNoActionsInExecution = true });
+	ptnEngine.execute();
+	ptnEngine.incrementInputPlace(p1, tokens);
+	const auto deadline = chrono::steady_clock::now() + 2s;
+	while (ptnEngine.getNumberOfTokens(p2) == 0 && chrono::steady_clock::now() < deadline)
+	{
+		this_thread::sleep_for(100us);
+	}
+	EXPECT_THROW(ptnEngine.setNumberOfActionThreads(2), PTN_Exception);
+	ptnEngine.stop();
+	EXPECT_EQ(tokens, actions);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens(p2));
+}
+
+TEST(PTN_Engine_, bounded_job_queue_rejects_actions_and_reports_metrics)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE);
+	EXPECT_EQ(0, ptnEngine.getJobQueueCapacity());
+	ptnEngine.setJobQueueCapacity(3, PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY::FAIL_FAST);
+	EXPECT_EQ(4, ptnEngine.getJobQueueCapacity());
+	EXPECT_EQ(PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY::FAIL_FAST, ptnEngine.getJobQueueOverflowPolicy());
+
+	atomic<bool> release = false;
+	atomic<size_t> actions = 0;
+	ptnEngine.registerAction("Wait",
+							 [&]
+							 {
+								 release.wait(false);
+								 ++actions;
+							 });
+	const PlaceHandle p1 =
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .onEnterActionFunctionName = "Wait", .input = true });
+	const PlaceHandle p2 = ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .requireNoActionsInExecution = true });
+	ptnEngine.execute();
+	EXPECT_THROW(ptnEngine.setJobQueueCapacity(0), PTN_Exception);
+
+	// At most one action runs and four are queued, the rest is rejected.
+	ptnEngine.incrementInputPlace(p1, 10);
+	const auto deadline = chrono::steady_clock::now() + 2s;
+	while (ptnEngine.getJobQueueMetrics().enqueuedJobs + ptnEngine.getJobQueueMetrics().rejectedJobs < 10 &&
+		   chrono::steady_clock::now() < deadline)
+	{
+		this_thread::sleep_for(100us);
+	}
+	release = true;
+	release.notify_all();
+	// Rejected actions do not keep T1 from firing.
+	while (ptnEngine.getNumberOfTokens(p2) < 10 && chrono::steady_clock::now() < deadline)
+	{
+		this_thread::sleep_for(100us);
+	}
+	ptnEngine.stop();
+
+	const JobQueueMetrics metrics = ptnEngine.getJobQueueMetrics();
+	EXPECT_EQ(10, ptnEngine.getNumberOfTokens(p2));
+	EXPECT_EQ(10, metrics.enqueuedJobs + metrics.rejectedJobs);
+	EXPECT_LE(5, metrics.rejectedJobs);
+	EXPECT_EQ(metrics.enqueuedJobs, actions);
+	EXPECT_EQ(metrics.enqueuedJobs, metrics.dequeuedJobs);
+	EXPECT_EQ(4, metrics.highWaterMark);
+}
+
+TEST(PTN_Engine_, engines_share_an_actions_executor_and_keep_their_own_accounting)
+{
+	EXPECT_THROW(PTN_Engine(shared_ptr<IActionsExecutor>()), PTN_Exception);
+	EXPECT_THROW(createActionsExecutor(PTN_Engine::ACTIONS_THREAD_OPTION::CUSTOM), PTN_Exception);
+
+	const shared_ptr<IActionsExecutor> threadPool =
+	createActionsExecutor(PTN_Engine::ACTIONS_THREAD_OPTION::THREAD_POOL, { .numberOfActionThreads = 2 });
+	constexpr size_t numberOfEngines = 3;
+	constexpr size_t tokens = 20;
+	array<atomic<size_t>, numberOfEngines> actions{};
+	vector<unique_ptr<PTN_Engine>> engines;
+	vector<PlaceHandle> outputPlaces;
+	for (size_t i = 0; i < numberOfEngines; ++i)
+	{
+		auto &ptnEngine = *engines.emplace_back(make_unique<PTN_Engine>(threadPool));
+		EXPECT_EQ(PTN_Engine::ACTIONS_THREAD_OPTION::CUSTOM, ptnEngine.getActionsThreadOption());
+		ptnEngine.registerAction("Count", [&counter = actions[i]] { ++counter; });
+		ptnEngine.createPlace(PlaceProperties{ .name = "P1", .onEnterActionFunctionName = "Count", .input = true });
+		outputPlaces.push_back(ptnEngine.createPlace(PlaceProperties{ .name = "P2" }));
+		// Only fires once the actions of this engine finished.
+		ptnEngine.createTransition(TransitionProperties{
+		.name = "T1",
+		.activationArcs = { ArcProperties{ .weight = tokens, .placeName = "P1" } },
+		.destinationArcs = { ArcProperties{ .placeName = "P2" } },
+		.requireNoActionsInExecution = true });
+		ptnEngine.execute();
+	}
+	for (auto &ptnEngine : engines)
+	{
+		ptnEngine->incrementInputPlace("P1", tokens);
+	}
+	const auto deadline = chrono::steady_clock::now() + 2s;
+	for (size_t i = 0; i < numberOfEngines; ++i)
+	{
+		while (engines[i]->getNumberOfTokens(outputPlaces[i]) == 0 && chrono::steady_clock::now() < deadline)
+		{
+			this_thread::sleep_for(100us);
+		}
+		EXPECT_EQ(tokens, actions[i]);
+		EXPECT_EQ(1, engines[i]->getNumberOfTokens(outputPlaces[i]));
+	}
+	EXPECT_THROW(engines[0]->setActionsThreadOption(PTN_Engine::ACTIONS_THREAD_OPTION::CUSTOM), PTN_Exception);
+	engines.clear();
+}
+
+TEST(PTN_Engine_, adaptive_executor_runs_cheap_actions_inline)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::ADAPTIVE);
+	EXPECT_EQ(10us, ptnEngine.getInlineActionThreshold());
+	ptnEngine.setInlineActionThreshold(1ms);
+	EXPECT_EQ(1ms, ptnEngine.getInlineActionThreshold());
+
+	constexpr size_t tokens = 100;
+	atomic<size_t> actions = 0;
+	ptnEngine.registerAction("Count", [&actions] { ++actions; });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .onEnterActionFunctionName = "Count", .input = true });
+	const PlaceHandle p2 = ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .requireNoActionsInExecution = true });
+	ptnEngine.execute();
+	EXPECT_THROW(ptnEngine.setInlineActionThreshold(2ms), PTN_Exception);
+	const auto deadline = chrono::steady_clock::now() + 2s;
+	for (size_t i = 1; i <= tokens; ++i)
+	{
+		ptnEngine.incrementInputPlace("P1");
+		while (ptnEngine.getNumberOfTokens(p2) < i && chrono::steady_clock::now() < deadline)
+		{
+			this_thread::sleep_for(100us);
+		}
+	}
+	EXPECT_EQ(tokens, actions);
+	EXPECT_EQ(tokens, ptnEngine.getNumberOfTokens(p2));
+	// Only the first executions, before the action was known to be cheap, went through the job queue.
+	EXPECT_LT(ptnEngine.getJobQueueMetrics().dequeuedJobs, 20);
+	ptnEngine.stop();
+}
+
+TEST(PTN_Engine_, coalesced_actions_bound_the_work_of_bursts_of_tokens)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE);
+	atomic<bool> finishAction = false;
+	atomic<size_t> actions = 0;
+	ptnEngine.registerAction("Refresh",
+							 [&]
+							 {
+								 ++actions;
+								 finishAction.wait(false);
+							 });
+	const PlaceHandle view = ptnEngine.createPlace(PlaceProperties{
+	.name = "View", .onEnterActionFunctionName = "Refresh", .input = true, .coalesceActions = true });
+	EXPECT_THROW(ptnEngine.getNumberOfCoalescedActions("P1"), PTN_Exception);
+
+	constexpr size_t tokens = 50;
+	for (size_t i = 0; i < tokens; ++i)
+	{
+		ptnEngine.incrementInputPlace(view);
+	}
+	finishAction = true;
+	finishAction.notify_all();
+	const auto deadline = chrono::steady_clock::now() + 2s;
+	while (actions + ptnEngine.getNumberOfCoalescedActions("View") < tokens && chrono::steady_clock::now() < deadline)
+	{
+		this_thread::sleep_for(100us);
+	}
+	EXPECT_LE(actions, 2);
+	EXPECT_EQ(tokens, actions + ptnEngine.getNumberOfCoalescedActions("View"));
+	EXPECT_EQ(tokens, ptnEngine.getNumberOfTokens(view));
+}
+
+TEST(PTN_Engine_, executor_lanes_keep_slow_actions_from_delaying_the_other_places)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE);
+	EXPECT_THROW(ptnEngine.registerExecutorLane("io", nullptr), PTN_Exception);
+	ptnEngine.registerExecutorLane("io", createActionsExecutor(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE));
+	EXPECT_THROW(
+	ptnEngine.registerExecutorLane("io", createActionsExecutor(PTN_Engine::ACTIONS_THREAD_OPTION::EVENT_LOOP)),
+	PTN_Exception);
+	EXPECT_THROW(ptnEngine.createPlace(PlaceProperties{ .name = "P0", .executorLane = "ui" }), PTN_Exception);
+
+	atomic<bool> finishSlowAction = false;
+	vector<size_t> laneActions;
+	mutex laneActionsMutex;
+	ptnEngine.registerAction("Slow", [&finishSlowAction] { finishSlowAction.wait(false); });
+	ptnEngine.registerAction("Fast1", [&] { lock_guard guard(laneActionsMutex); laneActions.push_back(1); });
+	ptnEngine.registerAction("Fast2", [&] { lock_guard guard(laneActionsMutex); laneActions.push_back(2); });
+	const PlaceHandle slow =
+	ptnEngine.createPlace(PlaceProperties{ .name = "Slow", .onEnterActionFunctionName = "Slow", .input = true });
+	const PlaceHandle fast1 = ptnEngine.createPlace(
+	PlaceProperties{ .name = "Fast1", .onEnterActionFunctionName = "Fast1", .input = true, .executorLane = "io" });
+	const PlaceHandle fast2 = ptnEngine.createPlace(
+	PlaceProperties{ .name = "Fast2", .onEnterActionFunctionName = "Fast2", .input = true, .executorLane = "io" });
+	ptnEngine.execute();
+
+	ptnEngine.incrementInputPlace(slow);
+	ptnEngine.incrementInputPlace(fast1);
+	ptnEngine.incrementInputPlace(fast2);
+	const auto deadline = chrono::steady_clock::now() + 2s;
+	auto numberOfLaneActions = [&]
+	{
+		lock_guard guard(laneActionsMutex);
+		return laneActions.size();
+	};
+	while (numberOfLaneActions() < 2 && chrono::steady_clock::now() < deadline)
+	{
+		this_thread::sleep_for(100us);
+	}
+	// The actions of the lane ran in order, while the slow action still blocks the job queue of the engine.
+	EXPECT_EQ((vector<size_t>{ 1, 2 }), laneActions);
+
+	// The lane is kept when the actions executor of the engine changes.
+	finishSlowAction = true;
+	finishSlowAction.notify_all();
+	ptnEngine.stop();
+	ptnEngine.setActionsThreadOption(PTN_Engine::ACTIONS_THREAD_OPTION::THREAD_POOL);
+	ptnEngine.execute();
+	ptnEngine.incrementInputPlace(fast1);
+	while (numberOfLaneActions() < 3 && chrono::steady_clock::now() < deadline)
+	{
+		this_thread::sleep_for(100us);
+	}
+	EXPECT_EQ(3, numberOfLaneActions());
+	const auto placesProperties = ptnEngine.getPlacesProperties();
+	const auto fast1Properties =
+	ranges::find(placesProperties, "Fast1", [](const PlaceProperties &properties) { return properties.name; });
+	ASSERT_NE(placesProperties.end(), fast1Properties);
+	EXPECT_EQ("io", fast1Properties->executorLane);
+	ptnEngine.stop();
+}
+
+namespace
+{
+
+//!
+//! \brief Executor handing the actions over to a runtime of the application, here a queue run on request.
+//!
+class ManualExecutor : public IActionsExecutor
+{
+public:
+	void executeAction(ActionJob action,
+					   atomic<size_t> &counter,
+					   const shared_ptr<const ActionCompletedNotifier> &notifier) override
+	{
+		++counter;
+		lock_guard guard(m_mutex);
+		m_actions.push_back(QueuedAction{ .action = move(action), .counter = &counter, .notifier = notifier });
+	}
+
+	size_t runActions()
+	{
+		vector<QueuedAction> actions;
+		{
+			lock_guard guard(m_mutex);
+			actions.swap(m_actions);
+		}
+		for (auto &queuedAction : actions)
+		{
+			queuedAction.action();
+			--*queuedAction.counter;
+			queuedAction.counter->notify_all();
+			(*queuedAction.notifier)();
+		}
+		return actions.size();
+	}
+
+private:
+	struct QueuedAction
+	{
+		ActionJob action;
+		atomic<size_t> *counter;
+		shared_ptr<const ActionCompletedNotifier> notifier;
+	};
+
+	mutex m_mutex;
+	vector<QueuedAction> m_actions;
+};
+
+} // namespace
+
+TEST(PTN_Engine_, custom_executor_runs_the_actions_on_the_runtime_of_the_application)
+{
+	auto executor = make_shared<ManualExecutor>();
+	PTN_Engine ptnEngine(executor);
+	size_t actions = 0;
+	ptnEngine.registerAction("Count", [&actions] { ++actions; });
+	const PlaceHandle p1 =
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .onEnterActionFunctionName = "Count", .input = true });
+	const PlaceHandle p2 = ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .requireNoActionsInExecution = true });
+	ptnEngine.execute();
+	ptnEngine.incrementInputPlace(p1);
+	this_thread::sleep_for(10ms);
+	// Waits for the action queued in the runtime.
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens(p2));
+	EXPECT_EQ(1, executor->runActions());
+	EXPECT_EQ(1, actions);
+
+	// Woken up by the notifier.
+	const auto deadline = chrono::steady_clock::now() + 2s;
+	while (ptnEngine.getNumberOfTokens(p2) == 0 && chrono::steady_clock::now() < deadline)
+	{
+		this_thread::sleep_for(100us);
+	}
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens(p2));
+	ptnEngine.stop();
+}
+
+TEST(PTN_Engine_, an_action_clearing_its_own_net_does_not_wait_for_itself)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE);
+	promise<void> started;
+	promise<void> stopped;
+	promise<void> cleared;
+	ptnEngine.registerAction("Clear",
+							 [&ptnEngine, &started, stoppedFuture = stopped.get_future().share(), &cleared]
+							 {
+								 // This function is destroyed with its place, only locals are used afterwards.
+								 auto &engine = ptnEngine;
+								 auto &done = cleared;
+								 started.set_value();
+								 stoppedFuture.wait();
+								 engine.clearNet();
+								 done.set_value();
+							 });
+	const PlaceHandle p1 =
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .onEnterActionFunctionName = "Clear", .input = true });
+	ptnEngine.execute();
+	ptnEngine.incrementInputPlace(p1);
+	ASSERT_EQ(future_status::ready, started.get_future().wait_for(2s));
+	ptnEngine.stop();
+	stopped.set_value();
+	ASSERT_EQ(future_status::ready, cleared.get_future().wait_for(2s));
+	EXPECT_TRUE(ptnEngine.getPlacesProperties().empty());
+}
+
+TEST(PTN_Engine_, coroutine_actions_count_as_in_execution_until_they_complete)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::COROUTINE);
+	EXPECT_EQ(PTN_Engine::ACTIONS_THREAD_OPTION::COROUTINE, ptnEngine.getActionsThreadOption());
+	atomic<size_t> started = 0;
+	atomic<size_t> completed = 0;
+	ptnEngine.registerAsyncAction("Wait",
+								  [&started, &completed]() -> ActionTask
+								  {
+									  ++started;
+									  co_await sleepFor(20ms);
+									  ++completed;
+								  });
+	EXPECT_THROW(ptnEngine.registerAction("Wait", [] {}), RepeatedFunctionException);
+	ptnEngine.registerAction("Plain", [] {});
+	EXPECT_THROW(ptnEngine.registerAsyncAction("Plain", []() -> ActionTask { co_return; }), RepeatedFunctionException);
+
+	const PlaceHandle p1 =
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .onEnterActionFunctionName = "Wait", .input = true });
+	const PlaceHandle p2 = ptnEngine.createPlace(PlaceProperties{ .name = "P2" });
+	ptnEngine.createTransition(TransitionProperties{ .name = "T1",
+													 .activationArcs = { ArcProperties{ .placeName = "P1" } },
+													 .destinationArcs = { ArcProperties{ .placeName = "P2" } },
+													 .requireNoActionsInExecution = true });
+	const auto placesProperties = ptnEngine.getPlacesProperties();
+	const auto p1Properties =
+	ranges::find(placesProperties, string("P1"), [](const PlaceProperties &properties) { return properties.name; });
+	ASSERT_NE(placesProperties.end(), p1Properties);
+	EXPECT_EQ("Wait", p1Properties->onEnterActionFunctionName);
+	EXPECT_NE(nullptr, p1Properties->onEnterAsyncAction);
+	ptnEngine.execute();
+	ptnEngine.incrementInputPlace(p1);
+	this_thread::sleep_for(5ms);
+	// Suspended, but still in execution.
+	EXPECT_EQ(1, started);
+	EXPECT_EQ(0, ptnEngine.getNumberOfTokens(p2));
+
+	const auto deadline = chrono::steady_clock::now() + 2s;
+	while (ptnEngine.getNumberOfTokens(p2) == 0 && chrono::steady_clock::now() < deadline)
+	{
+		this_thread::sleep_for(100us);
+	}
+	EXPECT_EQ(1, completed);
+	EXPECT_EQ(1, ptnEngine.getNumberOfTokens(p2));
+	ptnEngine.stop();
+}
+
+TEST(PTN_Engine_, coroutine_actions_run_to_completion_with_the_other_options)
+{
+	PTN_Engine ptnEngine(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	size_t completed = 0;
+	ptnEngine.registerAsyncAction("Wait",
+								  [&completed]() -> ActionTask
+								  {
+									  co_await sleepFor(1ms);
+									  ++completed;
+								  });
+	ptnEngine.createPlace(PlaceProperties{ .name = "P1", .onEnterActionFunctionName = "Wait", .input = true });
+	ptnEngine.incrementInputPlace("P1");
+	ptnEngine.execute();
+	EXPECT_EQ(1, completed);
+}
@@ -20,6 +20,7 @@
 #include "PTN_Engine/PTN_EngineImp.h"
 #include "PTN_Engine/Place.h"
 #include <gtest/gtest.h>
+#include <thread>
 
 
 using namespace ptne;
@@ -120,6 +121,37 @@ TEST_F(Place_ExecutorObj, blockStartingOnEnterActions_prevents_on_enter_action_f
 	EXPECT_FALSE(place.isOnEnterActionInExecution());
 }
 
+TEST_F(Place_ExecutorObj, on_enter_action_starts_when_all_blocks_are_released)
+{
+	atomic<bool> started = false;
+	chrono::steady_clock::time_point startTime;
+	auto onEnter = [&started, &startTime]()
+	{
+		startTime = chrono::steady_clock::now();
+		started = true;
+		started.notify_all();
+	};
+	Place place(PlaceProperties{ .onEnterAction = onEnter }, executor);
+	place.blockStartingOnEnterActions(true);
+	place.blockStartingOnEnterActions(true);
+	jthread t([&place]() { place.enterPlace(1); });
+
+	// Tokens enter the place while it is blocked, only the action waits.
+	while (place.getNumberOfTokens() == 0)
+	{
+		this_thread::yield();
+	}
+	place.blockStartingOnEnterActions(false);
+	this_thread::sleep_for(20ms);
+	EXPECT_FALSE(started);
+
+	const auto releaseTime = chrono::steady_clock::now();
+	place.blockStartingOnEnterActions(false);
+	started.wait(false);
+	// The waiting thread is woken up, instead of polling the blocks.
+	EXPECT_LT(startTime - releaseTime, 20ms);
+}
+
 TEST_F(Place_ExecutorObj, enter_place_increases_number_of_tokens)
 {
 	PlaceProperties placeProperties;
@@ -280,3 +312,118 @@ TEST_F(Place_ExecutorObj, setNumberOfTokens_returns_number_of_tokens)
 	place.setNumberOfTokens(-1);
 	EXPECT_EQ(ULLONG_MAX, place.getNumberOfTokens());
 }
+
+TEST(Place_, coalesced_actions_are_folded_into_the_queued_invocation)
+{
+	shared_ptr<IActionsExecutor> executor =
+	ActionsExecutorFactory::createExecutor(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE);
+	atomic<bool> started = false;
+	atomic<bool> finishAction = false;
+	atomic<size_t> actions = 0;
+	Place place(PlaceProperties{ .name = "View",
+								 .onEnterAction =
+								 [&]
+								 {
+									 ++actions;
+									 started = true;
+									 finishAction.wait(false);
+								 },
+								 .coalesceActions = true },
+				executor);
+	EXPECT_TRUE(place.placeProperties().coalesceActions);
+
+	// The running invocation is no longer pending, so the next one is queued and the others folded into it.
+	place.enterPlace();
+	while (!started)
+	{
+		this_thread::yield();
+	}
+	place.enterPlace();
+	place.enterPlace();
+	place.enterPlace(1, 3);
+	EXPECT_EQ(4, place.getNumberOfCoalescedActions());
+	EXPECT_EQ(4, place.getNumberOfTokens());
+
+	finishAction = true;
+	finishAction.notify_all();
+	while (place.hasActionsInExecution())
+	{
+		this_thread::yield();
+	}
+	EXPECT_EQ(2, actions);
+
+	place.enterPlace();
+	while (place.hasActionsInExecution())
+	{
+		this_thread::yield();
+	}
+	EXPECT_EQ(3, actions);
+	EXPECT_EQ(4, place.getNumberOfCoalescedActions());
+}
+
+TEST(Place_, coalesced_actions_discarded_by_the_executor_are_no_longer_pending)
+{
+	shared_ptr<IActionsExecutor> executor = ActionsExecutorFactory::createExecutor(
+	PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE,
+	ActionsExecutorOptions{ .jobQueueCapacity = 1,
+							.jobQueueOverflowPolicy = PTN_Engine::JOB_QUEUE_OVERFLOW_POLICY::FAIL_FAST });
+	atomic<bool> started = false;
+	atomic<bool> finishAction = false;
+	atomic<size_t> actions = 0;
+	Place blocking(PlaceProperties{ .name = "Blocking",
+									.onEnterAction =
+									[&]
+									{
+										started = true;
+										finishAction.wait(false);
+									} },
+				   executor);
+	Place view(PlaceProperties{ .name = "View", .onEnterAction = [&actions] { ++actions; }, .coalesceActions = true },
+			   executor);
+
+	// Fill the job queue, so that the invocation of the view is rejected.
+	blocking.enterPlace();
+	while (!started)
+	{
+		this_thread::yield();
+	}
+	blocking.enterPlace(1, 2);
+	view.enterPlace();
+	EXPECT_EQ(1, executor->getJobQueueMetrics().rejectedJobs);
+
+	finishAction = true;
+	finishAction.notify_all();
+	while (blocking.hasActionsInExecution())
+	{
+		this_thread::yield();
+	}
+	view.enterPlace();
+	while (view.hasActionsInExecution())
+	{
+		this_thread::yield();
+	}
+	EXPECT_EQ(1, actions);
+	EXPECT_EQ(0, view.getNumberOfCoalescedActions());
+}
+
+TEST_F(Place_ExecutorObj, batch_actions_are_called_once_with_the_number_of_tokens)
+{
+	vector<size_t> entered;
+	vector<size_t> left;
+	Place place(PlaceProperties{ .name = "P1",
+								 .onEnterBatchAction = [&entered](const size_t tokens) { entered.push_back(tokens); },
+								 .onExitBatchAction = [&left](const size_t tokens) { left.push_back(tokens); } },
+				executor);
+	EXPECT_TRUE(place.hasOnEnterAction());
+	EXPECT_TRUE(place.hasOnExitAction());
+	EXPECT_NE(nullptr, place.placeProperties().onEnterBatchAction);
+
+	place.enterPlace(5, 2);
+	place.exitPlace(3, 3);
+	place.executeOnEnterAction(4, 4);
+	EXPECT_EQ((vector<size_t>{ 5, 4 }), entered);
+	EXPECT_EQ((vector<size_t>{ 3 }), left);
+
+	EXPECT_THROW(Place(PlaceProperties{ .onEnterAction = [] {}, .onEnterBatchAction = [](size_t) {} }, executor),
+				 PTN_Exception);
+}
@@ -18,6 +18,7 @@
 
 #include "PTN_Engine/Executor/ActionsExecutorFactory.h"
 #include "PTN_Engine/PlacesManager.h"
+#include <climits>
 #include <gtest/gtest.h>
 
 using namespace ptne;
@@ -214,6 +215,49 @@ TEST_F(PlacesManager_Obj, incrementInputPlace_increments_the_input_places_token_
 	ASSERT_THROW(placesManager.incrementInputPlace("P3"), PTN_Exception);
 }
 
+TEST_F(PlacesManager_Obj, incrementInputPlace_adds_count_tokens)
+{
+	auto p1 = make_shared<Place>(PlaceProperties{ .name = "P1", .input = true }, executor);
+	placesManager.insert(p1);
+
+	placesManager.incrementInputPlace("P1", 5);
+	EXPECT_EQ(5, placesManager.getNumberOfTokens("P1"));
+	placesManager.incrementInputPlace(0, 3);
+	EXPECT_EQ(8, placesManager.getNumberOfTokens("P1"));
+	EXPECT_THROW(placesManager.incrementInputPlace(0, 0), NullTokensException);
+}
+
+TEST_F(PlacesManager_Obj, incrementInputPlaces_merges_the_increments_of_each_place)
+{
+	auto p1 = make_shared<Place>(PlaceProperties{ .name = "P1", .input = true }, executor);
+	auto p2 = make_shared<Place>(PlaceProperties{ .name = "P2", .input = true }, executor);
+	placesManager.insert(p1);
+	placesManager.insert(p2);
+
+	const vector<pair<PlaceHandle, size_t>> increments{ { { 1 }, 2 }, { { 0 }, 1 }, { { 1 }, 3 } };
+	EXPECT_EQ((vector<SharedPtrPlace>{ p2, p1 }), placesManager.incrementInputPlaces(increments));
+	EXPECT_EQ(1, placesManager.getNumberOfTokens("P1"));
+	EXPECT_EQ(5, placesManager.getNumberOfTokens("P2"));
+}
+
+TEST_F(PlacesManager_Obj, incrementInputPlaces_adds_no_tokens_if_an_increment_is_invalid)
+{
+	auto p1 = make_shared<Place>(PlaceProperties{ .name = "P1", .input = true }, executor);
+	auto p2 = make_shared<Place>(PlaceProperties{ .name = "P2" }, executor);
+	placesManager.insert(p1);
+	placesManager.insert(p2);
+
+	vector<pair<PlaceHandle, size_t>> increments{ { { 0 }, 2 }, { { 1 }, 1 } };
+	EXPECT_THROW(placesManager.incrementInputPlaces(increments), NotInputPlaceException);
+	increments = { { { 0 }, 2 }, { { 2 }, 1 } };
+	EXPECT_THROW(placesManager.incrementInputPlaces(increments), InvalidHandleException);
+	increments = { { { 0 }, 2 }, { { 0 }, 0 } };
+	EXPECT_THROW(placesManager.incrementInputPlaces(increments), NullTokensException);
+	increments = { { { 0 }, 2 }, { { 0 }, ULLONG_MAX } };
+	EXPECT_THROW(placesManager.incrementInputPlaces(increments), OverflowException);
+	EXPECT_EQ(0, placesManager.getNumberOfTokens("P1"));
+}
+
 TEST_F(PlacesManager_Obj, insert_inserts_a_new_place_in_the_collection)
 {
 	ASSERT_TRUE(placesManager.getPlacesProperties().empty());
@@ -228,3 +272,24 @@ TEST_F(PlacesManager_Obj, insert_inserts_a_new_place_in_the_collection)
 	auto p2 = make_shared<Place>(placeProperties, executor);
 	ASSERT_THROW(placesManager.insert(p2), PTN_Exception);
 }
+
+TEST_F(PlacesManager_Obj, insert_returns_the_index_used_to_access_the_place)
+{
+	auto p1 = make_shared<Place>(PlaceProperties{ .name = "P1" }, executor);
+	auto p2 = make_shared<Place>(PlaceProperties{ .name = "P2", .initialNumberOfTokens = 1, .input = true }, executor);
+	EXPECT_EQ(0, placesManager.insert(p1));
+	EXPECT_EQ(1, placesManager.insert(p2));
+	EXPECT_EQ(1, placesManager.getPlaceIndex("P2"));
+	EXPECT_THROW(placesManager.getPlaceIndex("P3"), InvalidNameException);
+	EXPECT_EQ(p1, placesManager.getPlace(0));
+	EXPECT_EQ((vector<SharedPtrPlace>{ p1, p2 }), placesManager.getAllPlaces());
+
+	EXPECT_EQ(p2, placesManager.incrementInputPlace(1));
+	EXPECT_EQ(2, placesManager.getNumberOfTokens(1));
+	EXPECT_THROW(placesManager.incrementInputPlace(0), NotInputPlaceException);
+	EXPECT_THROW(placesManager.incrementInputPlace(2), InvalidHandleException);
+	EXPECT_THROW(placesManager.getNumberOfTokens(2), InvalidHandleException);
+
+	placesManager.clear();
+	EXPECT_THROW(placesManager.getPlace(0), InvalidHandleException);
+}
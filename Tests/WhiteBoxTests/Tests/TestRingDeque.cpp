@@ -0,0 +1,64 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/Utilities/RingDeque.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace ptne::utility;
+using namespace std;
+
+TEST(RingDeque_, keeps_the_order_while_growing_around_the_end_of_the_storage)
+{
+	RingDeque<size_t> ringDeque;
+	size_t next = 0;
+	size_t expected = 0;
+	for (size_t round = 0; round < 3; ++round)
+	{
+		for (size_t i = 0; i < 20; ++i)
+		{
+			ringDeque.push_back(size_t(next++));
+		}
+		for (size_t i = 0; i < 15; ++i)
+		{
+			ASSERT_EQ(expected++, ringDeque.front());
+			ringDeque.pop_front();
+		}
+	}
+	EXPECT_EQ(15, ringDeque.size());
+	EXPECT_EQ(next - 1, ringDeque.back());
+	ringDeque.pop_back();
+	while (!ringDeque.empty())
+	{
+		EXPECT_EQ(expected++, ringDeque.front());
+		ringDeque.pop_front();
+	}
+	EXPECT_EQ(next - 1, expected);
+}
+
+TEST(RingDeque_, removed_items_are_released)
+{
+	RingDeque<shared_ptr<int>> ringDeque;
+	auto item = make_shared<int>(1);
+	ringDeque.push_back(shared_ptr<int>(item));
+	ringDeque.push_back(shared_ptr<int>(item));
+	EXPECT_EQ(3, item.use_count());
+	ringDeque.pop_front();
+	ringDeque.pop_back();
+	EXPECT_EQ(1, item.use_count());
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "PTN_Engine/Utilities/SequenceRing.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace ptne::utility;
+using namespace std;
+
+TEST(SequenceRing_, capacity_is_rounded_up_to_a_power_of_two_of_at_least_two)
+{
+	EXPECT_EQ(2, SequenceRing<int>(1).capacity());
+	EXPECT_EQ(2, SequenceRing<int>(2).capacity());
+	EXPECT_EQ(8, SequenceRing<int>(5).capacity());
+}
+
+TEST(SequenceRing_, both_pops_take_the_items_in_the_order_they_were_pushed)
+{
+	SequenceRing<int> ring(2);
+	int item = 0;
+	for (size_t lap = 0; lap < 3; ++lap)
+	{
+		EXPECT_TRUE(ring.empty());
+		ASSERT_TRUE(ring.push(1));
+		ASSERT_TRUE(ring.push(2));
+		EXPECT_FALSE(ring.push(3));
+		ASSERT_TRUE(ring.pop(item));
+		EXPECT_EQ(1, item);
+		ASSERT_TRUE(ring.popSingleConsumer(item));
+		EXPECT_EQ(2, item);
+		EXPECT_FALSE(ring.pop(item));
+		EXPECT_FALSE(ring.popSingleConsumer(item));
+	}
+}
+
+TEST(SequenceRing_, taken_cells_release_what_the_items_hold)
+{
+	SequenceRing<shared_ptr<int>> ring(2);
+	auto value = make_shared<int>(1);
+	auto rejected = make_shared<int>(2);
+	ASSERT_TRUE(ring.push(value));
+	ASSERT_TRUE(ring.push(value));
+	EXPECT_EQ(3, value.use_count());
+	// A rejected item is not moved from.
+	EXPECT_FALSE(ring.push(move(rejected)));
+	EXPECT_NE(nullptr, rejected);
+
+	shared_ptr<int> item;
+	ASSERT_TRUE(ring.pop(item));
+	ASSERT_TRUE(ring.popSingleConsumer(item));
+	item.reset();
+	EXPECT_EQ(1, value.use_count());
+}
@@ -0,0 +1,82 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/JobQueue/ThreadPool.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace ptne;
+using namespace std;
+
+TEST(ThreadPool_, constructor_throws_without_threads)
+{
+	EXPECT_THROW(ThreadPool{ 0 }, PTN_Exception);
+	ThreadPool threadPool(3);
+	EXPECT_EQ(3, threadPool.getNumberOfThreads());
+}
+
+TEST(ThreadPool_, destructor_executes_all_added_jobs)
+{
+	atomic<size_t> executed = 0;
+	{
+		ThreadPool threadPool(4);
+		for (size_t i = 0; i < 1000; ++i)
+		{
+			threadPool.addJob([&executed] { ++executed; });
+		}
+	}
+	EXPECT_EQ(1000, executed);
+}
+
+TEST(ThreadPool_, idle_threads_steal_jobs_queued_for_a_busy_thread)
+{
+	atomic<bool> release = false;
+	mutex threadsMutex;
+	set<thread::id> threads;
+	atomic<size_t> executed = 0;
+	{
+		ThreadPool threadPool(2);
+		// Blocks one thread, the jobs queued behind it are stolen by the other one.
+		threadPool.addJob([&release] { release.wait(false); });
+		for (size_t i = 0; i < 9; ++i)
+		{
+			threadPool.addJob(
+			[&]
+			{
+				{
+					lock_guard guard(threadsMutex);
+					threads.insert(this_thread::get_id());
+				}
+				++executed;
+				executed.notify_all();
+			});
+		}
+		for (size_t current = executed; current < 9; current = executed)
+		{
+			executed.wait(current);
+		}
+		release = true;
+		release.notify_all();
+	}
+	EXPECT_EQ(9, executed);
+	EXPECT_EQ(1, threads.size());
+}
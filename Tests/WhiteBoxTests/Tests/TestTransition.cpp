@@ -20,6 +20,7 @@
 #include "PTN_Engine/PTN_EngineImp.h"
 #include "PTN_Engine/Utilities/LockWeakPtr.h"
 #include <gtest/gtest.h>
+#include <limits>
 
 
 using namespace std;
@@ -799,3 +800,75 @@ TEST(Transition_, requireNoActionsInExecution_does_not_fire_if_onEnter_action_in
 	this_thread::sleep_for(100ms);
 	EXPECT_EQ(0, ptnEngine.getNumberOfTokens("P1"));
 }
+
+TEST(Transition_, requireNoActionsInExecution_does_not_delay_tokens_entering_the_activation_places)
+{
+	shared_ptr<IActionsExecutor> executor =
+	ActionsExecutorFactory::createExecutor(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	atomic<size_t> onEnterCounter = 0;
+	SharedPtrPlace p1 = make_shared<Place>(
+	PlaceProperties{ .name = "P1", .onEnterAction = [&onEnterCounter] { ++onEnterCounter; } }, executor);
+	SharedPtrPlace p2 = make_shared<Place>(PlaceProperties{ .name = "P2" }, executor);
+	Transition t("T1", { { p1, 1 } }, { { p2, 1 } }, {}, {}, true);
+
+	const size_t numberOfTokens = 2000;
+	atomic<bool> producing = true;
+	jthread firing(
+	[&t, &producing]
+	{
+		while (producing)
+		{
+			t.execute();
+		}
+		while (t.execute())
+			;
+	});
+
+	// Tokens keep entering while the transition blocks and releases the on enter actions of P1.
+	chrono::steady_clock::duration maxLatency{};
+	for (size_t i = 0; i < numberOfTokens; ++i)
+	{
+		const auto start = chrono::steady_clock::now();
+		p1->enterPlace();
+		maxLatency = max(maxLatency, chrono::steady_clock::now() - start);
+	}
+	producing = false;
+	firing.join();
+
+	EXPECT_EQ(numberOfTokens, onEnterCounter);
+	EXPECT_EQ(0, p1->getNumberOfTokens());
+	EXPECT_EQ(numberOfTokens, p2->getNumberOfTokens());
+	EXPECT_LT(maxLatency, 50ms);
+}
+
+/*
+ *  ___         ||         ___
+ * | 7 |___2___\||___3___\| 0 |
+ * |___|       /||       /|___|
+ *              ||
+ */
+TEST(Transition_, execute_with_max_firings_fires_by_the_enabling_degree)
+{
+	shared_ptr<IActionsExecutor> executor =
+	ActionsExecutorFactory::createExecutor(PTN_Engine::ACTIONS_THREAD_OPTION::SINGLE_THREAD);
+	size_t onExitCounter = 0;
+	size_t onEnterCounter = 0;
+	SharedPtrPlace p1 = make_shared<Place>(
+	PlaceProperties{ .name = "P1", .initialNumberOfTokens = 7, .onExitAction = [&onExitCounter] { ++onExitCounter; } },
+	executor);
+	SharedPtrPlace p2 = make_shared<Place>(
+	PlaceProperties{ .name = "P2", .onEnterAction = [&onEnterCounter] { ++onEnterCounter; } }, executor);
+
+	Transition t("T1", { { p1, 2 } }, { { p2, 3 } }, {}, {}, false);
+	EXPECT_EQ(2, t.execute(2));
+	EXPECT_EQ(3, p1->getNumberOfTokens());
+	EXPECT_EQ(6, p2->getNumberOfTokens());
+
+	EXPECT_EQ(1, t.execute(numeric_limits<size_t>::max()));
+	EXPECT_EQ(1, p1->getNumberOfTokens());
+	EXPECT_EQ(9, p2->getNumberOfTokens());
+	EXPECT_EQ(3, onExitCounter);
+	EXPECT_EQ(3, onEnterCounter);
+
+	EXPECT_EQ(0, t.execute(numeric_limits<size_t>::max()));
+}
@@ -16,8 +16,12 @@
  * limitations under the License.
  */
 
+#include "PTN_Engine/ActionsInExecution.h"
+#include "PTN_Engine/Executor/ActionsExecutorFactory.h"
+#include "PTN_Engine/Place.h"
 #include "PTN_Engine/Transition.h"
 #include "PTN_Engine/TransitionsManager.h"
+#include <atomic>
 #include <gtest/gtest.h>
 
 using namespace ptne;
@@ -64,6 +68,101 @@ TEST_F(TransitionsManager_Obj, collectEnabledTransitionsRandomly)
 	EXPECT_FALSE(transitionsManager.collectEnabledTransitionsRandomly().empty());
 }
 
+TEST_F(TransitionsManager_Obj, collectEnabledTransitionsRandomly_only_reevaluates_dirty_transitions)
+{
+	shared_ptr<IActionsExecutor> executor = ActionsExecutorFactory::createExecutor();
+	auto p1 = make_shared<Place>(PlaceProperties{ .name = "P1" }, executor);
+	auto p2 = make_shared<Place>(PlaceProperties{ .name = "P2" }, executor);
+	auto t1 = make_shared<Transition>("T1", vector<Arc>{ { p1, 1 } }, vector<Arc>{}, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, false);
+	auto t2 = make_shared<Transition>("T2", vector<Arc>{ { p2, 1 } }, vector<Arc>{}, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, false);
+	transitionsManager.insert(t1);
+	transitionsManager.insert(t2);
+	EXPECT_TRUE(transitionsManager.collectEnabledTransitionsRandomly().empty());
+
+	// Token changes are only picked up once the place is flagged as dirty.
+	p1->enterPlace(1);
+	p2->enterPlace(1);
+	EXPECT_TRUE(transitionsManager.collectEnabledTransitionsRandomly().empty());
+
+	transitionsManager.markDirty(*p1);
+	auto enabledTransitions = transitionsManager.collectEnabledTransitionsRandomly();
+	ASSERT_EQ(1, enabledTransitions.size());
+	EXPECT_EQ(t1, enabledTransitions.at(0).lock());
+
+	transitionsManager.markDirty(*p2);
+	EXPECT_EQ(2, transitionsManager.collectEnabledTransitionsRandomly().size());
+
+	ASSERT_TRUE(t1->execute());
+	transitionsManager.markDirty(*t1);
+	enabledTransitions = transitionsManager.collectEnabledTransitionsRandomly();
+	ASSERT_EQ(1, enabledTransitions.size());
+	EXPECT_EQ(t2, enabledTransitions.at(0).lock());
+}
+
+TEST_F(TransitionsManager_Obj, addArc_and_removeArc_reevaluate_the_transition)
+{
+	shared_ptr<IActionsExecutor> executor = ActionsExecutorFactory::createExecutor();
+	auto p1 = make_shared<Place>(PlaceProperties{ .name = "P1" }, executor);
+	auto t1 = make_shared<Transition>("T1", vector<Arc>{}, vector<Arc>{}, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, false);
+	transitionsManager.insert(t1);
+	EXPECT_EQ(1, transitionsManager.collectEnabledTransitionsRandomly().size());
+
+	transitionsManager.addArc("T1", p1, ArcProperties::Type::INHIBITOR, 1);
+	EXPECT_EQ(1, transitionsManager.collectEnabledTransitionsRandomly().size());
+
+	p1->enterPlace(1);
+	transitionsManager.markDirty(*p1);
+	EXPECT_TRUE(transitionsManager.collectEnabledTransitionsRandomly().empty());
+
+	transitionsManager.removeArc("T1", p1, ArcProperties::Type::INHIBITOR);
+	EXPECT_EQ(1, transitionsManager.collectEnabledTransitionsRandomly().size());
+
+	// Removed arcs no longer make the transition dirty.
+	transitionsManager.addArc("T1", p1, ArcProperties::Type::ACTIVATION, 2);
+	EXPECT_TRUE(transitionsManager.collectEnabledTransitionsRandomly().empty());
+	p1->enterPlace(1);
+	transitionsManager.markDirty(*p1);
+	EXPECT_EQ(1, transitionsManager.collectEnabledTransitionsRandomly().size());
+}
+
+TEST_F(TransitionsManager_Obj, transitions_waiting_for_actions_are_reevaluated_once_the_actions_complete)
+{
+	shared_ptr<IActionsExecutor> executor =
+	ActionsExecutorFactory::createExecutor(PTN_Engine::ACTIONS_THREAD_OPTION::JOB_QUEUE);
+	atomic<bool> finishAction = false;
+	auto actionsInExecution = make_shared<ActionsInExecution>([] {});
+	auto p1 = make_shared<Place>(PlaceProperties{ .name = "P1",
+												  .onEnterActionFunctionName = "Wait",
+												  .onEnterAction = [&finishAction] { finishAction.wait(false); } },
+								 executor, actionsInExecution);
+	auto t1 = make_shared<Transition>("T1", vector<Arc>{ { p1, 1 } }, vector<Arc>{}, vector<Arc>{},
+									  vector<pair<string, ConditionFunction>>{}, true);
+	transitionsManager.insert(t1);
+
+	p1->enterPlace(1);
+	transitionsManager.markDirty(*p1);
+	EXPECT_TRUE(transitionsManager.collectEnabledTransitionsRandomly().empty());
+
+	finishAction = true;
+	finishAction.notify_all();
+	const auto deadline = chrono::steady_clock::now() + 2s;
+	vector<const Place *> completedPlaces;
+	while (completedPlaces.empty() && chrono::steady_clock::now() < deadline)
+	{
+		this_thread::sleep_for(100us);
+		completedPlaces = actionsInExecution->takeCompletedPlaces();
+	}
+	ASSERT_EQ(1, completedPlaces.size());
+	EXPECT_EQ(p1.get(), completedPlaces.at(0));
+
+	// The transition was left out of the worklist until its place reported the completion.
+	transitionsManager.markDirty(*completedPlaces.at(0));
+	EXPECT_EQ(1, transitionsManager.collectEnabledTransitionsRandomly().size());
+}
+
 TEST_F(TransitionsManager_Obj, contains_returns_if_the_container_contains_an_element_with_the_name_in_the_argument)
 {
 	EXPECT_FALSE(transitionsManager.contains("T1"));
@@ -0,0 +1,91 @@
+/*
+ * This file is part of PTN Engine
+ *
+ * Copyright (c) 2024 Eduardo Valgôde
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PTN_Engine/JobQueue/WorkStealingPool.h"
+#include "PTN_Engine/PTN_Exception.h"
+#include <gtest/gtest.h>
+#include <set>
+
+using namespace ptne;
+using namespace std;
+
+TEST(WorkStealingPool_, requires_at_least_one_thread)
+{
+	EXPECT_THROW(WorkStealingPool(0), PTN_Exception);
+	EXPECT_EQ(3, WorkStealingPool(3).getNumberOfThreads());
+}
+
+TEST(WorkStealingPool_, run_executes_each_task_once)
+{
+	WorkStealingPool pool(4);
+	for (size_t batch = 0; batch < 100; ++batch)
+	{
+		const size_t numberOfTasks = batch % 13;
+		vector<atomic<size_t>> executions(numberOfTasks);
+		pool.run(numberOfTasks, [&executions](const size_t task) { ++executions[task]; });
+		for (const auto &taskExecutions : executions)
+		{
+			ASSERT_EQ(1, taskExecutions);
+		}
+	}
+}
+
+TEST(WorkStealingPool_, run_spreads_the_tasks_over_the_threads)
+{
+	WorkStealingPool pool(2);
+	mutex threadsMutex;
+	set<thread::id> threads;
+	// Each task waits until another thread took a task, so the batch cannot finish in a single thread.
+	atomic<size_t> started = 0;
+	pool.run(2,
+			 [&](const size_t)
+			 {
+				 {
+					 lock_guard guard(threadsMutex);
+					 threads.insert(this_thread::get_id());
+				 }
+				 ++started;
+				 while (started < 2)
+				 {
+					 this_thread::yield();
+				 }
+			 });
+	EXPECT_EQ(2, threads.size());
+}
+
+TEST(WorkStealingPool_, run_rethrows_exceptions_after_all_tasks_finished)
+{
+	WorkStealingPool pool(3);
+	atomic<size_t> executions = 0;
+	EXPECT_THROW(pool.run(10,
+						  [&executions](const size_t task)
+						  {
+							  ++executions;
+							  if (task == 4)
+							  {
+								  throw PTN_Exception("task failed");
+							  }
+						  }),
+				 PTN_Exception);
+	EXPECT_EQ(10, executions);
+
+	// The pool is still usable afterwards.
+	executions = 0;
+	pool.run(5, [&executions](const size_t) { ++executions; });
+	EXPECT_EQ(5, executions);
+}